@@ -279,6 +279,16 @@ Api::IoCallUint64Result VclIoHandle::recv(void* buffer, size_t length, int flags
   return vclCallResultToIoCallResult(rv);
 }
 
+Api::IoCallUint64Result VclIoHandle::send(const Buffer::RawSlice* slices, uint64_t num_slice,
+                                          int) {
+  // VCL sessions take no send flags.
+  return writev(slices, num_slice);
+}
+
+Api::IoCallUint64Result VclIoHandle::recvZeroCopyCompletion(ZeroCopyCompletion&) {
+  return vclCallResultToIoCallResult(VPPCOM_EOPNOTSUPP);
+}
+
 Api::IoCallUint64Result VclIoHandle::sendmsg(const Buffer::RawSlice* slices, uint64_t num_slice,
                                              int, const Envoy::Network::Address::Ip*,
                                              const Envoy::Network::Address::Instance&) {
@@ -469,5 +469,26 @@ public:
   virtual void onServerInitialized() PURE;
 };
 
+/**
+ * Abstract factory for the per-thread IoUringWorkers.
+ */
+class IoUringWorkerFactory {
+public:
+  virtual ~IoUringWorkerFactory() = default;
+
+  /**
+   * Returns the IoUringWorker of the current thread, or an empty OptRef if the current thread
+   * has no worker (e.g. before the server is initialized).
+   */
+  virtual OptRef<IoUringWorker> getIoUringWorker() PURE;
+
+  /**
+   * Creates the IoUringWorker of every thread once the server is initialized.
+   */
+  virtual void onServerInitialized() PURE;
+};
+
+using IoUringWorkerFactorySharedPtr = std::shared_ptr<IoUringWorkerFactory>;
+
 } // namespace Io
 } // namespace Envoy
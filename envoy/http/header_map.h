@@ -20,6 +20,7 @@
 
 #include "absl/container/inlined_vector.h"
 #include "absl/strings/string_view.h"
+#include "absl/types/span.h"
 
 namespace Envoy {
 namespace Http {
@@ -308,6 +309,29 @@ private:
   DEFINE_INLINE_HEADER(name)                                                                       \
   virtual void set##name(uint64_t) PURE;
 
+/**
+ * A modification of a header map, applied in a batch by HeaderMap::applyMutations().
+ */
+struct HeaderMutation {
+  enum class Type {
+    // Remove all instances of the header, see HeaderMap::remove().
+    Remove,
+    // Replace all instances of the header with a single one, see HeaderMap::setCopy().
+    Set,
+    // Append the value to the first instance of the header, see HeaderMap::appendCopy().
+    Append,
+    // Add another instance of the header, see HeaderMap::addCopy().
+    Add,
+  };
+
+  Type type_;
+  const LowerCaseString& key_;
+  absl::string_view value_{};
+  // Reference the key instead of copying it when a header is added. The key must then outlive the
+  // header map, see HeaderMap::addReferenceKey().
+  bool reference_key_{false};
+};
+
 /**
  * Wraps a set of HTTP headers.
  */
@@ -540,6 +564,14 @@ public:
    */
   virtual size_t removePrefix(const LowerCaseString& prefix) PURE;
 
+  /**
+   * Apply a batch of modifications in order. The result is the same as calling the corresponding
+   * method for each modification, except that setting a header which exists exactly once replaces
+   * its value in place instead of moving the header to the end of the map.
+   * @param mutations supplies the modifications to apply.
+   */
+  virtual void applyMutations(absl::Span<const HeaderMutation> mutations) PURE;
+
   /**
    * @return the number of headers in the map.
    */
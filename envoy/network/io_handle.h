@@ -191,6 +191,36 @@ public:
    */
   virtual Api::IoCallUint64Result recv(void* buffer, size_t length, int flags) PURE;
 
+  /**
+   * Send data on a connected handle.
+   * @param slices points to the location of data to be sent.
+   * @param num_slice indicates number of slices |slices| contains.
+   * @param flags flags to pass to the underlying sendmsg function (see man 2 sendmsg).
+   * @return a Api::IoCallUint64Result with err_ = an Api::IoError instance or
+   * err_ = nullptr and rc_ = the bytes written for success.
+   */
+  virtual Api::IoCallUint64Result send(const Buffer::RawSlice* slices, uint64_t num_slice,
+                                       int flags) PURE;
+
+  /**
+   * The sends made with MSG_ZEROCOPY whose data the kernel no longer references.
+   */
+  struct ZeroCopyCompletion {
+    // The range [first_id_, last_id_] of completed sends, counted from 0 in send order.
+    uint32_t first_id_{0};
+    uint32_t last_id_{0};
+    // True if the kernel copied the data of the sends after all.
+    bool copied_{false};
+  };
+
+  /**
+   * Read the next MSG_ZEROCOPY completion notification from the error queue of the handle.
+   * @param completion is set to the completed sends on success.
+   * @return a Api::IoCallUint64Result with err_ = nullptr for success, or err_ = an Api::IoError
+   * instance if no notification is queued or the handle does not support zero copy sends.
+   */
+  virtual Api::IoCallUint64Result recvZeroCopyCompletion(ZeroCopyCompletion& completion) PURE;
+
   /**
    * return true if the platform supports recvmmsg() and sendmmsg().
    */
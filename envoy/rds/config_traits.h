@@ -64,6 +64,24 @@ public:
   virtual ConfigConstSharedPtr createConfig(const Protobuf::Message& rc,
                                             Server::Configuration::ServerFactoryContext& context,
                                             bool validate_clusters_default) const PURE;
+
+  /**
+   * Create a config object based on a new version of a route configuration. Implementations may
+   * reuse the parts of the previous config object whose configuration did not change, by default
+   * the config object is created from scratch.
+   * @param rc supplies the RouteConfiguration.
+   * @param context supplies the context of the server factory.
+   * @param validate_clusters_default see createConfig().
+   * @param previous_config supplies the config object of the previous version of the route
+   *    configuration, or the null config.
+   * @throw EnvoyException if the new config can't be applied of.
+   */
+  virtual ConfigConstSharedPtr
+  createConfigFromPrevious(const Protobuf::Message& rc,
+                           Server::Configuration::ServerFactoryContext& context,
+                           bool validate_clusters_default, const ConfigConstSharedPtr&) const {
+    return createConfig(rc, context, validate_clusters_default);
+  }
 };
 
 } // namespace Rds
@@ -110,6 +110,14 @@ public:
    * and LocalOrigin type returns success rate for local origin errors.
    */
   virtual double successRate(SuccessRateMonitorType type) const PURE;
+
+  /**
+   * @return true if a worker has seen the host reach a consecutive error threshold and the
+   *         ejection has not been processed on the main thread yet. Load balancers may avoid
+   *         the host in the meantime. Only set if outlier_detection.worker_fast_ejection is
+   *         enabled. Safe to call from any thread.
+   */
+  virtual bool ejectionPending() const PURE;
 };
 
 using DetectorHostMonitorPtr = std::unique_ptr<DetectorHostMonitor>;
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <algorithm>
+#include <array>
 #include <chrono>
 #include <cstdint>
 #include <functional>
@@ -377,13 +378,143 @@ public:
 
   using Base = absl::flat_hash_map<K, std::vector<std::pair<V, uint16_t>>>;
 };
+
+// A RefCountHashMap split into a fixed number of chunks that are shared between copies
+// (copy-on-write). Copying the map only copies the chunk pointers, and a later insert()
+// or erase() clones just the chunk that holds the key. The main thread copies the
+// cross-priority host map on every host update, so an update of k hosts costs
+// O(k * n / NumChunks) instead of O(n). The unchanged chunks stay shared with the
+// read-only map that the workers use.
+// Copies may only be made on one thread (the main thread). A chunk is cloned if any
+// other map still references it; a stale use_count() can only lead to an extra clone.
+template <typename K, typename V> class ChunkedRefCountHashMap {
+public:
+  static constexpr size_t NumChunks = 64;
+  using Chunk = RefCountHashMap<K, V>;
+  using value_type = typename Chunk::value_type;
+
+  class const_iterator {
+  public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = typename Chunk::value_type;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const value_type*;
+    using reference = const value_type&;
+
+    const_iterator() = default;
+    const_iterator(const ChunkedRefCountHashMap* map, size_t chunk,
+                   typename Chunk::const_iterator it)
+        : map_(map), chunk_(chunk), it_(it) {
+      skipEmptyChunks();
+    }
+
+    reference operator*() const { return *it_; }
+    pointer operator->() const { return &*it_; }
+
+    const_iterator& operator++() {
+      ++it_;
+      skipEmptyChunks();
+      return *this;
+    }
+    const_iterator operator++(int) {
+      const_iterator prev = *this;
+      ++*this;
+      return prev;
+    }
+
+    bool operator==(const const_iterator& other) const {
+      return chunk_ == other.chunk_ && (chunk_ == NumChunks || it_ == other.it_);
+    }
+    bool operator!=(const const_iterator& other) const { return !(*this == other); }
+
+  private:
+    // Move on to the first element of the next non-empty chunk when the end of
+    // the current chunk is reached
+    void skipEmptyChunks() {
+      while (chunk_ < NumChunks && it_ == map_->chunks_[chunk_]->end()) {
+        if (++chunk_ < NumChunks) {
+          it_ = map_->chunks_[chunk_]->begin();
+        }
+      }
+    }
+
+    const ChunkedRefCountHashMap* map_ = nullptr;
+    size_t chunk_ = NumChunks;
+    typename Chunk::const_iterator it_;
+  };
+  using iterator = const_iterator;
+
+  // All chunks of an empty map point to one shared empty chunk, the first write clones it
+  ChunkedRefCountHashMap() {
+    static const auto* empty_chunk = new std::shared_ptr<Chunk>(std::make_shared<Chunk>());
+    chunks_.fill(*empty_chunk);
+  }
+
+  const_iterator find(const K& key) const {
+    const size_t idx = chunkIndex(key);
+    auto it = chunks_[idx]->find(key);
+    if (it == chunks_[idx]->end()) {
+      return end();
+    }
+    return {this, idx, it};
+  }
+  const_iterator begin() const { return {this, 0, chunks_[0]->begin()}; }
+  const_iterator end() const { return {}; }
+
+  size_t size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+
+  void insert(const K& key, const V& value) {
+    Chunk& chunk = mutableChunk(key);
+    const size_t chunk_size = chunk.size();
+    chunk.insert(key, value);
+    size_ += chunk.size() - chunk_size;
+  }
+
+  void erase(const K& key, const V& value) {
+    if (!contains(key)) {
+      return;
+    }
+    Chunk& chunk = mutableChunk(key);
+    const size_t chunk_size = chunk.size();
+    chunk.erase(key, value);
+    size_ -= chunk_size - chunk.size();
+  }
+
+  void erase(const K& key) {
+    if (!contains(key)) {
+      return;
+    }
+    Chunk& chunk = mutableChunk(key);
+    const size_t chunk_size = chunk.size();
+    chunk.erase(key);
+    size_ -= chunk_size - chunk.size();
+  }
+
+  bool contains(const K& key) const { return chunks_[chunkIndex(key)]->contains(key); }
+
+private:
+  static size_t chunkIndex(const K& key) { return absl::Hash<K>{}(key) % NumChunks; }
+
+  // Return the chunk for the key, cloned first if it is shared with another map
+  Chunk& mutableChunk(const K& key) {
+    auto& chunk = chunks_[chunkIndex(key)];
+    if (chunk.use_count() > 1) {
+      chunk = std::make_shared<Chunk>(*chunk);
+    }
+    return *chunk;
+  }
+
+  std::array<std::shared_ptr<Chunk>, NumChunks> chunks_;
+  size_t size_ = 0;
+};
 using HostConstSharedPtr = std::shared_ptr<const Host>;
 
 using HostVector = std::vector<HostSharedPtr>;
 using HealthyHostVector = Phantom<HostVector, Healthy>;
 using DegradedHostVector = Phantom<HostVector, Degraded>;
 using ExcludedHostVector = Phantom<HostVector, Excluded>; 
-using HostMap = Envoy::Upstream::RefCountHashMap<std::string,Upstream::HostSharedPtr>;
+using HostMap = Envoy::Upstream::ChunkedRefCountHashMap<std::string, Upstream::HostSharedPtr>;
 using HostMapSharedPtr = std::shared_ptr<HostMap>;
 using HostMapConstSharedPtr = std::shared_ptr<const HostMap>;
 using HostVectorSharedPtr = std::shared_ptr<HostVector>;
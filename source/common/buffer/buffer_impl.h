@@ -5,6 +5,7 @@
 #include <deque>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "envoy/buffer/buffer.h"
 #include "envoy/http/stream_reset_handler.h"
@@ -19,6 +20,68 @@
 namespace Envoy {
 namespace Buffer {
 
+/**
+ * Thread local cache of slice storage of the default slice size (16 KiB), which is the size of
+ * most slices created by reads and by reservations. Storage of a destroyed slice is put into the
+ * pool of the destroying thread and handed out again by the next allocation on that thread. When
+ * the pool grows above the high watermark it is trimmed down to the low watermark, so an idle
+ * worker holds at most HighWatermark * 16 KiB. Memory in the pool is not charged to any
+ * BufferMemoryAccount, slices charge their capacity while they exist.
+ */
+class SliceStoragePool {
+public:
+  using StoragePtr = std::unique_ptr<uint8_t[]>;
+
+  static constexpr uint64_t StorageSize = 16384;
+  static constexpr uint32_t HighWatermark = 64;
+  static constexpr uint32_t LowWatermark = 16;
+
+  /**
+   * @return storage of StorageSize bytes, from the pool if possible.
+   */
+  StoragePtr get() {
+    if (free_.empty()) {
+      return StoragePtr{new uint8_t[StorageSize]};
+    }
+    StoragePtr storage = std::move(free_.back());
+    free_.pop_back();
+    return storage;
+  }
+
+  /**
+   * Return storage of StorageSize bytes to the pool.
+   */
+  void put(StoragePtr&& storage) {
+    free_.push_back(std::move(storage));
+    if (free_.size() > HighWatermark) {
+      free_.resize(LowWatermark);
+    }
+  }
+
+  /**
+   * @return the number of storages in the pool.
+   */
+  size_t size() const { return free_.size(); }
+
+  /**
+   * @return the pool of the calling thread, or nullptr if it has been destroyed (slices destroyed
+   * during static destruction after the thread local objects).
+   */
+  static SliceStoragePool* threadLocal() { return destroyed_ ? nullptr : &pool_; }
+
+  ~SliceStoragePool() {
+    if (this == &pool_) {
+      destroyed_ = true;
+    }
+  }
+
+private:
+  std::vector<StoragePtr> free_;
+
+  static thread_local SliceStoragePool pool_;
+  static thread_local bool destroyed_;
+};
+
 /**
  * A Slice manages a contiguous block of bytes.
  * The block is arranged like this:
@@ -57,7 +120,7 @@ public:
    * @param account the account to charge.
    */
   Slice(uint64_t min_capacity, const BufferMemoryAccountSharedPtr& account)
-      : capacity_(sliceSize(min_capacity)), storage_(new uint8_t[capacity_]),
+      : capacity_(sliceSize(min_capacity)), storage_(allocateStorage(capacity_)),
         base_(storage_.get()) {
     if (account) {
       account->charge(capacity_);
@@ -114,6 +177,7 @@ public:
   Slice& operator=(Slice&& rhs) noexcept {
     if (this != &rhs) {
       callAndClearDrainTrackersAndCharges();
+      freeStorage(std::move(storage_), capacity_);
 
       capacity_ = rhs.capacity_;
       storage_ = std::move(rhs.storage_);
@@ -139,6 +203,7 @@ public:
 
   ~Slice() {
     callAndClearDrainTrackersAndCharges();
+    freeStorage(std::move(storage_), capacity_);
     if (releasor_) {
       releasor_();
     }
@@ -363,6 +428,8 @@ public:
   }
 
   static constexpr uint32_t default_slice_size_ = 16384;
+  static_assert(default_slice_size_ == SliceStoragePool::StorageSize,
+                "the slice storage pool holds storage of the default slice size");
 
 public:
   /**
@@ -385,7 +452,36 @@ public:
    */
   static inline SizedStorage newStorage(uint64_t min_capacity) {
     const uint64_t slice_size = sliceSize(min_capacity);
-    return {StoragePtr{new uint8_t[slice_size]}, static_cast<size_t>(slice_size)};
+    return {allocateStorage(slice_size), static_cast<size_t>(slice_size)};
+  }
+
+  /**
+   * Allocate backend storage of the given size, which must be a multiple of the page size.
+   * Storage of the default slice size comes from the thread local SliceStoragePool.
+   */
+  static inline StoragePtr allocateStorage(uint64_t size) {
+    if (size == default_slice_size_) {
+      SliceStoragePool* pool = SliceStoragePool::threadLocal();
+      if (pool != nullptr) {
+        return pool->get();
+      }
+    }
+    return StoragePtr{new uint8_t[size]};
+  }
+
+  /**
+   * Release backend storage of the given size, storage of the default slice size is returned to
+   * the thread local SliceStoragePool.
+   */
+  static inline void freeStorage(StoragePtr&& storage, uint64_t size) {
+    if (storage != nullptr && size == default_slice_size_) {
+      SliceStoragePool* pool = SliceStoragePool::threadLocal();
+      if (pool != nullptr) {
+        pool->put(std::move(storage));
+        return;
+      }
+    }
+    storage.reset();
   }
 
 protected:
@@ -783,15 +879,13 @@ private:
 
   struct OwnedImplReservationSlicesOwnerMultiple : public OwnedImplReservationSlicesOwner {
   public:
-    static constexpr uint32_t free_list_max_ = Buffer::Reservation::MAX_SLICES_;
-
-    OwnedImplReservationSlicesOwnerMultiple() : free_list_ref_(free_list_) {}
+    OwnedImplReservationSlicesOwnerMultiple() : pool_(SliceStoragePool::threadLocal()) {}
     ~OwnedImplReservationSlicesOwnerMultiple() override {
       for (auto r = owned_storages_.rbegin(); r != owned_storages_.rend(); r++) {
         if (r->mem_ != nullptr) {
           ASSERT(r->len_ == Slice::default_slice_size_);
-          if (free_list_ref_.size() < free_list_max_) {
-            free_list_ref_.push_back(std::move(r->mem_));
+          if (pool_ != nullptr) {
+            pool_->put(std::move(r->mem_));
           }
         }
       }
@@ -801,9 +895,8 @@ private:
       ASSERT(Slice::sliceSize(Slice::default_slice_size_) == Slice::default_slice_size_);
 
       Slice::SizedStorage storage{nullptr, Slice::default_slice_size_};
-      if (!free_list_ref_.empty()) {
-        storage.mem_ = std::move(free_list_ref_.back());
-        free_list_ref_.pop_back();
+      if (pool_ != nullptr) {
+        storage.mem_ = pool_->get();
       } else {
         storage.mem_.reset(new uint8_t[Slice::default_slice_size_]);
       }
@@ -818,14 +911,9 @@ private:
     absl::InlinedVector<Slice::SizedStorage, Buffer::Reservation::MAX_SLICES_> owned_storages_;
 
   private:
-    // Thread local resolving introduces additional overhead. Initialize this reference once when
-    // constructing the owner to reduce thread local resolving to improve performance.
-    absl::InlinedVector<Slice::StoragePtr, free_list_max_>& free_list_ref_;
-
-    // Simple thread local cache to reduce unnecessary memory allocation and release. This cache
-    // is currently only used for multiple slices reservation because of the additional overhead
-    // that thread local resolving would introduce.
-    static thread_local absl::InlinedVector<Slice::StoragePtr, free_list_max_> free_list_;
+    // Thread local resolving introduces additional overhead. Resolve the pool once when
+    // constructing the owner.
+    SliceStoragePool* const pool_;
   };
 
   struct OwnedImplReservationSlicesOwnerSingle : public OwnedImplReservationSlicesOwner {
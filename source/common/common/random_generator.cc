@@ -1,5 +1,8 @@
 #include "source/common/common/random_generator.h"
 
+#include <array>
+#include <cstring>
+
 #include "source/common/common/assert.h"
 
 #include "openssl/rand.h"
@@ -9,6 +12,26 @@ namespace Random {
 
 const size_t RandomGeneratorImpl::UUID_LENGTH = 36;
 
+namespace {
+
+// The two lower case hex digits of every byte value.
+constexpr std::array<std::array<char, 2>, 256> makeHexPairs() {
+  constexpr char hex[] = "0123456789abcdef";
+  std::array<std::array<char, 2>, 256> pairs{};
+  for (size_t i = 0; i < pairs.size(); i++) {
+    pairs[i][0] = hex[i >> 4];
+    pairs[i][1] = hex[i & 0x0f];
+  }
+  return pairs;
+}
+
+constexpr std::array<std::array<char, 2>, 256> HexPairs = makeHexPairs();
+
+// Position of the hex digits of each of the 16 UUID bytes in the string representation.
+constexpr uint8_t UuidHexOffsets[16] = {0, 2, 4, 6, 9, 11, 14, 16, 19, 21, 24, 26, 28, 30, 32, 34};
+
+} // namespace
+
 uint64_t RandomGeneratorImpl::random() {
   // Prefetch 256 * sizeof(uint64_t) bytes of randomness. buffered_idx is initialized to 256,
   // i.e. out-of-range value, so the buffer will be filled with randomness on the first call
@@ -87,48 +110,13 @@ std::string RandomGeneratorImpl::uuid() {
   rand[8] = (rand[8] & 0x3f) | 0x80; // UUID variant 1 (RFC4122)
 
   // Convert UUID to a string representation, e.g. a121e9e1-feae-4136-9e0e-6fac343d56c9.
-  static const char* const hex = "0123456789abcdef";
-  char uuid[UUID_LENGTH];
-
-  for (uint8_t i = 0; i < 4; i++) {
-    const uint8_t d = rand[i];
-    uuid[2 * i] = hex[d >> 4];
-    uuid[2 * i + 1] = hex[d & 0x0f];
-  }
-
-  uuid[8] = '-';
-
-  for (uint8_t i = 4; i < 6; i++) {
-    const uint8_t d = rand[i];
-    uuid[2 * i + 1] = hex[d >> 4];
-    uuid[2 * i + 2] = hex[d & 0x0f];
-  }
-
-  uuid[13] = '-';
-
-  for (uint8_t i = 6; i < 8; i++) {
-    const uint8_t d = rand[i];
-    uuid[2 * i + 2] = hex[d >> 4];
-    uuid[2 * i + 3] = hex[d & 0x0f];
-  }
-
-  uuid[18] = '-';
-
-  for (uint8_t i = 8; i < 10; i++) {
-    const uint8_t d = rand[i];
-    uuid[2 * i + 3] = hex[d >> 4];
-    uuid[2 * i + 4] = hex[d & 0x0f];
-  }
-
-  uuid[23] = '-';
-
-  for (uint8_t i = 10; i < 16; i++) {
-    const uint8_t d = rand[i];
-    uuid[2 * i + 4] = hex[d >> 4];
-    uuid[2 * i + 5] = hex[d & 0x0f];
+  // The dashes are in place already, every byte is written as one pair of hex digits.
+  std::string uuid(UUID_LENGTH, '-');
+  for (uint8_t i = 0; i < 16; i++) {
+    memcpy(&uuid[UuidHexOffsets[i]], HexPairs[rand[i]].data(), 2);
   }
 
-  return {uuid, UUID_LENGTH};
+  return uuid;
 }
 
 } // namespace Random
@@ -6,109 +6,91 @@ namespace EricEvent {
 // Set the static application ID once
 std::string EventT::appl_id_ = std::getenv("APPLICATION_ID") ? std::getenv("APPLICATION_ID") : "";
 
-// Map from event-tag to the value as a std::string
-std::map<std::string, EventT::MemberGetter> EventT::member_map_ = {
-    {"TYPE",
-     [](const EventT& evnt) -> const std::string& {
-       return type_str_.at(static_cast<int>(evnt.type_));
-     }},
-    {"CATEGORY",
-     [](const EventT& evnt) -> const std::string& {
-       return category_str_.at(static_cast<int>(evnt.category_));
-     }},
-    {"SEVERITY",
-     [](const EventT& evnt) -> const std::string& {
-       return severity_str_.at(static_cast<int>(evnt.severity_));
-     }},
-    {"MSG", [](const EventT& evnt) -> const std::string& { return evnt.message_; }},
-    {"ULID", [](const EventT& evnt) -> const std::string& { return evnt.ulid_; }},
-    {"RESP_MSG", [](const EventT& evnt) -> const std::string& { return evnt.resp_message_; }},
+// Map from event-tag to the field
+const std::map<std::string, EventT::Field> EventT::field_names_ = {
+    {"TYPE", Field::TYPE},
+    {"CATEGORY", Field::CATEGORY},
+    {"SEVERITY", Field::SEVERITY},
+    {"MSG", Field::MSG},
+    {"ULID", Field::ULID},
+    {"RESP_MSG", Field::RESP_MSG},
     // RESP_CODE must be a string according to ADP log format specifications
-    {"RESP_CODE", [](const EventT& evnt) -> const std::string& { return evnt.resp_code_; }},
-    {"ACTION",
-     [](const EventT& evnt) -> const std::string& {
-       return action_str_.at(static_cast<int>(evnt.action_));
-     }},
-    {"RP", [](const EventT& evnt) -> const std::string& { return evnt.roaming_partner_; }},
-    {"SRC", [](const EventT& evnt) -> const std::string& { return evnt.source_; }},
-    {"SRC_TYPE", [](const EventT& evnt) -> const std::string& { return evnt.source_type_; }},
+    {"RESP_CODE", Field::RESP_CODE},
+    {"ACTION", Field::ACTION},
+    {"RP", Field::RP},
+    {"SRC", Field::SRC},
+    {"SRC_TYPE", Field::SRC_TYPE},
     // the following two are constants and can also be replaced right away in the format string
-    {"VERSION", [](const EventT& evnt) -> const std::string& { return evnt.version_str_; }},
-    {"LOG_VERSION",
-     [](const EventT& evnt) -> const std::string& { return evnt.log_version_str_; }},
-    {"APPL_ID", [](const EventT&) -> const std::string& {return EventT::appl_id_; }}
+    {"VERSION", Field::VERSION},
+    {"LOG_VERSION", Field::LOG_VERSION},
+    {"APPL_ID", Field::APPL_ID},
+    {"SUB_SPEC", Field::SUB_SPEC}
 };
 
-// Map from event-tag to the value as protobuf-value
-std::map<std::string, EventT::MemberValueGetter> EventT::member_value_map_ = {
-    {"TYPE",
-     [](const EventT& evnt, absl::optional<size_t> max_len) -> const ProtobufWkt::Value {
-       return limitAndWrapString(type_str_.at(static_cast<int>(evnt.type_)), max_len);
-     }},
-    {"CATEGORY",
-     [](const EventT& evnt, absl::optional<size_t> max_len) -> const ProtobufWkt::Value {
-       return limitAndWrapString(category_str_.at(static_cast<int>(evnt.category_)), max_len);
-     }},
-    {"SEVERITY",
-     [](const EventT& evnt, absl::optional<size_t> max_len) -> const ProtobufWkt::Value {
-       return limitAndWrapString(severity_str_.at(static_cast<int>(evnt.severity_)), max_len);
-     }},
-    {"MSG",
-     [](const EventT& evnt, absl::optional<size_t> max_len) -> const ProtobufWkt::Value {
-       return limitAndWrapString(evnt.message_, max_len);
-     }},
-    {"ULID",
-     [](const EventT& evnt, absl::optional<size_t> max_len) -> const ProtobufWkt::Value {
-       return limitAndWrapString(evnt.ulid_, max_len);
-     }},
-    {"RESP_MSG",
-     [](const EventT& evnt, absl::optional<size_t> max_len) -> const ProtobufWkt::Value {
-       return limitAndWrapString(evnt.resp_message_, max_len);
-     }},
-    {"RESP_CODE",  // Must be a string according to ADP log format
-     [](const EventT& evnt, absl::optional<size_t> max_len) -> const ProtobufWkt::Value {
-       return limitAndWrapString(evnt.resp_code_, max_len);
-     }},
-    {"ACTION",
-     [](const EventT& evnt, absl::optional<size_t> max_len) -> const ProtobufWkt::Value {
-       return limitAndWrapString(action_str_.at(static_cast<int>(evnt.action_)), max_len);
-     }},
-    {"RP",
-     [](const EventT& evnt, absl::optional<size_t> max_len) -> const ProtobufWkt::Value {
-       return limitAndWrapString(evnt.roaming_partner_, max_len);
-     }},
-    {"SRC",
-     [](const EventT& evnt, absl::optional<size_t> max_len) -> const ProtobufWkt::Value {
-       return limitAndWrapString(evnt.source_, max_len);
-     }},
-    {"SRC_TYPE",
-     [](const EventT& evnt, absl::optional<size_t> max_len) -> const ProtobufWkt::Value {
-       return limitAndWrapString(evnt.source_type_, max_len);
-     }},
-    // the following two are constants and can also be replaced right away in the format string
-    {"VERSION",
-     [](const EventT& evnt, absl::optional<size_t> max_len) -> const ProtobufWkt::Value {
-       return limitAndWrapString(evnt.version_str_, max_len);
-     }},
-    {"LOG_VERSION",
-     [](const EventT& evnt, absl::optional<size_t> max_len) -> const ProtobufWkt::Value {
-       return limitAndWrapString(evnt.log_version_str_, max_len);
-     }},
-    {"APPL_ID",
-     [](const EventT&, absl::optional<size_t> max_len) -> const ProtobufWkt::Value {
-        return limitAndWrapString(EventT::appl_id_, max_len);
-     }},
-    {"SUB_SPEC",
-     [](const EventT& evnt, absl::optional<size_t>) -> const ProtobufWkt::Value {
-       if (!evnt.subSpec().empty()) {
-         ProtobufWkt::Struct proto_val;
-         MessageUtil::loadFromJson(evnt.sub_spec_, proto_val);
-         return ValueUtil::structValue(proto_val);
-       } else {
-         return ValueUtil::nullValue();
-       }
-     }}
-};
+EventT::Field EventT::fieldFromName(const std::string& key) {
+  auto it = field_names_.find(key);
+  if (it == field_names_.end()) {
+    return Field::UNKNOWN;
+  }
+  return it->second;
+}
+
+// The value of a field as a std::string. SUB_SPEC is JSON and only available
+// as protobuf-value.
+const std::string& EventT::getEventField(Field field) const {
+  switch (field) {
+  case Field::TYPE:
+    return type_str_.at(static_cast<int>(type_));
+  case Field::CATEGORY:
+    return category_str_.at(static_cast<int>(category_));
+  case Field::SEVERITY:
+    return severity_str_.at(static_cast<int>(severity_));
+  case Field::MSG:
+    return message_;
+  case Field::ULID:
+    return ulid_;
+  case Field::RESP_MSG:
+    return resp_message_;
+  case Field::RESP_CODE:
+    return resp_code_;
+  case Field::ACTION:
+    return action_str_.at(static_cast<int>(action_));
+  case Field::RP:
+    return roaming_partner_;
+  case Field::SRC:
+    return source_;
+  case Field::SRC_TYPE:
+    return source_type_;
+  case Field::VERSION:
+    return version_str_;
+  case Field::LOG_VERSION:
+    return log_version_str_;
+  case Field::APPL_ID:
+    return appl_id_;
+  case Field::SUB_SPEC:
+  case Field::UNKNOWN:
+    break;
+  }
+  return EMPTY_STR;
+}
+
+// The value of a field as protobuf-value
+const ProtobufWkt::Value EventT::getEventFieldValue(Field field,
+                                                   absl::optional<size_t> max_len) const {
+  switch (field) {
+  case Field::SUB_SPEC:
+    if (!sub_spec_.empty()) {
+      ProtobufWkt::Struct proto_val;
+      MessageUtil::loadFromJson(sub_spec_, proto_val);
+      return ValueUtil::structValue(proto_val);
+    }
+    return ValueUtil::nullValue();
+  case Field::UNKNOWN:
+    return ValueUtil::nullValue();
+  default:
+    return limitAndWrapString(getEventField(field), max_len);
+  }
+}
 
 ProtobufWkt::Value EventT::limitAndWrapString(const std::string& str,
                                               absl::optional<size_t> max_length) {
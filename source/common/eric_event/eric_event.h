@@ -2,7 +2,6 @@
 
 #include <array>
 #include <cstdint>
-#include <functional>
 #include <string>
 #include <map>
 #include "absl/types/optional.h"
@@ -60,27 +59,53 @@ public:
           }
         };
 
+  // The fields that can be referenced as %EVENT(<field>)% in an access log format.
+  // The tag is resolved to a Field once when the format is parsed so that logging
+  // an event does not need a lookup by name.
+  enum class Field : int {
+    TYPE,
+    CATEGORY,
+    SEVERITY,
+    MSG,
+    ULID,
+    RESP_MSG,
+    RESP_CODE,
+    ACTION,
+    RP,
+    SRC,
+    SRC_TYPE,
+    VERSION,
+    LOG_VERSION,
+    APPL_ID,
+    SUB_SPEC,
+    UNKNOWN
+  };
+
+  // Return the field for a tag, or Field::UNKNOWN if there is no such field
+  static Field fieldFromName(const std::string& key);
+
   // Getter for string-based fields, returns strings
+  const std::string& getEventField(Field field) const;
   const std::string& getEventField(const std::string& key) const {
-    auto it = member_map_.find(key);
-    if (it == member_map_.end()) {
-      return EMPTY_STR;
-    }
-    return it->second(*this);
+    return getEventField(fieldFromName(key));
   }
 
   // Getter for all fields, returns protobuf type
-  const ProtobufWkt::Value getEventFieldValue(const std::string& key, absl::optional<size_t> max_len) const {
-    auto it = member_value_map_.find(key);
-    if (it == member_value_map_.end()) {
-      return ValueUtil::nullValue();
-    }
-    return it->second(*this, max_len);
+  const ProtobufWkt::Value getEventFieldValue(Field field, absl::optional<size_t> max_len) const;
+  const ProtobufWkt::Value getEventFieldValue(const std::string& key,
+                                              absl::optional<size_t> max_len) const {
+    return getEventFieldValue(fieldFromName(key), max_len);
   }
 
+  EventType eventType() const { return type_; }
+
   // Various getter-functions
 
-  const std::string& type() const { return type_str_.at(static_cast<int>(type_)); }
+  const std::string& type() const { return typeStr(type_); }
+
+  static const std::string& typeStr(EventType type) {
+    return type_str_.at(static_cast<int>(type));
+  }
 
   const std::string& category() const { return category_str_.at(static_cast<int>(category_)); }
 
@@ -112,10 +137,8 @@ public:
   static std::string appl_id_;
 
  private:
-   using MemberGetter = std::function<const std::string&(const EventT&)>;
-   static std::map<std::string, MemberGetter> member_map_;
-   using MemberValueGetter = std::function<const ProtobufWkt::Value(const EventT&, absl::optional<size_t>)>;
-   static std::map<std::string, MemberValueGetter> member_value_map_;
+   // Map from event-tag to the field, only used when the log format is parsed
+   static const std::map<std::string, Field> field_names_;
 
    // The name before the colon (the first word in each comment) refers
    // to the name in Sven's Excel sheet
@@ -1,12 +1,68 @@
 #include "source/common/eric_event/eric_event_reporter.h"
 #include "source/common/common/logger.h"
 
+#include <cstdlib>
+
+#include "absl/strings/numbers.h"
+
 namespace Envoy {
 namespace Extensions {
 namespace HttpFilters {
 namespace EricProxy {
 
-// empty for the time being
+EventRateLimiter::EventRateLimiter(uint32_t max_events_per_second)
+    : max_events_per_second_(max_events_per_second) {}
+
+bool EventRateLimiter::allowEvent(EricEvent::EventType type, MonotonicTime now) {
+  if (max_events_per_second_ == 0) {
+    return true;
+  }
+  auto& window = windows_.at(static_cast<int>(type));
+  const uint32_t second = static_cast<uint32_t>(
+      std::chrono::duration_cast<std::chrono::seconds>(now.time_since_epoch()).count());
+  uint64_t state = window.state.load(std::memory_order_relaxed);
+  while (true) {
+    const bool new_window = static_cast<uint32_t>(state >> 32) != second;
+    const uint32_t count = new_window ? 0 : static_cast<uint32_t>(state);
+    if (count >= max_events_per_second_) {
+      window.suppressed.fetch_add(1, std::memory_order_relaxed);
+      return false;
+    }
+    // Starts the new window and counts this event in it, or counts the event in the
+    // current window. On failure "state" holds what another worker stored, retry with it.
+    if (window.state.compare_exchange_weak(state, (uint64_t(second) << 32) | (count + 1),
+                                           std::memory_order_relaxed)) {
+      if (new_window) {
+        const uint64_t suppressed = window.suppressed.exchange(0, std::memory_order_relaxed);
+        if (suppressed > 0) {
+          ENVOY_LOG(warn,
+                    "{} events of type {} were not reported because more than {} per second "
+                    "occurred",
+                    suppressed, EricEvent::EventT::typeStr(type), max_events_per_second_);
+        }
+      }
+      return true;
+    }
+  }
+}
+
+uint32_t EventRateLimiter::maxRateFromEnvValue(const char* value) {
+  uint32_t max_rate = 0;
+  if (value == nullptr) {
+    return 0;
+  }
+  if (!absl::SimpleAtoi(value, &max_rate)) {
+    ENVOY_LOG(warn, "Invalid ERIC_EVENT_MAX_RATE_PER_TYPE '{}', events are not rate-limited",
+              value);
+    return 0;
+  }
+  return max_rate;
+}
+
+EventRateLimiter& EventRateLimiter::instance() {
+  MUTABLE_CONSTRUCT_ON_FIRST_USE(EventRateLimiter,
+                                 maxRateFromEnvValue(std::getenv("ERIC_EVENT_MAX_RATE_PER_TYPE")));
+}
 
 } // EricProxy
 } // HttpFilters
@@ -1,9 +1,12 @@
 #pragma once
+#include <array>
+#include <atomic>
 #include <string>
 #include "envoy/access_log/access_log.h"
+#include "envoy/common/time.h"
 #include "source/common/common/logger.h"
+#include "source/common/common/macros.h"
 #include "source/common/eric_event/eric_event.h"
-#include "source/common/eric_event/eric_event_reporter.h"
 #include "source/common/stream_info/eric_event_state.h"
 
 
@@ -13,11 +16,55 @@ namespace Extensions {
 namespace HttpFilters {
 namespace EricProxy {
 
+// Limits the number of events reported per event-type and second (over all workers),
+// so that a flood of security events during an attack cannot make every request pay
+// for event logging. Events above the limit are dropped and counted, the count is
+// logged when the next second starts. 0 means unlimited.
+// The second a window belongs to and the number of events in it are kept in one
+// atomic word, so that starting a new window and counting the first event in it
+// is a single compare-and-swap: no worker can count into a window that another
+// worker is resetting.
+class EventRateLimiter : public Logger::Loggable<Logger::Id::eric_proxy> {
+public:
+  explicit EventRateLimiter(uint32_t max_events_per_second);
+
+  // Return true if an event of the given type can be reported at time "now"
+  bool allowEvent(EricEvent::EventType type, MonotonicTime now);
+
+  // Number of events of the given type dropped in the current second
+  uint64_t suppressedEvents(EricEvent::EventType type) const {
+    return windows_.at(static_cast<int>(type)).suppressed.load(std::memory_order_relaxed);
+  }
+
+  // The limiter used by the EventReporter. The limit is read once from the
+  // environment variable ERIC_EVENT_MAX_RATE_PER_TYPE (unset = unlimited).
+  static EventRateLimiter& instance();
+
+  // The limit for a value of ERIC_EVENT_MAX_RATE_PER_TYPE. Unset, invalid and
+  // 0 all mean unlimited (0).
+  static uint32_t maxRateFromEnvValue(const char* value);
+
+private:
+  struct Window {
+    // Upper 32 bits: the second (truncated), lower 32 bits: events in that second.
+    // The initial value matches no second a monotonic clock starts with.
+    std::atomic<uint64_t> state{~uint64_t(0)};
+    std::atomic<uint64_t> suppressed{0};
+  };
+
+  const uint32_t max_events_per_second_;
+  std::array<Window, static_cast<int>(EricEvent::EventType::LAST_ELEMENT)> windows_;
+};
+
 class EventReporter : public Logger::Loggable<Logger::Id::eric_proxy> {
 public:
   // Report a new event via the FilterStateObject "envoy.eric_proxy.event_state"
   static void reportEventViaFilterState(StreamInfo::StreamInfo& stream_info,
                                         EricEvent::EventT&& event) {
+    if (!EventRateLimiter::instance().allowEvent(event.eventType(),
+                                                 stream_info.timeSource().monotonicTime())) {
+      return;
+    }
     // Find the filter-state object (FSO)
     const auto& filter_state = stream_info.filterState();
     auto event_fso = filter_state->getDataMutable<StreamInfo::EricEventState>(
@@ -34,11 +81,19 @@ public:
                         StreamInfo::FilterState::LifeSpan::Request);
       // ... and set the metadata flag to indicate to the access-log filter
       //     that this request needs to be logged
-      ProtobufWkt::Struct metadata;
-      *(*metadata.mutable_fields())["is_event"].mutable_string_value() = "true";
-      stream_info.setDynamicMetadata("eric_event", metadata);
+      stream_info.setDynamicMetadata("eric_event", isEventMetadata());
     }
   };
+
+private:
+  // The metadata flag is the same for every request, build it only once
+  static const ProtobufWkt::Struct& isEventMetadata() {
+    CONSTRUCT_ON_FIRST_USE(ProtobufWkt::Struct, []() {
+      ProtobufWkt::Struct metadata;
+      *(*metadata.mutable_fields())["is_event"].mutable_string_value() = "true";
+      return metadata;
+    }());
+  }
 };
 
 
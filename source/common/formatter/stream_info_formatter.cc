@@ -317,7 +317,8 @@ FilterStateFormatter::formatValue(const StreamInfo::StreamInfo& stream_info) con
 // An eric event formatter that extracts event related fields from EricEventState stored in the
 // filter state. Must be provided with an access log command that %EVENT(<param>)%
 EventFormatter::EventFormatter(const std::string& field, absl::optional<size_t> max_length)
-    : field_(field), max_length_(max_length) {}
+    : is_index_(field == "INDEX"), field_(EricEvent::EventT::fieldFromName(field)),
+      max_length_(max_length) {}
 
 absl::optional<std::string>
 EventFormatter::format(const StreamInfo::StreamInfo& stream_info) const {
@@ -331,7 +332,7 @@ EventFormatter::format(const StreamInfo::StreamInfo& stream_info) const {
   }
   // the index field used to build the uid together with the stream_id is retrieved from the
   // filterstate itself
-  if (field_ == "INDEX") {
+  if (is_index_) {
     return std::to_string(eric_events->getCurrentEventIndex());
   }
   if (max_length_) {
@@ -353,7 +354,7 @@ ProtobufWkt::Value EventFormatter::formatValue(const StreamInfo::StreamInfo& str
   }
   // The index field is used to build the uid together with the stream_id which
   // is retrieved from the filterstate itself
-  if (field_ == "INDEX") {
+  if (is_index_) {
     return ValueUtil::numberValue(eric_events->getCurrentEventIndex());
   }
   // All other fields
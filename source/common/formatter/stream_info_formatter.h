@@ -131,7 +131,10 @@ public:
   ProtobufWkt::Value formatValue(const StreamInfo::StreamInfo& stream_info) const override;
 
 private:
-  std::string field_;
+  // %EVENT(INDEX)% is not a field of the event but the position in the list of events
+  const bool is_index_;
+  // Resolved once here instead of looking up the tag for every logged event
+  const EricEvent::EventT::Field field_;
   absl::optional<size_t> max_length_;
 };
 
@@ -1,8 +1,10 @@
 #include "source/common/http/header_map_impl.h"
 
+#include <algorithm>
 #include <cstdint>
 #include <list>
 #include <memory>
+#include <new>
 #include <string>
 
 #include "envoy/http/header_map.h"
@@ -47,6 +49,39 @@ HeaderString::HeaderString(UnionString&& move_value) noexcept {
   ASSERT(valid());
 }
 
+void* HeaderNodePool::allocate(size_t size) {
+  if (node_size_ == 0) {
+    ASSERT(size >= sizeof(FreeNode));
+    node_size_ = size;
+  }
+  if (size != node_size_) {
+    return ::operator new(size);
+  }
+  if (free_nodes_ != nullptr) {
+    FreeNode* node = free_nodes_;
+    free_nodes_ = node->next_;
+    return node;
+  }
+  if (current_ == end_) {
+    // operator new[] aligns the blocks for any node type, the nodes follow each other.
+    blocks_.push_back(std::unique_ptr<char[]>(new char[next_block_nodes_ * node_size_]));
+    current_ = blocks_.back().get();
+    end_ = current_ + next_block_nodes_ * node_size_;
+    next_block_nodes_ = std::min(next_block_nodes_ * 2, MaxBlockNodes);
+  }
+  void* node = current_;
+  current_ += node_size_;
+  return node;
+}
+
+void HeaderNodePool::deallocate(void* node, size_t size) {
+  if (size != node_size_) {
+    ::operator delete(node);
+    return;
+  }
+  free_nodes_ = new (node) FreeNode{free_nodes_};
+}
+
 // Specialization needed for HeaderMapImpl::HeaderList::insert() when key is LowerCaseString.
 // A fully specialized template must be defined once in the program, hence this may not be in
 // a header file.
@@ -438,6 +473,48 @@ size_t HeaderMapImpl::removePrefix(const LowerCaseString& prefix) {
   });
 }
 
+bool HeaderMapImpl::replaceExisting(absl::string_view key, absl::string_view value) {
+  // A header which exists once keeps its entry and only the value is replaced. This saves the
+  // removal and insertion of the entry and of its lazy map or inline header reference.
+  HeaderMap::NonConstGetResult existing = getExisting(key);
+  if (existing.size() == 1) {
+    HeaderString& existing_value = existing[0]->value();
+    const uint64_t old_size = existing_value.size();
+    existing_value.setCopy(value);
+    updateSize(old_size, existing_value.size());
+    return true;
+  }
+  if (!existing.empty()) {
+    removeExisting(key);
+  }
+  return false;
+}
+
+void HeaderMapImpl::applyMutations(absl::Span<const HeaderMutation> mutations) {
+  for (const HeaderMutation& mutation : mutations) {
+    switch (mutation.type_) {
+    case HeaderMutation::Type::Remove:
+      removeExisting(mutation.key_);
+      break;
+    case HeaderMutation::Type::Set:
+      if (replaceExisting(mutation.key_, mutation.value_)) {
+        break;
+      }
+      FALLTHRU;
+    case HeaderMutation::Type::Add:
+      if (mutation.reference_key_) {
+        addReferenceKey(mutation.key_, mutation.value_);
+      } else {
+        addCopy(mutation.key_, mutation.value_);
+      }
+      break;
+    case HeaderMutation::Type::Append:
+      appendCopy(mutation.key_, mutation.value_);
+      break;
+    }
+  }
+}
+
 void HeaderMapImpl::dumpState(std::ostream& os, int indent_level) const {
   iterate([&os,
            spaces = spacesForLevel(indent_level)](const HeaderEntry& header) -> HeaderMap::Iterate {
@@ -15,6 +15,8 @@
 #include "source/common/http/headers.h"
 #include "source/common/runtime/runtime_features.h"
 
+#include "absl/container/inlined_vector.h"
+
 namespace Envoy {
 namespace Http {
 
@@ -43,6 +45,63 @@ public:
   DEFINE_INLINE_HEADER_FUNCS(name)                                                                 \
   void set##name(uint64_t value) override { setInline(HeaderHandles::get().name, value); }
 
+/**
+ * Storage for the list nodes of a HeaderMapImpl. Nodes are carved out of blocks owned by the pool,
+ * each block twice the size of the previous one, and the nodes of removed headers are reused. This
+ * turns the heap allocation per header into a few allocations per header map. The blocks are only
+ * released together with the pool.
+ */
+class HeaderNodePool : NonCopyable {
+public:
+  void* allocate(size_t size);
+  void deallocate(void* node, size_t size);
+
+  // Number of nodes in the first block, and the most nodes of a block.
+  static constexpr size_t FirstBlockNodes = 4;
+  static constexpr size_t MaxBlockNodes = 64;
+
+private:
+  struct FreeNode {
+    FreeNode* next_;
+  };
+
+  absl::InlinedVector<std::unique_ptr<char[]>, 4> blocks_;
+  char* current_{};
+  char* end_{};
+  FreeNode* free_nodes_{};
+  // Set by the first allocation, all the nodes of a list have the same size.
+  size_t node_size_{};
+  size_t next_block_nodes_{FirstBlockNodes};
+};
+
+/**
+ * Allocator for the std::list of a HeaderMapImpl which takes its nodes from a HeaderNodePool.
+ */
+template <class T> class HeaderNodeAllocator {
+public:
+  using value_type = T;
+
+  explicit HeaderNodeAllocator(HeaderNodePool& pool) noexcept : pool_(&pool) {}
+  template <class U>
+  HeaderNodeAllocator(const HeaderNodeAllocator<U>& other) noexcept // NOLINT
+      : pool_(other.pool()) {}
+
+  T* allocate(size_t n) { return static_cast<T*>(pool_->allocate(n * sizeof(T))); }
+  void deallocate(T* node, size_t n) noexcept { pool_->deallocate(node, n * sizeof(T)); }
+
+  HeaderNodePool* pool() const { return pool_; }
+
+  template <class U> bool operator==(const HeaderNodeAllocator<U>& other) const {
+    return pool_ == other.pool();
+  }
+  template <class U> bool operator!=(const HeaderNodeAllocator<U>& other) const {
+    return pool_ != other.pool();
+  }
+
+private:
+  HeaderNodePool* pool_;
+};
+
 /**
  * Implementation of Http::HeaderMap. This is heavily optimized for performance. Roughly, when
  * headers are added to the map by string, we do a trie lookup to see if it's one of the O(1)
@@ -103,6 +162,7 @@ public:
   size_t remove(const LowerCaseString& key);
   size_t removeIf(const HeaderMap::HeaderMatchPredicate& predicate);
   size_t removePrefix(const LowerCaseString& key);
+  void applyMutations(absl::Span<const HeaderMutation> mutations);
   size_t size() const { return headers_.size(); }
   bool empty() const { return headers_.empty(); }
   void dumpState(std::ostream& os, int indent_level = 0) const;
@@ -127,9 +187,10 @@ protected:
 
     HeaderString key_;
     HeaderString value_;
-    std::list<HeaderEntryImpl>::iterator entry_;
+    std::list<HeaderEntryImpl, HeaderNodeAllocator<HeaderEntryImpl>>::iterator entry_;
   };
-  using HeaderNode = std::list<HeaderEntryImpl>::iterator;
+  using HeaderEntryList = std::list<HeaderEntryImpl, HeaderNodeAllocator<HeaderEntryImpl>>;
+  using HeaderNode = HeaderEntryList::iterator;
 
   /**
    * This is the static lookup table that is used to determine whether a header is one of the O(1)
@@ -185,7 +246,9 @@ protected:
 
   /**
    * List of HeaderEntryImpl that keeps the pseudo headers (key starting with ':') in the front
-   * of the list (as required by nghttp2) and otherwise maintains insertion order.
+   * of the list (as required by nghttp2) and otherwise maintains insertion order. The list nodes
+   * are allocated from a HeaderNodePool owned by the list, so that the entries keep stable
+   * addresses for the O(1) headers without a heap allocation per header.
    * When the list size is greater or equal to 3, all headers are added to a map, to allow fast
    * access given a header key. Once the map is initialized, it will be used even
    * if the number of headers decreases below the threshold.
@@ -292,12 +355,12 @@ protected:
      */
     size_t remove(absl::string_view key);
 
-    std::list<HeaderEntryImpl>::iterator begin() { return headers_.begin(); }
-    std::list<HeaderEntryImpl>::iterator end() { return headers_.end(); }
-    std::list<HeaderEntryImpl>::const_iterator begin() const { return headers_.begin(); }
-    std::list<HeaderEntryImpl>::const_iterator end() const { return headers_.end(); }
-    std::list<HeaderEntryImpl>::const_reverse_iterator rbegin() const { return headers_.rbegin(); }
-    std::list<HeaderEntryImpl>::const_reverse_iterator rend() const { return headers_.rend(); }
+    HeaderEntryList::iterator begin() { return headers_.begin(); }
+    HeaderEntryList::iterator end() { return headers_.end(); }
+    HeaderEntryList::const_iterator begin() const { return headers_.begin(); }
+    HeaderEntryList::const_iterator end() const { return headers_.end(); }
+    HeaderEntryList::const_reverse_iterator rbegin() const { return headers_.rbegin(); }
+    HeaderEntryList::const_reverse_iterator rend() const { return headers_.rend(); }
     HeaderLazyMap::iterator mapFind(absl::string_view key) { return lazy_map_.find(key); }
     HeaderLazyMap::iterator mapEnd() { return lazy_map_.end(); }
     size_t size() const { return headers_.size(); }
@@ -309,7 +372,9 @@ protected:
     }
 
   private:
-    std::list<HeaderEntryImpl> headers_;
+    // Declared before the list, the nodes are returned to the pool when the list is destroyed.
+    HeaderNodePool pool_;
+    HeaderEntryList headers_{HeaderNodeAllocator<HeaderEntryImpl>(pool_)};
     HeaderNode pseudo_headers_end_;
     HeaderLazyMap lazy_map_;
   };
@@ -323,6 +388,9 @@ protected:
 
   HeaderMap::NonConstGetResult getExisting(absl::string_view key);
   size_t removeExisting(absl::string_view key);
+  // Replace the value of the header if it exists once and return true, otherwise remove all
+  // instances of it and return false.
+  bool replaceExisting(absl::string_view key, absl::string_view value);
 
   size_t removeInline(HeaderEntryImpl** entry);
   void updateSize(uint64_t from_size, uint64_t to_size);
@@ -411,6 +479,9 @@ public:
   size_t removePrefix(const LowerCaseString& key) override {
     return HeaderMapImpl::removePrefix(key);
   }
+  void applyMutations(absl::Span<const HeaderMutation> mutations) override {
+    HeaderMapImpl::applyMutations(mutations);
+  }
   size_t size() const override { return HeaderMapImpl::size(); }
   bool empty() const override { return HeaderMapImpl::empty(); }
   void dumpState(std::ostream& os, int indent_level = 0) const override {
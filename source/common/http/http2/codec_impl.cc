@@ -245,7 +245,7 @@ void ConnectionImpl::ServerStreamImpl::encode1xxHeaders(const ResponseHeaderMap&
 void ConnectionImpl::StreamImpl::encodeHeadersBase(const HeaderMap& headers, bool end_stream) {
   local_end_stream_ = end_stream;
   submitHeaders(headers, end_stream);
-  if (parent_.sendPendingFramesAndHandleError()) {
+  if (parent_.sendOrDeferPendingFrames()) {
     // Intended to check through coverage that this error case is tested
     return;
   }
@@ -314,6 +314,13 @@ void ConnectionImpl::StreamImpl::encodeTrailersBase(const HeaderMap& trailers) {
   parent_.updateActiveStreamsOnEncode(*this);
   ASSERT(!local_end_stream_);
   local_end_stream_ = true;
+  if (pending_send_data_->length() > 0 && parent_.deferringPendingFrames()) {
+    // The body may only be waiting for the deferred send rather than for window updates. Send it
+    // now so that the trailers are only saved if the body is actually blocked.
+    if (parent_.sendPendingFramesAndHandleError()) {
+      return;
+    }
+  }
   if (pending_send_data_->length() > 0) {
     // In this case we want trailers to come after we release all pending body data that is
     // waiting on window updates. We need to save the trailers so that we can emit them later.
@@ -326,7 +333,7 @@ void ConnectionImpl::StreamImpl::encodeTrailersBase(const HeaderMap& trailers) {
     }
   } else {
     submitTrailers(trailers);
-    if (parent_.sendPendingFramesAndHandleError()) {
+    if (parent_.sendOrDeferPendingFrames()) {
       // Intended to check through coverage that this error case is tested
       return;
     }
@@ -342,7 +349,7 @@ void ConnectionImpl::StreamImpl::encodeMetadata(const MetadataMapVector& metadat
     parent_.adapter_->SubmitMetadata(stream_id_, 16 * 1024, std::move(source));
   }
 
-  if (parent_.sendPendingFramesAndHandleError()) {
+  if (parent_.sendOrDeferPendingFrames()) {
     // Intended to check through coverage that this error case is tested
     return;
   }
@@ -680,7 +687,7 @@ bool ConnectionImpl::StreamDataFrameSource::Send(absl::string_view frame_header,
 
   stream_.parent_.stats_.pending_send_bytes_.sub(payload_length);
   output.move(*stream_.pending_send_data_, payload_length);
-  stream_.parent_.connection_.write(output, false);
+  stream_.parent_.writeFrames(output);
   return true;
 }
 
@@ -769,12 +776,18 @@ void ConnectionImpl::StreamImpl::encodeDataHelper(Buffer::Instance& data, bool e
     data_deferred_ = false;
   }
 
-  if (parent_.sendPendingFramesAndHandleError()) {
+  const bool deferred = parent_.deferringPendingFrames();
+  if (parent_.sendOrDeferPendingFrames()) {
     // Intended to check through coverage that this error case is tested
     return;
   }
   if (local_end_stream_) {
-    onLocalEndStream();
+    if (deferred) {
+      // Whether data is left for the flush timer is only known once the frames are sent.
+      parent_.deferred_end_streams_.push_back(stream_id_);
+    } else {
+      onLocalEndStream();
+    }
   }
 }
 
@@ -886,9 +899,16 @@ ConnectionImpl::ConnectionImpl(Network::Connection& connection, CodecStats& stat
       per_stream_buffer_limit_(http2_options.initial_stream_window_size().value()),
       stream_error_on_invalid_http_messaging_(
           http2_options.override_stream_error_on_invalid_http_message().value()),
-      protocol_constraints_(stats, http2_options), dispatching_(false), raised_goaway_(false),
+      protocol_constraints_(stats, http2_options),
+      coalesce_writes_(
+          Runtime::runtimeFeatureEnabled("envoy.reloadable_features.http2_coalesce_writes")),
+      dispatching_(false), raised_goaway_(false),
       random_(random_generator),
       last_received_data_time_(connection_.dispatcher().timeSource().monotonicTime()) {
+  if (coalesce_writes_) {
+    send_pending_frames_callback_ = connection.dispatcher().createSchedulableCallback(
+        [this]() { onDeferredSendPendingFrames(); });
+  }
   if (http2_options.has_use_oghttp2_codec()) {
     use_oghttp2_library_ = http2_options.use_oghttp2_codec().value();
   } else {
@@ -1450,10 +1470,29 @@ ssize_t ConnectionImpl::onSend(const uint8_t* data, size_t length) {
   // deleted before the codec object is deleted. This is presently guaranteed by the
   // destruction order of the Network::ConnectionImpl object where write_buffer_ is
   // destroyed before the filter_manager_ which owns the codec through Http::ConnectionManagerImpl.
-  connection_.write(buffer, false);
+  writeFrames(buffer);
   return length;
 }
 
+void ConnectionImpl::writeFrames(Buffer::Instance& output) {
+  if (!coalesce_writes_) {
+    connection_.write(output, false);
+    return;
+  }
+  pending_write_buffer_.move(output);
+  ++pending_write_frames_;
+}
+
+void ConnectionImpl::flushPendingWrites() {
+  if (pending_write_buffer_.length() == 0) {
+    return;
+  }
+  stats_.coalesced_frames_.add(pending_write_frames_);
+  stats_.coalesced_writes_.inc();
+  pending_write_frames_ = 0;
+  connection_.write(pending_write_buffer_, false);
+}
+
 Status ConnectionImpl::onStreamClose(StreamImpl* stream, uint32_t error_code) {
   if (stream) {
     const int32_t stream_id = stream->stream_id_;
@@ -1614,6 +1653,8 @@ Status ConnectionImpl::sendPendingFrames() {
   }
 
   const int rc = adapter_->Send();
+  // The frames serialized by the adapter are written with a single connection write.
+  flushPendingWrites();
   if (rc != 0) {
     ASSERT(rc == NGHTTP2_ERR_CALLBACK_FAILURE);
     return codecProtocolError(nghttp2_strerror(rc));
@@ -1662,6 +1703,35 @@ bool ConnectionImpl::sendPendingFramesAndHandleError() {
   return false;
 }
 
+bool ConnectionImpl::deferringPendingFrames() const {
+  return send_pending_frames_callback_ != nullptr && !dispatching_;
+}
+
+bool ConnectionImpl::sendOrDeferPendingFrames() {
+  if (!deferringPendingFrames()) {
+    return sendPendingFramesAndHandleError();
+  }
+  // The frames of all streams encoding in this dispatcher iteration are sent together.
+  send_pending_frames_callback_->scheduleCallbackCurrentIteration();
+  return false;
+}
+
+void ConnectionImpl::onDeferredSendPendingFrames() {
+  std::vector<int32_t> end_streams;
+  end_streams.swap(deferred_end_streams_);
+  if (sendPendingFramesAndHandleError()) {
+    return;
+  }
+  for (const int32_t stream_id : end_streams) {
+    // The stream may have been closed or reset in the meantime.
+    StreamImpl* stream = getStreamUnchecked(stream_id);
+    if (stream != nullptr && !stream->reset_reason_.has_value() &&
+        !stream->local_end_stream_sent_) {
+      stream->onLocalEndStream();
+    }
+  }
+}
+
 void ConnectionImpl::sendSettingsHelper(
     const envoy::config::core::v3::Http2ProtocolOptions& http2_options, bool disable_push) {
   absl::InlinedVector<http2::adapter::Http2Setting, 10> settings;
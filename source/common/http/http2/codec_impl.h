@@ -677,6 +677,25 @@ protected:
    * Return true if the disconnect callback has been scheduled.
    */
   bool sendPendingFramesAndHandleError();
+
+  /**
+   * Same as sendPendingFramesAndHandleError(), except that with write coalescing enabled the
+   * frames are sent at the end of the current dispatcher iteration, together with the frames of
+   * the other streams encoding in it.
+   */
+  bool sendOrDeferPendingFrames();
+  // True if sendOrDeferPendingFrames() would defer the send.
+  bool deferringPendingFrames() const;
+  // The deferred send. Arms the flush timers of the streams that ended while it was pending and
+  // still have data left once it is done.
+  void onDeferredSendPendingFrames();
+
+  /**
+   * Write serialized frames to the connection. With write coalescing enabled the frames are
+   * buffered until flushPendingWrites() is called at the end of the send pass.
+   */
+  void writeFrames(Buffer::Instance& output);
+  void flushPendingWrites();
   void sendSettings(const envoy::config::core::v3::Http2ProtocolOptions& http2_options,
                     bool disable_push);
   void sendSettingsHelper(const envoy::config::core::v3::Http2ProtocolOptions& http2_options,
@@ -749,6 +768,15 @@ protected:
   bool is_outbound_flood_monitored_control_frame_ = 0;
   ProtocolConstraints protocol_constraints_;
 
+  // Set by the envoy.reloadable_features.http2_coalesce_writes runtime feature.
+  const bool coalesce_writes_;
+  // Frames serialized in the current send pass, and the number of frames in it.
+  Buffer::OwnedImpl pending_write_buffer_;
+  uint64_t pending_write_frames_{0};
+  Event::SchedulableCallbackPtr send_pending_frames_callback_;
+  // Ids of the streams that encoded their end of stream while the send was deferred.
+  std::vector<int32_t> deferred_end_streams_;
+
   // For the flood mitigation to work the onSend callback must be called once for each outbound
   // frame. This is what the nghttp2 library is doing, however this is not documented. The
   // Http2FloodMitigationTest.* tests in test/integration/http2_integration_test.cc will break if
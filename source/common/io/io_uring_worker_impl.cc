@@ -4,12 +4,14 @@ namespace Envoy {
 namespace Io {
 
 ReadRequest::ReadRequest(IoUringSocket& socket, uint32_t size)
-    : Request(RequestType::Read, socket), buf_(std::make_unique<uint8_t[]>(size)),
+    : Request(RequestType::Read, socket), buf_(Buffer::Slice::allocateStorage(size)), size_(size),
       iov_(std::make_unique<struct iovec>()) {
   iov_->iov_base = buf_.get();
   iov_->iov_len = size;
 }
 
+ReadRequest::~ReadRequest() { Buffer::Slice::freeStorage(std::move(buf_), size_); }
+
 WriteRequest::WriteRequest(IoUringSocket& socket, const Buffer::RawSliceVector& slices)
     : Request(RequestType::Write, socket), iov_(std::make_unique<struct iovec[]>(slices.size())) {
   for (size_t i = 0; i < slices.size(); i++) {
@@ -426,10 +428,15 @@ void IoUringServerSocket::onCancel(Request* req, int32_t result, bool injected)
 
 void IoUringServerSocket::moveReadDataToBuffer(Request* req, size_t data_length) {
   ReadRequest* read_req = static_cast<ReadRequest*>(req);
+  // The storage of the request is moved into read_buf_ without a copy and goes back to the slice
+  // storage pool once it is drained.
   Buffer::BufferFragment* fragment = new Buffer::BufferFragmentImpl(
       read_req->buf_.release(), data_length,
-      [](const void* data, size_t, const Buffer::BufferFragmentImpl* this_fragment) {
-        delete[] reinterpret_cast<const uint8_t*>(data);
+      [size = read_req->size_](const void* data, size_t,
+                               const Buffer::BufferFragmentImpl* this_fragment) {
+        Buffer::Slice::freeStorage(
+            Buffer::Slice::StoragePtr{const_cast<uint8_t*>(static_cast<const uint8_t*>(data))},
+            size);
         delete this_fragment;
       });
   read_buf_.addBufferFragment(*fragment);
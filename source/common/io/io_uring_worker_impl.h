@@ -13,8 +13,12 @@ namespace Io {
 class ReadRequest : public Request {
 public:
   ReadRequest(IoUringSocket& socket, uint32_t size);
+  ~ReadRequest() override;
 
-  std::unique_ptr<uint8_t[]> buf_;
+  // Allocated through Buffer::Slice, so that read buffers of the default slice size are taken
+  // from and returned to the thread local slice storage pool.
+  Buffer::Slice::StoragePtr buf_;
+  const uint32_t size_;
   std::unique_ptr<struct iovec> iov_;
 };
 
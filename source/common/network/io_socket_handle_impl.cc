@@ -11,6 +11,10 @@
 #include "absl/container/fixed_array.h"
 #include "absl/types/optional.h"
 
+#ifdef __linux__
+#include <linux/errqueue.h>
+#endif
+
 using Envoy::Api::SysCallIntResult;
 using Envoy::Api::SysCallSizeResult;
 
@@ -226,6 +230,63 @@ Api::IoCallUint64Result IoSocketHandleImpl::sendmsg(const Buffer::RawSlice* slic
   }
 }
 
+Api::IoCallUint64Result IoSocketHandleImpl::send(const Buffer::RawSlice* slices,
+                                                 uint64_t num_slice, int flags) {
+  absl::FixedArray<iovec> iov(num_slice);
+  uint64_t num_slices_to_write = 0;
+  for (uint64_t i = 0; i < num_slice; i++) {
+    if (slices[i].mem_ != nullptr && slices[i].len_ != 0) {
+      iov[num_slices_to_write].iov_base = slices[i].mem_;
+      iov[num_slices_to_write].iov_len = slices[i].len_;
+      num_slices_to_write++;
+    }
+  }
+  if (num_slices_to_write == 0) {
+    return Api::ioCallUint64ResultNoError();
+  }
+
+  msghdr message{};
+  message.msg_iov = iov.begin();
+  message.msg_iovlen = num_slices_to_write;
+  return sysCallResultToIoCallResult(
+      Api::OsSysCallsSingleton::get().sendmsg(fd_, &message, flags));
+}
+
+Api::IoCallUint64Result IoSocketHandleImpl::recvZeroCopyCompletion(ZeroCopyCompletion& completion) {
+#if defined(__linux__) && defined(SO_EE_ORIGIN_ZEROCOPY)
+  while (true) {
+    char control[CMSG_SPACE(sizeof(sock_extended_err) + sizeof(sockaddr_in6))];
+    msghdr message{};
+    message.msg_control = control;
+    message.msg_controllen = sizeof(control);
+    const Api::SysCallSizeResult result =
+        Api::OsSysCallsSingleton::get().recvmsg(fd_, &message, MSG_ERRQUEUE);
+    if (result.return_value_ < 0) {
+      return sysCallResultToIoCallResult(result);
+    }
+    for (cmsghdr* cmsg = CMSG_FIRSTHDR(&message); cmsg != nullptr;
+         cmsg = CMSG_NXTHDR(&message, cmsg)) {
+      if (!(cmsg->cmsg_level == SOL_IP && cmsg->cmsg_type == IP_RECVERR) &&
+          !(cmsg->cmsg_level == SOL_IPV6 && cmsg->cmsg_type == IPV6_RECVERR)) {
+        continue;
+      }
+      const auto* error = reinterpret_cast<const sock_extended_err*>(CMSG_DATA(cmsg));
+      if (error->ee_errno != 0 || error->ee_origin != SO_EE_ORIGIN_ZEROCOPY) {
+        continue;
+      }
+      completion.first_id_ = error->ee_info;
+      completion.last_id_ = error->ee_data;
+      completion.copied_ = (error->ee_code & SO_EE_CODE_ZEROCOPY_COPIED) != 0;
+      return Api::ioCallUint64ResultNoError();
+    }
+    // Not a zero copy notification, read the next one.
+  }
+#else
+  UNREFERENCED_PARAMETER(completion);
+  return {0, IoSocketError::create(SOCKET_ERROR_NOT_SUP)};
+#endif
+}
+
 Address::InstanceConstSharedPtr
 maybeGetDstAddressFromHeader(const cmsghdr& cmsg, uint32_t self_port, os_fd_t fd, bool v6only) {
   if (cmsg.cmsg_type == IPV6_PKTINFO) {
@@ -0,0 +1,269 @@
+#include "source/common/network/io_uring_socket_handle_impl.h"
+
+#include "envoy/buffer/buffer.h"
+
+#include "source/common/api/os_sys_calls_impl.h"
+#include "source/common/common/assert.h"
+
+namespace Envoy {
+namespace Network {
+
+IoUringSocketHandleImpl::IoUringSocketHandleImpl(Io::IoUringWorkerFactory& io_uring_worker_factory,
+                                                 os_fd_t fd, bool socket_v6only,
+                                                 absl::optional<int> domain, bool is_accepted)
+    : IoSocketHandleImpl(fd, socket_v6only, domain),
+      io_uring_worker_factory_(io_uring_worker_factory),
+      io_uring_socket_type_(is_accepted ? IoUringSocketType::Accepted
+                                        : IoUringSocketType::Unknown) {}
+
+IoUringSocketHandleImpl::~IoUringSocketHandleImpl() {
+  if (SOCKET_VALID(fd_)) {
+    IoUringSocketHandleImpl::close();
+  }
+}
+
+Api::IoCallUint64Result IoUringSocketHandleImpl::close() {
+  if (!io_uring_socket_.has_value()) {
+    return IoSocketHandleImpl::close();
+  }
+  // The io_uring socket closes the fd once its pending requests are done, or cancelled.
+  io_uring_socket_->close(false);
+  io_uring_socket_.reset();
+  SET_SOCKET_INVALID(fd_);
+  return Api::ioCallUint64ResultNoError();
+}
+
+Api::IoCallUint64Result IoUringSocketHandleImpl::consumeReadData(
+    uint64_t max_length, bool drain,
+    const std::function<void(Buffer::Instance& data, uint64_t length)>& consume) {
+  const OptRef<Io::ReadParam>& read_param = io_uring_socket_->getReadParam();
+  if (!read_param.has_value()) {
+    // Not called from a read event, the data is delivered with the next one.
+    return {0, IoSocketError::getIoSocketEagainError()};
+  }
+  Buffer::Instance& data = read_param->buf_;
+  if (data.length() > 0) {
+    const uint64_t length = std::min(max_length, data.length());
+    consume(data, length);
+    if (drain) {
+      data.drain(length);
+    }
+    return {length, Api::IoError::none()};
+  }
+  if (read_param->result_ == 0) {
+    // Remote close.
+    return Api::ioCallUint64ResultNoError();
+  }
+  if (read_param->result_ < 0 && -read_param->result_ != SOCKET_ERROR_AGAIN) {
+    return {0, IoSocketError::create(-read_param->result_)};
+  }
+  return {0, IoSocketError::getIoSocketEagainError()};
+}
+
+Api::IoCallUint64Result IoUringSocketHandleImpl::readv(uint64_t max_length,
+                                                       Buffer::RawSlice* slices,
+                                                       uint64_t num_slice) {
+  if (!io_uring_socket_.has_value()) {
+    return IoSocketHandleImpl::readv(max_length, slices, num_slice);
+  }
+  uint64_t slices_length = 0;
+  for (uint64_t i = 0; i < num_slice; i++) {
+    slices_length += slices[i].len_;
+  }
+  return consumeReadData(std::min(max_length, slices_length), true,
+                         [slices](Buffer::Instance& data, uint64_t length) {
+                           uint64_t offset = 0;
+                           for (uint64_t i = 0; offset < length; i++) {
+                             const uint64_t slice_length =
+                                 std::min<uint64_t>(slices[i].len_, length - offset);
+                             data.copyOut(offset, slice_length, slices[i].mem_);
+                             offset += slice_length;
+                           }
+                         });
+}
+
+Api::IoCallUint64Result IoUringSocketHandleImpl::read(Buffer::Instance& buffer,
+                                                      absl::optional<uint64_t> max_length) {
+  if (!io_uring_socket_.has_value()) {
+    return IoSocketHandleImpl::read(buffer, max_length);
+  }
+  // The slices of the read buffer are moved, not copied.
+  return consumeReadData(max_length.value_or(UINT64_MAX), false,
+                         [&buffer](Buffer::Instance& data, uint64_t length) {
+                           buffer.move(data, length);
+                         });
+}
+
+Api::IoCallUint64Result IoUringSocketHandleImpl::writev(const Buffer::RawSlice* slices,
+                                                        uint64_t num_slice) {
+  if (!io_uring_socket_.has_value()) {
+    return IoSocketHandleImpl::writev(slices, num_slice);
+  }
+  return {io_uring_socket_->write(slices, num_slice), Api::IoError::none()};
+}
+
+Api::IoCallUint64Result IoUringSocketHandleImpl::write(Buffer::Instance& buffer) {
+  if (!io_uring_socket_.has_value()) {
+    return IoSocketHandleImpl::write(buffer);
+  }
+  const uint64_t length = buffer.length();
+  io_uring_socket_->write(buffer);
+  return {length, Api::IoError::none()};
+}
+
+Api::IoCallUint64Result IoUringSocketHandleImpl::recv(void* buffer, size_t length, int flags) {
+  if (!io_uring_socket_.has_value()) {
+    return IoSocketHandleImpl::recv(buffer, length, flags);
+  }
+  // Listener filters peek at the data the io_uring socket has already read.
+  return consumeReadData(length, !(flags & MSG_PEEK),
+                         [buffer](Buffer::Instance& data, uint64_t length) {
+                           data.copyOut(0, length, buffer);
+                         });
+}
+
+Api::SysCallIntResult IoUringSocketHandleImpl::listen(int backlog) {
+  io_uring_socket_type_ = IoUringSocketType::Listener;
+  return IoSocketHandleImpl::listen(backlog);
+}
+
+IoHandlePtr IoUringSocketHandleImpl::accept(struct sockaddr* addr, socklen_t* addrlen) {
+  auto result = Api::OsSysCallsSingleton::get().accept(fd_, addr, addrlen);
+  if (SOCKET_INVALID(result.return_value_)) {
+    return nullptr;
+  }
+  return std::make_unique<IoUringSocketHandleImpl>(io_uring_worker_factory_, result.return_value_,
+                                                   socket_v6only_, domain_, true);
+}
+
+Api::SysCallIntResult IoUringSocketHandleImpl::connect(Address::InstanceConstSharedPtr address) {
+  if (!io_uring_socket_.has_value()) {
+    return IoSocketHandleImpl::connect(address);
+  }
+  ASSERT(io_uring_socket_type_ == IoUringSocketType::Client);
+  connect_submitted_ = true;
+  io_uring_socket_->connect(address);
+  return Api::SysCallIntResult{-1, SOCKET_ERROR_IN_PROGRESS};
+}
+
+Api::SysCallIntResult IoUringSocketHandleImpl::setOption(int level, int optname,
+                                                         const void* optval, socklen_t optlen) {
+#ifdef SO_ZEROCOPY
+  // Zero copy sends bypass the write buffer of the io_uring socket, refuse them so that the
+  // transport socket writes through it.
+  if (io_uring_socket_.has_value() && level == SOL_SOCKET && optname == SO_ZEROCOPY) {
+    return {-1, SOCKET_ERROR_NOT_SUP};
+  }
+#endif
+  return IoSocketHandleImpl::setOption(level, optname, optval, optlen);
+}
+
+Api::SysCallIntResult IoUringSocketHandleImpl::getOption(int level, int optname, void* optval,
+                                                         socklen_t* optlen) {
+  // The result of an io_uring connect is delivered with the write event instead of SO_ERROR.
+  if (io_uring_socket_.has_value() && level == SOL_SOCKET && optname == SO_ERROR &&
+      io_uring_socket_->getWriteParam().has_value()) {
+    ASSERT(*optlen == sizeof(int));
+    const int32_t result = io_uring_socket_->getWriteParam()->result_;
+    *static_cast<int*>(optval) = result < 0 ? -result : 0;
+    return {0, 0};
+  }
+  return IoSocketHandleImpl::getOption(level, optname, optval, optlen);
+}
+
+void IoUringSocketHandleImpl::initializeFileEvent(Event::Dispatcher& dispatcher,
+                                                  Event::FileReadyCb cb,
+                                                  Event::FileTriggerType trigger,
+                                                  uint32_t events) {
+  if (io_uring_socket_.has_value()) {
+    // The file events of an accepted socket are initialized again by the connection after the
+    // listener filters are done with it.
+    ASSERT(&io_uring_socket_->getIoUringWorker().dispatcher() == &dispatcher);
+    cb_ = std::move(cb);
+    enableFileEvents(events);
+    return;
+  }
+
+  OptRef<Io::IoUringWorker> worker = io_uring_worker_factory_.getIoUringWorker();
+  if (io_uring_socket_type_ == IoUringSocketType::Listener || !worker.has_value() ||
+      &worker->dispatcher() != &dispatcher) {
+    IoSocketHandleImpl::initializeFileEvent(dispatcher, std::move(cb), trigger, events);
+    return;
+  }
+
+  cb_ = std::move(cb);
+  if (io_uring_socket_type_ == IoUringSocketType::Accepted) {
+    io_uring_socket_ =
+        worker->addServerSocket(fd_, [this](uint32_t events) { onFileEvent(events); }, false);
+    enableFileEvents(events);
+    return;
+  }
+  // Client sockets are read enabled by the io_uring socket once their connect completes.
+  io_uring_socket_type_ = IoUringSocketType::Client;
+  io_uring_socket_ =
+      worker->addClientSocket(fd_, [this](uint32_t events) { onFileEvent(events); }, false);
+  file_events_ = events;
+}
+
+void IoUringSocketHandleImpl::onFileEvent(uint32_t events) {
+  if (io_uring_socket_type_ == IoUringSocketType::Client && connect_submitted_ && !connected_) {
+    connected_ = true;
+    const OptRef<Io::WriteParam>& write_param = io_uring_socket_->getWriteParam();
+    if (write_param.has_value() && write_param->result_ == 0) {
+      enableFileEvents(file_events_);
+    }
+  }
+  cb_(events);
+}
+
+void IoUringSocketHandleImpl::activateFileEvents(uint32_t events) {
+  if (!io_uring_socket_.has_value()) {
+    IoSocketHandleImpl::activateFileEvents(events);
+    return;
+  }
+  if (events & Event::FileReadyType::Read) {
+    io_uring_socket_->injectCompletion(Io::Request::RequestType::Read);
+  }
+  if (events & Event::FileReadyType::Write) {
+    io_uring_socket_->injectCompletion(Io::Request::RequestType::Write);
+  }
+}
+
+void IoUringSocketHandleImpl::enableFileEvents(uint32_t events) {
+  if (!io_uring_socket_.has_value()) {
+    IoSocketHandleImpl::enableFileEvents(events);
+    return;
+  }
+  if (io_uring_socket_type_ == IoUringSocketType::Client && !connected_) {
+    file_events_ = events;
+    return;
+  }
+  if (events & Event::FileReadyType::Read) {
+    io_uring_socket_->enableRead();
+  } else {
+    io_uring_socket_->disableRead();
+  }
+  io_uring_socket_->enableCloseEvent(events & Event::FileReadyType::Closed);
+}
+
+void IoUringSocketHandleImpl::resetFileEvents() {
+  if (!io_uring_socket_.has_value()) {
+    IoSocketHandleImpl::resetFileEvents();
+    return;
+  }
+  // The io_uring socket keeps the data it has read until the file events are initialized again.
+  io_uring_socket_->disableRead();
+  io_uring_socket_->enableCloseEvent(false);
+}
+
+Api::SysCallIntResult IoUringSocketHandleImpl::shutdown(int how) {
+  // The io_uring socket only shuts down the write side, after its write buffer is drained.
+  if (!io_uring_socket_.has_value() || how != ENVOY_SHUT_WR) {
+    return IoSocketHandleImpl::shutdown(how);
+  }
+  io_uring_socket_->shutdown(how);
+  return {0, 0};
+}
+
+} // namespace Network
+} // namespace Envoy
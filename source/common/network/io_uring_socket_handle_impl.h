@@ -0,0 +1,70 @@
+#pragma once
+
+#include "envoy/common/io/io_uring.h"
+
+#include "source/common/network/io_socket_handle_impl.h"
+
+namespace Envoy {
+namespace Network {
+
+/**
+ * IoHandle for TCP sockets which submits reads, writes, connects and closes through the
+ * IoUringWorker of the thread the file event is initialized on. Listening sockets, and sockets on
+ * threads without a worker, use the readiness based IoSocketHandleImpl code paths.
+ *
+ * Reads complete into buffers owned by the io_uring socket, read() and readv() only move the data
+ * out of them while the read event is delivered. Writes are moved into the write buffer of the io
+ * uring socket and always complete in full, the socket drains the buffer in the background.
+ */
+class IoUringSocketHandleImpl : public IoSocketHandleImpl {
+public:
+  IoUringSocketHandleImpl(Io::IoUringWorkerFactory& io_uring_worker_factory,
+                          os_fd_t fd = INVALID_SOCKET, bool socket_v6only = false,
+                          absl::optional<int> domain = absl::nullopt, bool is_accepted = false);
+  ~IoUringSocketHandleImpl() override;
+
+  // IoHandle
+  Api::IoCallUint64Result close() override;
+  Api::IoCallUint64Result readv(uint64_t max_length, Buffer::RawSlice* slices,
+                                uint64_t num_slice) override;
+  Api::IoCallUint64Result read(Buffer::Instance& buffer,
+                               absl::optional<uint64_t> max_length) override;
+  Api::IoCallUint64Result writev(const Buffer::RawSlice* slices, uint64_t num_slice) override;
+  Api::IoCallUint64Result write(Buffer::Instance& buffer) override;
+  Api::IoCallUint64Result recv(void* buffer, size_t length, int flags) override;
+  Api::SysCallIntResult listen(int backlog) override;
+  IoHandlePtr accept(struct sockaddr* addr, socklen_t* addrlen) override;
+  Api::SysCallIntResult connect(Address::InstanceConstSharedPtr address) override;
+  Api::SysCallIntResult setOption(int level, int optname, const void* optval,
+                                  socklen_t optlen) override;
+  Api::SysCallIntResult getOption(int level, int optname, void* optval, socklen_t* optlen) override;
+  void initializeFileEvent(Event::Dispatcher& dispatcher, Event::FileReadyCb cb,
+                           Event::FileTriggerType trigger, uint32_t events) override;
+  void activateFileEvents(uint32_t events) override;
+  void enableFileEvents(uint32_t events) override;
+  void resetFileEvents() override;
+  Api::SysCallIntResult shutdown(int how) override;
+
+private:
+  enum class IoUringSocketType { Unknown, Accepted, Client, Listener };
+
+  void onFileEvent(uint32_t events);
+  // Pass up to max_length bytes of the data delivered with the current read event to consume(),
+  // then drain them from the read buffer of the io_uring socket if drain is true.
+  Api::IoCallUint64Result
+  consumeReadData(uint64_t max_length, bool drain,
+                  const std::function<void(Buffer::Instance& data, uint64_t length)>& consume);
+
+  Io::IoUringWorkerFactory& io_uring_worker_factory_;
+  IoUringSocketType io_uring_socket_type_;
+  // The socket is owned by the IoUringWorker and removes itself once its close completes.
+  OptRef<Io::IoUringSocket> io_uring_socket_;
+  Event::FileReadyCb cb_;
+  // Events enabled before the connect of a client socket completed, applied once it did.
+  uint32_t file_events_{0};
+  bool connect_submitted_{false};
+  bool connected_{false};
+};
+
+} // namespace Network
+} // namespace Envoy
@@ -1,13 +1,27 @@
 #include "source/common/network/raw_buffer_socket.h"
 
-#include "source/common/api/os_sys_calls_impl.h"
+#include <algorithm>
+
 #include "source/common/common/assert.h"
 #include "source/common/common/empty_string.h"
 #include "source/common/http/headers.h"
 
+#include "absl/container/inlined_vector.h"
+
+#if defined(__linux__) && defined(MSG_ZEROCOPY) && defined(SO_ZEROCOPY)
+#define ENVOY_RAW_BUFFER_ZERO_COPY
+#endif
+
 namespace Envoy {
 namespace Network {
 
+namespace {
+
+// Same as IoSocketHandleImpl::write().
+constexpr uint64_t MaxSendSlices = 16;
+
+} // namespace
+
 void RawBufferSocket::setTransportSocketCallbacks(TransportSocketCallbacks& callbacks) {
   ASSERT(!callbacks_);
   callbacks_ = &callbacks;
@@ -52,9 +66,13 @@ IoResult RawBufferSocket::doWrite(Buffer::Instance& buffer, bool end_stream) {
   PostIoAction action;
   uint64_t bytes_written = 0;
   absl::optional<Api::IoError::IoErrorCode> err = absl::nullopt;
-  ASSERT(!shutdown_ || buffer.length() == 0);
+  ASSERT(!shutdown_ || buffer.length() == in_flight_bytes_);
+  if (!in_flight_sends_.empty()) {
+    releaseCompletedSends(buffer);
+  }
   do {
-    if (buffer.length() == 0) {
+    if (buffer.length() == in_flight_bytes_) {
+      // The bytes in flight are already queued in the kernel, so the FIN is sent after them.
       if (end_stream && !shutdown_) {
         // Ignore the result. This can only fail if the connection failed. In that case, the
         // error will be detected on the next read, and dealt with appropriately.
@@ -64,7 +82,12 @@ IoResult RawBufferSocket::doWrite(Buffer::Instance& buffer, bool end_stream) {
       action = PostIoAction::KeepOpen;
       break;
     }
-    Api::IoCallUint64Result result = callbacks_->ioHandle().write(buffer);
+    // Once a send is in flight, later sends have to skip its bytes at the front of the buffer.
+    const bool send_after_in_flight =
+        in_flight_bytes_ > 0 || (zero_copy_send_threshold_ > 0 &&
+                                 buffer.length() >= zero_copy_send_threshold_ && zeroCopyEnabled());
+    Api::IoCallUint64Result result = send_after_in_flight ? sendAfterInFlight(buffer)
+                                                          : callbacks_->ioHandle().write(buffer);
 
     if (result.ok()) {
       ENVOY_CONN_LOG(trace, "write returns: {}", callbacks_->connection(), result.return_value_);
@@ -85,6 +108,118 @@ IoResult RawBufferSocket::doWrite(Buffer::Instance& buffer, bool end_stream) {
   return {action, bytes_written, false, err};
 }
 
+bool RawBufferSocket::zeroCopyEnabled() {
+  if (!zero_copy_enabled_.has_value()) {
+    zero_copy_enabled_ = false;
+#ifdef ENVOY_RAW_BUFFER_ZERO_COPY
+    const int enable = 1;
+    zero_copy_enabled_ = callbacks_->ioHandle()
+                             .setOption(SOL_SOCKET, SO_ZEROCOPY, &enable, sizeof(enable))
+                             .return_value_ == 0;
+#endif
+    ENVOY_CONN_LOG(debug, "zero copy sends enabled: {}", callbacks_->connection(),
+                   zero_copy_enabled_.value());
+  }
+  return zero_copy_enabled_.value();
+}
+
+Api::IoCallUint64Result RawBufferSocket::sendAfterInFlight(Buffer::Instance& buffer) {
+  absl::InlinedVector<Buffer::RawSlice, MaxSendSlices> slices;
+  uint64_t skip = in_flight_bytes_;
+  for (const Buffer::RawSlice& slice : buffer.getRawSlices()) {
+    if (skip >= slice.len_) {
+      skip -= slice.len_;
+      continue;
+    }
+    slices.push_back({static_cast<uint8_t*>(slice.mem_) + skip, slice.len_ - skip});
+    skip = 0;
+    if (slices.size() == MaxSendSlices) {
+      break;
+    }
+  }
+  ASSERT(!slices.empty());
+
+  bool zero_copy = zero_copy_send_threshold_ > 0 &&
+                   buffer.length() - in_flight_bytes_ >= zero_copy_send_threshold_ &&
+                   zeroCopyEnabled();
+  IoHandle& io_handle = callbacks_->ioHandle();
+#ifdef ENVOY_RAW_BUFFER_ZERO_COPY
+  Api::IoCallUint64Result result =
+      io_handle.send(slices.data(), slices.size(), zero_copy ? MSG_ZEROCOPY : 0);
+#else
+  Api::IoCallUint64Result result = io_handle.send(slices.data(), slices.size(), 0);
+#endif
+  if (!result.ok() && zero_copy && result.err_->getSystemErrorCode() == ENOBUFS) {
+    // The socket's option memory is taken by pending notifications, copy this send instead.
+    zero_copy = false;
+    result = io_handle.send(slices.data(), slices.size(), 0);
+  }
+  if (!result.ok()) {
+    return result;
+  }
+
+  const uint64_t bytes_sent = result.return_value_;
+  if (!zero_copy && in_flight_sends_.empty()) {
+    buffer.drain(bytes_sent);
+  } else {
+    in_flight_sends_.push_back(
+        {zero_copy ? absl::make_optional(next_zero_copy_id_++) : absl::nullopt, bytes_sent});
+    in_flight_bytes_ += bytes_sent;
+  }
+  return result;
+}
+
+void RawBufferSocket::readZeroCopyCompletions() {
+  IoHandle::ZeroCopyCompletion completion;
+  while (callbacks_->ioHandle().recvZeroCopyCompletion(completion).ok()) {
+    if (completion.copied_ && zero_copy_enabled_.value_or(false)) {
+      // Zero copy only adds the cost of the notifications when the kernel copies anyway.
+      ENVOY_CONN_LOG(debug, "kernel copied zero copy send, disabling zero copy sends",
+                     callbacks_->connection());
+      zero_copy_enabled_ = false;
+    }
+    // Notifications cover the range of ids [first, last], in order.
+    last_completed_zero_copy_id_ = completion.last_id_;
+  }
+}
+
+bool RawBufferSocket::sendCompleted(const InFlightSend& send) const {
+  return !send.zero_copy_id_.has_value() ||
+         (last_completed_zero_copy_id_.has_value() &&
+          static_cast<int32_t>(last_completed_zero_copy_id_.value() -
+                               send.zero_copy_id_.value()) >= 0);
+}
+
+void RawBufferSocket::releaseCompletedSends(Buffer::Instance& buffer) {
+  readZeroCopyCompletions();
+  uint64_t completed_bytes = 0;
+  while (!in_flight_sends_.empty() && sendCompleted(in_flight_sends_.front())) {
+    completed_bytes += in_flight_sends_.front().length_;
+    in_flight_sends_.pop_front();
+  }
+  in_flight_bytes_ -= completed_bytes;
+  buffer.drain(completed_bytes);
+}
+
+void RawBufferSocket::closeSocket(Network::ConnectionEvent) {
+  if (in_flight_sends_.empty()) {
+    return;
+  }
+  readZeroCopyCompletions();
+  if (std::all_of(in_flight_sends_.begin(), in_flight_sends_.end(),
+                  [this](const InFlightSend& send) { return sendCompleted(send); })) {
+    return;
+  }
+  // The connection drains the write buffer next, while the kernel may still hold the bytes of
+  // zero copy sends for (re)transmission. This happens on closes without flushing, such as
+  // resets or the delayed close timeout, so abort the connection instead: the kernel then drops
+  // the unsent data in close() and never reads the freed memory.
+  ENVOY_CONN_LOG(debug, "closing with zero copy sends in flight, resetting the connection",
+                 callbacks_->connection());
+  const struct linger linger = {1, 0};
+  callbacks_->ioHandle().setOption(SOL_SOCKET, SO_LINGER, &linger, sizeof(linger));
+}
+
 std::string RawBufferSocket::protocol() const { return EMPTY_STRING; }
 absl::string_view RawBufferSocket::failureReason() const { return EMPTY_STRING; }
 
@@ -93,11 +228,11 @@ void RawBufferSocket::onConnected() { callbacks_->raiseEvent(ConnectionEvent::Co
 TransportSocketPtr
 RawBufferSocketFactory::createTransportSocket(TransportSocketOptionsConstSharedPtr,
                                               Upstream::HostDescriptionConstSharedPtr) const {
-  return std::make_unique<RawBufferSocket>();
+  return std::make_unique<RawBufferSocket>(zero_copy_send_threshold_);
 }
 
 TransportSocketPtr RawBufferSocketFactory::createDownstreamTransportSocket() const {
-  return std::make_unique<RawBufferSocket>();
+  return std::make_unique<RawBufferSocket>(zero_copy_send_threshold_);
 }
 
 bool RawBufferSocketFactory::implementsSecureTransport() const { return false; }
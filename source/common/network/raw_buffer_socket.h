@@ -1,5 +1,7 @@
 #pragma once
 
+#include <deque>
+
 #include "envoy/buffer/buffer.h"
 #include "envoy/network/connection.h"
 #include "envoy/network/transport_socket.h"
@@ -12,12 +14,21 @@ namespace Network {
 
 class RawBufferSocket : public TransportSocket, protected Logger::Loggable<Logger::Id::connection> {
 public:
+  /**
+   * @param zero_copy_send_threshold if not 0, writes with at least this many bytes pending are
+   * sent with MSG_ZEROCOPY. The sent bytes stay at the front of the write buffer until the kernel
+   * reports through the socket error queue that it no longer references them. Closing the socket
+   * while zero copy sends are still pending resets the connection.
+   */
+  explicit RawBufferSocket(uint32_t zero_copy_send_threshold = 0)
+      : zero_copy_send_threshold_(zero_copy_send_threshold) {}
+
   // Network::TransportSocket
   void setTransportSocketCallbacks(TransportSocketCallbacks& callbacks) override;
   std::string protocol() const override;
   absl::string_view failureReason() const override;
   bool canFlushClose() override { return true; }
-  void closeSocket(Network::ConnectionEvent) override {}
+  void closeSocket(Network::ConnectionEvent) override;
   void onConnected() override;
   IoResult doRead(Buffer::Instance& buffer) override;
   IoResult doWrite(Buffer::Instance& buffer, bool end_stream) override;
@@ -29,13 +40,42 @@ protected:
   TransportSocketCallbacks* transportSocketCallbacks() const { return callbacks_; };
 
 private:
+  // A send whose bytes are at the front of the write buffer until the kernel is done with them.
+  struct InFlightSend {
+    // Notification id of a MSG_ZEROCOPY send. Sends which were copied while zero copy sends were
+    // in flight have no id, and are released together with the zero copy send before them.
+    absl::optional<uint32_t> zero_copy_id_;
+    uint64_t length_;
+  };
+
+  bool zeroCopyEnabled();
+  // Send the bytes of the buffer after the ones in flight.
+  Api::IoCallUint64Result sendAfterInFlight(Buffer::Instance& buffer);
+  // Read the zero copy notifications from the socket error queue.
+  void readZeroCopyCompletions();
+  bool sendCompleted(const InFlightSend& send) const;
+  // Read the zero copy notifications, and drain the bytes of the completed sends from the front
+  // of the buffer.
+  void releaseCompletedSends(Buffer::Instance& buffer);
+
   bool shutdown_{};
   TransportSocketCallbacks* callbacks_{};
+  const uint32_t zero_copy_send_threshold_;
+  // Unset until SO_ZEROCOPY is set on the first large write, false if that failed or the kernel
+  // reported that it copied the data anyway.
+  absl::optional<bool> zero_copy_enabled_;
+  uint32_t next_zero_copy_id_{0};
+  absl::optional<uint32_t> last_completed_zero_copy_id_;
+  std::deque<InFlightSend> in_flight_sends_;
+  uint64_t in_flight_bytes_{0};
 };
 
 class RawBufferSocketFactory : public DownstreamTransportSocketFactory,
                                public CommonUpstreamTransportSocketFactory {
 public:
+  explicit RawBufferSocketFactory(uint32_t zero_copy_send_threshold = 0)
+      : zero_copy_send_threshold_(zero_copy_send_threshold) {}
+
   // Network::UpstreamTransportSocketFactory
   TransportSocketPtr createTransportSocket(TransportSocketOptionsConstSharedPtr,
                                            Upstream::HostDescriptionConstSharedPtr) const override;
@@ -43,6 +83,9 @@ public:
   absl::string_view defaultServerNameIndication() const override { return ""; }
   // Network::DownstreamTransportSocketFactory
   TransportSocketPtr createDownstreamTransportSocket() const override;
+
+private:
+  const uint32_t zero_copy_send_threshold_;
 };
 
 } // namespace Network
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "envoy/common/io/io_uring.h"
 #include "envoy/network/socket.h"
 
 #include "source/common/network/socket_interface.h"
@@ -32,6 +33,10 @@ public:
 protected:
   virtual IoHandlePtr makeSocket(int socket_fd, bool socket_v6only,
                                  absl::optional<int> domain) const;
+
+private:
+  // Set when io_uring is configured and supported, owned by the bootstrap extension.
+  std::weak_ptr<Io::IoUringWorkerFactory> io_uring_worker_factory_;
 };
 
 DECLARE_FACTORY(SocketInterfaceImpl);
@@ -81,6 +81,19 @@ public:
     }
     return io_handle_.recv(buffer, length, flags);
   }
+  Api::IoCallUint64Result send(const Buffer::RawSlice* slices, uint64_t num_slice,
+                               int flags) override {
+    if (closed_) {
+      return {0, Network::IoSocketError::getIoSocketEbadfError()};
+    }
+    return io_handle_.send(slices, num_slice, flags);
+  }
+  Api::IoCallUint64Result recvZeroCopyCompletion(ZeroCopyCompletion& completion) override {
+    if (closed_) {
+      return {0, Network::IoSocketError::getIoSocketEbadfError()};
+    }
+    return io_handle_.recvZeroCopyCompletion(completion);
+  }
   bool supportsMmsg() const override { return io_handle_.supportsMmsg(); }
   bool supportsUdpGro() const override { return io_handle_.supportsUdpGro(); }
   Api::SysCallIntResult bind(Network::Address::InstanceConstSharedPtr address) override {
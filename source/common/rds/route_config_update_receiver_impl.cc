@@ -15,8 +15,9 @@ RouteConfigUpdateReceiverImpl::RouteConfigUpdateReceiverImpl(
 
 void RouteConfigUpdateReceiverImpl::updateConfig(
     std::unique_ptr<Protobuf::Message>&& route_config_proto) {
-  config_ = config_traits_.createConfig(*route_config_proto, factory_context_,
-                                        false /* not validate unknown cluster */);
+  config_ = config_traits_.createConfigFromPrevious(*route_config_proto, factory_context_,
+                                                    false /* not validate unknown cluster */,
+                                                    config_);
   // If the above create config doesn't raise exception, update the
   // other cached config entries.
   route_config_proto_ = std::move(route_config_proto);
@@ -51,6 +51,8 @@
 #include "source/extensions/path/match/uri_template/uri_template_match.h"
 #include "source/extensions/path/rewrite/uri_template/uri_template_rewrite.h"
 
+#include "absl/container/flat_hash_set.h"
+#include "absl/strings/ascii.h"
 #include "absl/strings/match.h"
 
 namespace Envoy {
@@ -1773,15 +1775,194 @@ const Envoy::Config::TypedMetadata& CommonVirtualHostImpl::typedMetadata() const
                               : DefaultRouteMetadataPack::get().typed_metadata_;
 }
 
+namespace {
+
+// The value of a header matcher which only matches requests with exactly this value of the header.
+absl::optional<absl::string_view>
+exactHeaderValue(const envoy::config::route::v3::HeaderMatcher& header_matcher) {
+  if (header_matcher.invert_match() || header_matcher.treat_missing_header_as_empty()) {
+    return absl::nullopt;
+  }
+  // An empty exact value matches every value of the header.
+  if (header_matcher.header_match_specifier_case() ==
+          envoy::config::route::v3::HeaderMatcher::kExactMatch &&
+      !header_matcher.exact_match().empty()) {
+    return header_matcher.exact_match();
+  }
+  if (header_matcher.header_match_specifier_case() ==
+          envoy::config::route::v3::HeaderMatcher::kStringMatch &&
+      header_matcher.string_match().match_pattern_case() ==
+          envoy::type::matcher::v3::StringMatcher::kExact &&
+      !header_matcher.string_match().ignore_case() &&
+      !header_matcher.string_match().exact().empty()) {
+    return header_matcher.string_match().exact();
+  }
+  return absl::nullopt;
+}
+
+bool hasCaseSensitivePath(const envoy::config::route::v3::RouteMatch& match) {
+  if (!PROTOBUF_GET_WRAPPED_OR_DEFAULT(match, case_sensitive, true)) {
+    return false;
+  }
+  // The "/" and empty prefixes match every path, indexing them would not narrow anything down.
+  return (match.path_specifier_case() == envoy::config::route::v3::RouteMatch::kPath) ||
+         (match.path_specifier_case() == envoy::config::route::v3::RouteMatch::kPrefix &&
+          match.prefix().size() > 1);
+}
+
+// Hash of the message without one of its repeated fields. Only the other fields are copied to
+// hash them, the virtual hosts or routes in the excluded field can be large.
+size_t hashWithoutField(const Protobuf::Message& message, absl::string_view excluded_field) {
+  std::vector<const Protobuf::FieldDescriptor*> fields;
+  message.GetReflection()->ListFields(message, &fields);
+  ProtobufWkt::FieldMask mask;
+  for (const Protobuf::FieldDescriptor* field : fields) {
+    if (field->name() != excluded_field) {
+      mask.add_paths(std::string(field->name()));
+    }
+  }
+  std::unique_ptr<Protobuf::Message> common(message.New());
+  ProtobufUtil::FieldMaskUtil::MergeMessageTo(message, mask,
+                                              ProtobufUtil::FieldMaskUtil::MergeOptions(),
+                                              common.get());
+  return MessageUtil::hash(*common);
+}
+
+} // namespace
+
+std::unique_ptr<const RouteIndex>
+RouteIndex::create(const Protobuf::RepeatedPtrField<envoy::config::route::v3::Route>& routes,
+                   bool ignore_path_parameters) {
+  // Pick the header with the most routes matching an exact value of it.
+  absl::flat_hash_map<std::string, uint32_t> exact_header_routes;
+  uint32_t path_routes = 0;
+  for (const auto& route : routes) {
+    absl::flat_hash_set<std::string> route_headers;
+    for (const auto& header_matcher : route.match().headers()) {
+      if (exactHeaderValue(header_matcher).has_value()) {
+        route_headers.insert(absl::AsciiStrToLower(header_matcher.name()));
+      }
+    }
+    for (const std::string& name : route_headers) {
+      exact_header_routes[name]++;
+    }
+    path_routes += hasCaseSensitivePath(route.match());
+  }
+  auto header = std::max_element(
+      exact_header_routes.begin(), exact_header_routes.end(),
+      [](const auto& lhs, const auto& rhs) { return lhs.second < rhs.second; });
+  const uint32_t header_routes = header != exact_header_routes.end() ? header->second : 0;
+  if (std::max(header_routes, path_routes) < MinIndexedRoutes) {
+    return nullptr;
+  }
+
+  std::unique_ptr<RouteIndex> index(new RouteIndex(ignore_path_parameters));
+  if (header_routes >= path_routes) {
+    index->header_.emplace(header->first);
+  }
+  for (int i = 0; i < routes.size(); i++) {
+    const auto& match = routes[i].match();
+    if (index->header_.has_value()) {
+      // A route with several exact matchers for the header can only match if they are the same.
+      absl::optional<absl::string_view> value;
+      for (const auto& header_matcher : match.headers()) {
+        if (Http::LowerCaseString(header_matcher.name()) == index->header_.value()) {
+          value = exactHeaderValue(header_matcher);
+          if (value.has_value()) {
+            break;
+          }
+        }
+      }
+      if (value.has_value()) {
+        index->routes_by_header_value_[std::string(value.value())].push_back(i);
+      } else {
+        index->unindexed_routes_.push_back(i);
+      }
+    } else if (!hasCaseSensitivePath(match)) {
+      index->unindexed_routes_.push_back(i);
+    } else if (match.path_specifier_case() == envoy::config::route::v3::RouteMatch::kPath) {
+      index->routes_by_path_[match.path()].push_back(i);
+    } else {
+      index->routes_by_prefix_[match.prefix()].push_back(i);
+    }
+  }
+  for (const auto& [prefix, prefix_routes] : index->routes_by_prefix_) {
+    index->prefix_lengths_.push_back(prefix.size());
+  }
+  std::sort(index->prefix_lengths_.begin(), index->prefix_lengths_.end());
+  index->prefix_lengths_.erase(
+      std::unique(index->prefix_lengths_.begin(), index->prefix_lengths_.end()),
+      index->prefix_lengths_.end());
+  return index;
+}
+
+void RouteIndex::addCandidates(const RoutesByKey& routes_by_key, absl::string_view key,
+                               Candidates& candidates) const {
+  auto routes = routes_by_key.find(key);
+  if (routes != routes_by_key.end()) {
+    candidates.insert(candidates.end(), routes->second.begin(), routes->second.end());
+  }
+}
+
+void RouteIndex::candidates(const Http::RequestHeaderMap& headers, Candidates& candidates) const {
+  candidates.assign(unindexed_routes_.begin(), unindexed_routes_.end());
+  const size_t unindexed = candidates.size();
+  if (header_.has_value()) {
+    // Same value as the one the header matchers of the routes compare with.
+    const auto value = Http::HeaderUtility::getAllOfHeaderAsString(headers, header_.value());
+    if (value.result().has_value()) {
+      addCandidates(routes_by_header_value_, value.result().value(), candidates);
+    }
+  } else if (headers.Path() != nullptr) {
+    // Routes with a path matcher never match requests without a path. Like their path matchers,
+    // compare with the path without the query, and optionally the path parameters.
+    absl::string_view path = Http::PathUtil::removeQueryAndFragment(headers.getPathValue());
+    if (ignore_path_parameters_) {
+      path = path.substr(0, path.find(';'));
+    }
+    addCandidates(routes_by_path_, path, candidates);
+    for (const size_t length : prefix_lengths_) {
+      if (length > path.size()) {
+        break;
+      }
+      addCandidates(routes_by_prefix_, path.substr(0, length), candidates);
+    }
+  }
+  if (candidates.size() > unindexed) {
+    std::sort(candidates.begin(), candidates.end());
+  }
+}
+
+VirtualHostImpl::ConfigHashes
+VirtualHostImpl::hashConfig(const envoy::config::route::v3::VirtualHost& virtual_host) {
+  ConfigHashes hashes;
+  hashes.common_ = hashWithoutField(virtual_host, "routes");
+  hashes.routes_.reserve(virtual_host.routes().size());
+  for (const auto& route : virtual_host.routes()) {
+    hashes.routes_.push_back(MessageUtil::hash(route));
+  }
+  return hashes;
+}
+
 VirtualHostImpl::VirtualHostImpl(
     const envoy::config::route::v3::VirtualHost& virtual_host,
     const CommonConfigSharedPtr& global_route_config,
     Server::Configuration::ServerFactoryContext& factory_context, Stats::Scope& scope,
     ProtobufMessage::ValidationVisitor& validator,
-    const absl::optional<Upstream::ClusterManager::ClusterInfoMaps>& validation_clusters) {
-
-  shared_virtual_host_ = std::make_shared<CommonVirtualHostImpl>(virtual_host, global_route_config,
-                                                                 factory_context, scope, validator);
+    const absl::optional<Upstream::ClusterManager::ClusterInfoMaps>& validation_clusters,
+    ConfigHashes&& config_hashes, const VirtualHostImpl* previous_virtual_host,
+    ConfigBuildInfo& build_info)
+    : config_hashes_(std::move(config_hashes)) {
+  // The routes keep the common part of the virtual host they were built with, so they can only be
+  // reused together with it.
+  if (previous_virtual_host != nullptr &&
+      previous_virtual_host->config_hashes_.common_ == config_hashes_.common_) {
+    shared_virtual_host_ = previous_virtual_host->shared_virtual_host_;
+  } else {
+    previous_virtual_host = nullptr;
+    shared_virtual_host_ = std::make_shared<CommonVirtualHostImpl>(
+        virtual_host, global_route_config, factory_context, scope, validator);
+  }
 
   switch (virtual_host.require_tls()) {
     PANIC_ON_PROTO_ENUM_SENTINEL_VALUES;
@@ -1796,7 +1977,10 @@ VirtualHostImpl::VirtualHostImpl(
     break;
   }
 
-  if (virtual_host.has_matcher()) {
+  if (virtual_host.has_matcher() && previous_virtual_host != nullptr) {
+    // The match tree is part of the common config.
+    matcher_ = previous_virtual_host->matcher_;
+  } else if (virtual_host.has_matcher()) {
     RouteActionContext context{shared_virtual_host_, factory_context};
     RouteActionValidationVisitor validation_visitor;
     Matcher::MatchTreeFactory<Http::HttpMatchingData, RouteActionContext> factory(
@@ -1811,10 +1995,29 @@ VirtualHostImpl::VirtualHostImpl(
                       validation_visitor.errors()[0]));
     }
   } else {
-    for (const auto& route : virtual_host.routes()) {
-      routes_.emplace_back(createAndValidateRoute(route, shared_virtual_host_, factory_context,
-                                                  validator, validation_clusters));
+    absl::flat_hash_map<size_t, RouteEntryImplBaseConstSharedPtr> previous_routes;
+    if (previous_virtual_host != nullptr) {
+      for (size_t i = 0; i < previous_virtual_host->routes_.size(); i++) {
+        previous_routes.emplace(previous_virtual_host->config_hashes_.routes_[i],
+                                previous_virtual_host->routes_[i]);
+      }
+    }
+    routes_.reserve(virtual_host.routes().size());
+    for (int i = 0; i < virtual_host.routes().size(); i++) {
+      auto previous_route = previous_routes.find(config_hashes_.routes_[i]);
+      if (previous_route != previous_routes.end()) {
+        routes_.push_back(previous_route->second);
+        build_info.routes_reused_++;
+        continue;
+      }
+      routes_.emplace_back(createAndValidateRoute(virtual_host.routes()[i], shared_virtual_host_,
+                                                  factory_context, validator,
+                                                  validation_clusters));
+      build_info.routes_built_++;
     }
+    route_index_ = RouteIndex::create(
+        virtual_host.routes(),
+        shared_virtual_host_->globalRouteConfig().ignorePathParametersInPathMatching());
   }
 }
 
@@ -1825,12 +2028,23 @@ RouteConstSharedPtr VirtualHostImpl::getRouteFromRoutes(
     const RouteCallback& cb, const Http::RequestHeaderMap& headers,
     const StreamInfo::StreamInfo& stream_info, uint64_t random_value,
     absl::Span<const RouteEntryImplBaseConstSharedPtr> routes) const {
-  for (auto route = routes.begin(); route != routes.end(); ++route) {
-    if (!headers.Path() && !(*route)->supportsPathlessHeaders()) {
+  return getRouteFromList(cb, headers, stream_info, random_value, routes.size(),
+                          [routes](size_t i) -> const RouteEntryImplBase& { return *routes[i]; });
+}
+
+template <class RouteAt>
+RouteConstSharedPtr VirtualHostImpl::getRouteFromList(const RouteCallback& cb,
+                                                      const Http::RequestHeaderMap& headers,
+                                                      const StreamInfo::StreamInfo& stream_info,
+                                                      uint64_t random_value, size_t size,
+                                                      RouteAt route_at) const {
+  for (size_t i = 0; i < size; i++) {
+    const RouteEntryImplBase& route = route_at(i);
+    if (!headers.Path() && !route.supportsPathlessHeaders()) {
       continue;
     }
 
-    RouteConstSharedPtr route_entry = (*route)->matches(headers, stream_info, random_value);
+    RouteConstSharedPtr route_entry = route.matches(headers, stream_info, random_value);
     if (route_entry == nullptr) {
       continue;
     }
@@ -1839,9 +2053,8 @@ RouteConstSharedPtr VirtualHostImpl::getRouteFromRoutes(
       return route_entry;
     }
 
-    RouteEvalStatus eval_status = (std::next(route) == routes.end())
-                                      ? RouteEvalStatus::NoMoreRoutes
-                                      : RouteEvalStatus::HasMoreRoutes;
+    RouteEvalStatus eval_status =
+        (i + 1 == size) ? RouteEvalStatus::NoMoreRoutes : RouteEvalStatus::HasMoreRoutes;
     RouteMatchStatus match_status = cb(route_entry, eval_status);
     if (match_status == RouteMatchStatus::Accept) {
       return route_entry;
@@ -1907,6 +2120,14 @@ RouteConstSharedPtr VirtualHostImpl::getRouteFromEntries(const RouteCallback& cb
   }
 
   // Check for a route that matches the request.
+  if (route_index_ != nullptr) {
+    RouteIndex::Candidates candidates;
+    route_index_->candidates(headers, candidates);
+    return getRouteFromList(cb, headers, stream_info, random_value, candidates.size(),
+                            [this, &candidates](size_t i) -> const RouteEntryImplBase& {
+                              return *routes_[candidates[i]];
+                            });
+  }
   return getRouteFromRoutes(cb, headers, stream_info, random_value, routes_);
 }
 
@@ -1935,7 +2156,9 @@ const VirtualHostImpl* RouteMatcher::findWildcardVirtualHost(
 RouteMatcher::RouteMatcher(const envoy::config::route::v3::RouteConfiguration& route_config,
                            const CommonConfigSharedPtr& global_route_config,
                            Server::Configuration::ServerFactoryContext& factory_context,
-                           ProtobufMessage::ValidationVisitor& validator, bool validate_clusters)
+                           ProtobufMessage::ValidationVisitor& validator, bool validate_clusters,
+                           bool hash_config, const RouteMatcher* previous_route_matcher,
+                           ConfigBuildInfo& build_info)
     : vhost_scope_(factory_context.scope().scopeFromStatName(
           factory_context.routerContext().virtualClusterStatNames().vhost_)),
       ignore_port_in_host_matching_(route_config.ignore_port_in_host_matching()) {
@@ -1944,9 +2167,30 @@ RouteMatcher::RouteMatcher(const envoy::config::route::v3::RouteConfiguration& r
     validation_clusters = factory_context.clusterManager().clusters();
   }
   for (const auto& virtual_host_config : route_config.virtual_hosts()) {
-    VirtualHostSharedPtr virtual_host =
-        std::make_shared<VirtualHostImpl>(virtual_host_config, global_route_config, factory_context,
-                                          *vhost_scope_, validator, validation_clusters);
+    VirtualHostImpl::ConfigHashes config_hashes;
+    if (hash_config) {
+      config_hashes = VirtualHostImpl::hashConfig(virtual_host_config);
+    }
+    VirtualHostSharedPtr previous_virtual_host;
+    if (previous_route_matcher != nullptr) {
+      auto previous = previous_route_matcher->virtual_hosts_by_name_.find(virtual_host_config.name());
+      if (previous != previous_route_matcher->virtual_hosts_by_name_.end()) {
+        previous_virtual_host = previous->second;
+      }
+    }
+    VirtualHostSharedPtr virtual_host;
+    if (previous_virtual_host != nullptr &&
+        previous_virtual_host->configHashes() == config_hashes) {
+      virtual_host = previous_virtual_host;
+      build_info.virtual_hosts_reused_++;
+      build_info.routes_reused_ += virtual_host_config.routes().size();
+    } else {
+      virtual_host = std::make_shared<VirtualHostImpl>(
+          virtual_host_config, global_route_config, factory_context, *vhost_scope_, validator,
+          validation_clusters, std::move(config_hashes), previous_virtual_host.get(), build_info);
+      build_info.virtual_hosts_built_++;
+    }
+    virtual_hosts_by_name_.emplace(virtual_host_config.name(), virtual_host);
     for (const std::string& domain_name : virtual_host_config.domains()) {
       const Http::LowerCaseString lower_case_domain_name(domain_name);
       absl::string_view domain = lower_case_domain_name;
@@ -2123,13 +2367,49 @@ const Envoy::Config::TypedMetadata& CommonConfigImpl::typedMetadata() const {
 ConfigImpl::ConfigImpl(const envoy::config::route::v3::RouteConfiguration& config,
                        Server::Configuration::ServerFactoryContext& factory_context,
                        ProtobufMessage::ValidationVisitor& validator,
-                       bool validate_clusters_default) {
+                       bool validate_clusters_default, const ConfigImpl* previous_config,
+                       bool reusable) {
+  const MonotonicTime start_time = factory_context.timeSource().monotonicTime();
+  const bool validate_clusters =
+      PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, validate_clusters, validate_clusters_default);
+  // Configs which are never compared with another version, e.g. static route configurations, are
+  // not hashed.
+  const bool hash_config = reusable || previous_config != nullptr;
+  if (hash_config) {
+    common_config_hash_ = hashWithoutField(config, "virtual_hosts");
+  }
+
+  // The virtual hosts keep the common part of the configuration they were built with, so they
+  // can only be reused together with it. Reused parts are not validated against the clusters.
+  const RouteMatcher* previous_route_matcher = nullptr;
+  if (previous_config != nullptr && !validate_clusters &&
+      previous_config->common_config_hash_.has_value() &&
+      previous_config->common_config_hash_ == common_config_hash_) {
+    shared_config_ = previous_config->shared_config_;
+    previous_route_matcher = previous_config->route_matcher_.get();
+  } else {
+    shared_config_ = std::make_shared<CommonConfigImpl>(config, factory_context, validator);
+  }
 
-  shared_config_ = std::make_shared<CommonConfigImpl>(config, factory_context, validator);
+  route_matcher_ =
+      std::make_unique<RouteMatcher>(config, shared_config_, factory_context, validator,
+                                     validate_clusters, hash_config, previous_route_matcher,
+                                     build_info_);
+  build_info_.build_time_ = std::chrono::duration_cast<std::chrono::milliseconds>(
+      factory_context.timeSource().monotonicTime() - start_time);
+}
 
-  route_matcher_ = std::make_unique<RouteMatcher>(
-      config, shared_config_, factory_context, validator,
-      PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, validate_clusters, validate_clusters_default));
+void RouteConfigBuildStats::record(const Rds::ConfigConstSharedPtr& config) {
+  const auto* config_impl = dynamic_cast<const ConfigImpl*>(config.get());
+  if (config_impl == nullptr) {
+    return;
+  }
+  const ConfigBuildInfo& build_info = config_impl->buildInfo();
+  routes_built_.add(build_info.routes_built_);
+  routes_reused_.add(build_info.routes_reused_);
+  virtual_hosts_built_.add(build_info.virtual_hosts_built_);
+  virtual_hosts_reused_.add(build_info.virtual_hosts_reused_);
+  config_build_time_.recordValue(build_info.build_time_.count());
 }
 
 RouteConstSharedPtr ConfigImpl::route(const RouteCallback& cb,
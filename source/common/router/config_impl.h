@@ -19,6 +19,7 @@
 #include "envoy/router/router.h"
 #include "envoy/runtime/runtime.h"
 #include "envoy/server/filter_config.h"
+#include "envoy/stats/stats_macros.h"
 #include "envoy/type/v3/percent.pb.h"
 #include "envoy/upstream/cluster_manager.h"
 
@@ -35,6 +36,8 @@
 #include "source/common/router/tls_context_match_criteria_impl.h"
 #include "source/common/stats/symbol_table.h"
 
+#include "absl/container/flat_hash_map.h"
+#include "absl/container/inlined_vector.h"
 #include "absl/container/node_hash_map.h"
 #include "absl/types/optional.h"
 
@@ -355,17 +358,96 @@ private:
 
 using CommonVirtualHostSharedPtr = std::shared_ptr<CommonVirtualHostImpl>;
 
+/**
+ * Index over the routes of a virtual host without a matcher tree, which narrows them down to the
+ * ones that can match a request. Routes are indexed either on the header that the most of them
+ * match with a case sensitive exact value, or on their case sensitive exact path or prefix,
+ * whichever covers more routes. Routes without such a match are candidates for every request.
+ */
+class RouteIndex {
+public:
+  // Candidates in the order of the route list, so that the first match is the same as with a
+  // linear scan.
+  using Candidates = absl::InlinedVector<uint32_t, 16>;
+
+  /**
+   * @return the index of the routes, or nullptr if too few of them can be indexed.
+   */
+  static std::unique_ptr<const RouteIndex>
+  create(const Protobuf::RepeatedPtrField<envoy::config::route::v3::Route>& routes,
+         bool ignore_path_parameters);
+
+  /**
+   * Fill candidates with the positions in the route list of the routes that can match the request.
+   */
+  void candidates(const Http::RequestHeaderMap& headers, Candidates& candidates) const;
+
+  // Minimum number of indexable routes for an index to be built.
+  static constexpr uint32_t MinIndexedRoutes = 16;
+
+private:
+  using RoutesByKey = absl::flat_hash_map<std::string, std::vector<uint32_t>>;
+
+  explicit RouteIndex(bool ignore_path_parameters) : ignore_path_parameters_(ignore_path_parameters) {}
+
+  void addCandidates(const RoutesByKey& routes_by_key, absl::string_view key,
+                     Candidates& candidates) const;
+
+  absl::optional<Http::LowerCaseString> header_;
+  RoutesByKey routes_by_header_value_;
+  RoutesByKey routes_by_path_;
+  RoutesByKey routes_by_prefix_;
+  // Distinct lengths of the keys of routes_by_prefix_, ascending.
+  std::vector<size_t> prefix_lengths_;
+  std::vector<uint32_t> unindexed_routes_;
+  const bool ignore_path_parameters_;
+};
+
+/**
+ * Number of the virtual hosts and routes of a route configuration that were built for it, and of
+ * the ones reused from the previous version of the configuration.
+ */
+struct ConfigBuildInfo {
+  uint32_t virtual_hosts_built_{};
+  uint32_t virtual_hosts_reused_{};
+  uint32_t routes_built_{};
+  uint32_t routes_reused_{};
+  std::chrono::milliseconds build_time_{};
+};
+
 /**
  * Virtual host that holds a collection of routes.
  */
 class VirtualHostImpl : Logger::Loggable<Logger::Id::router> {
 public:
+  // Hashes of the config of a virtual host without its routes, and of each of its routes. Empty if
+  // the virtual host is not hashed.
+  struct ConfigHashes {
+    size_t common_{};
+    std::vector<size_t> routes_;
+
+    bool operator==(const ConfigHashes& other) const {
+      return common_ == other.common_ && routes_ == other.routes_;
+    }
+  };
+
+  static ConfigHashes hashConfig(const envoy::config::route::v3::VirtualHost& virtual_host);
+
+  /**
+   * @param previous_virtual_host if not nullptr, the virtual host of the same name in the previous
+   *        version of the route configuration. If only the routes of the virtual host changed, its
+   *        common part and its unchanged routes are reused.
+   */
   VirtualHostImpl(
       const envoy::config::route::v3::VirtualHost& virtual_host,
       const CommonConfigSharedPtr& global_route_config,
       Server::Configuration::ServerFactoryContext& factory_context, Stats::Scope& scope,
       ProtobufMessage::ValidationVisitor& validator,
-      const absl::optional<Upstream::ClusterManager::ClusterInfoMaps>& validation_clusters);
+      const absl::optional<Upstream::ClusterManager::ClusterInfoMaps>& validation_clusters,
+      ConfigHashes&& config_hashes, const VirtualHostImpl* previous_virtual_host,
+      ConfigBuildInfo& build_info);
+
+  const ConfigHashes& configHashes() const { return config_hashes_; }
 
   RouteConstSharedPtr getRouteFromEntries(const RouteCallback& cb,
                                           const Http::RequestHeaderMap& headers,
@@ -380,6 +462,12 @@ public:
 private:
   enum class SslRequirements : uint8_t { None, ExternalOnly, All };
 
+  template <class RouteAt>
+  RouteConstSharedPtr getRouteFromList(const RouteCallback& cb,
+                                       const Http::RequestHeaderMap& headers,
+                                       const StreamInfo::StreamInfo& stream_info,
+                                       uint64_t random_value, size_t size, RouteAt route_at) const;
+
   static const std::shared_ptr<const SslRedirectRoute> SSL_REDIRECT_ROUTE;
 
   CommonVirtualHostSharedPtr shared_virtual_host_;
@@ -387,7 +475,9 @@ private:
   SslRequirements ssl_requirements_;
 
   std::vector<RouteEntryImplBaseConstSharedPtr> routes_;
+  std::unique_ptr<const RouteIndex> route_index_;
   Matcher::MatchTreeSharedPtr<Http::HttpMatchingData> matcher_;
+  const ConfigHashes config_hashes_;
 };
 
 using VirtualHostSharedPtr = std::shared_ptr<VirtualHostImpl>;
@@ -1477,10 +1567,18 @@ DECLARE_FACTORY(RouteListMatchActionFactory);
  */
 class RouteMatcher {
 public:
+  /**
+   * @param hash_config whether to hash the virtual hosts, so that they can be reused.
+   * @param previous_route_matcher if not nullptr, the matcher of the previous version of the route
+   *        configuration. Its virtual hosts, and their parts, are reused where their configuration
+   *        did not change. Requires hash_config.
+   */
   RouteMatcher(const envoy::config::route::v3::RouteConfiguration& config,
                const CommonConfigSharedPtr& global_route_config,
                Server::Configuration::ServerFactoryContext& factory_context,
-               ProtobufMessage::ValidationVisitor& validator, bool validate_clusters);
+               ProtobufMessage::ValidationVisitor& validator, bool validate_clusters,
+               bool hash_config, const RouteMatcher* previous_route_matcher,
+               ConfigBuildInfo& build_info);
 
   RouteConstSharedPtr route(const RouteCallback& cb, const Http::RequestHeaderMap& headers,
                             const StreamInfo::StreamInfo& stream_info, uint64_t random_value) const;
@@ -1497,6 +1595,8 @@ private:
   bool ignorePortInHostMatching() const { return ignore_port_in_host_matching_; }
 
   Stats::ScopeSharedPtr vhost_scope_;
+  // By the name of the virtual host, for the next version of the route configuration to reuse.
+  absl::flat_hash_map<std::string, VirtualHostSharedPtr> virtual_hosts_by_name_;
   absl::node_hash_map<std::string, VirtualHostSharedPtr> virtual_hosts_;
   // std::greater as a minor optimization to iterate from more to less specific
   //
@@ -1586,9 +1686,20 @@ private:
  */
 class ConfigImpl : public Config {
 public:
+  /**
+   * @param previous_config if not nullptr, the previous version of the route configuration. If
+   *        the configuration outside of the virtual hosts did not change, and clusters are not
+   *        validated, the virtual hosts and routes whose configuration did not change are reused
+   *        instead of being built again.
+   * @param reusable whether this config can be passed as previous_config of the next version.
+   *        The configuration is only hashed for reusable configs or with a previous_config.
+   */
   ConfigImpl(const envoy::config::route::v3::RouteConfiguration& config,
              Server::Configuration::ServerFactoryContext& factory_context,
-             ProtobufMessage::ValidationVisitor& validator, bool validate_clusters_default);
+             ProtobufMessage::ValidationVisitor& validator, bool validate_clusters_default,
+             const ConfigImpl* previous_config = nullptr, bool reusable = false);
+
+  const ConfigBuildInfo& buildInfo() const { return build_info_; }
 
   bool virtualHostExists(const Http::RequestHeaderMap& headers) const {
     return route_matcher_->findVirtualHost(headers) != nullptr;
@@ -1630,6 +1741,33 @@ public:
 private:
   CommonConfigSharedPtr shared_config_;
   std::unique_ptr<RouteMatcher> route_matcher_;
+  // Hash of the configuration without the virtual hosts, if it was hashed.
+  absl::optional<size_t> common_config_hash_;
+  ConfigBuildInfo build_info_;
+};
+
+/**
+ * All stats of the builds of route configurations received through xDS. @see stats_macros.h
+ */
+#define ALL_ROUTE_CONFIG_BUILD_STATS(COUNTER, HISTOGRAM)                                           \
+  COUNTER(routes_built)                                                                            \
+  COUNTER(routes_reused)                                                                           \
+  COUNTER(virtual_hosts_built)                                                                     \
+  COUNTER(virtual_hosts_reused)                                                                    \
+  HISTOGRAM(config_build_time, Milliseconds)
+
+/**
+ * Struct definition for all route configuration build stats. @see stats_macros.h
+ */
+struct RouteConfigBuildStats {
+  ALL_ROUTE_CONFIG_BUILD_STATS(GENERATE_COUNTER_STRUCT, GENERATE_HISTOGRAM_STRUCT)
+
+  static RouteConfigBuildStats generateStats(Stats::Scope& scope) {
+    return {ALL_ROUTE_CONFIG_BUILD_STATS(POOL_COUNTER(scope), POOL_HISTOGRAM(scope))};
+  }
+
+  // Add the build of the config, if it is a ConfigImpl.
+  void record(const Rds::ConfigConstSharedPtr& config);
 };
 
 /**
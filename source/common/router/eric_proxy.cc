@@ -64,11 +64,11 @@ void Filter::saveDiscoveryHeadersToBePreserved(
 
     for (auto& disc_param : disc_params_to_preserved.values()) {
       // prefix the disc-param with "3gpp-Sbi-Discovery-"
-      const auto& disc_param_header = absl::StrCat("3gpp-Sbi-Discovery-", disc_param.string_value());
-      if (!downstream_headers_->get(Http::LowerCaseString(disc_param_header)).empty()) {
-        auto header_to_be_preserved =
-            downstream_headers_->get(Http::LowerCaseString(disc_param_header));
-        preserved_disc_headers_->addCopy(Http::LowerCaseString(disc_param_header),
+      const Http::LowerCaseString disc_param_header(
+          absl::StrCat(SbiHeaders::get().DiscoveryPrefix, disc_param.string_value()));
+      const auto header_to_be_preserved = downstream_headers_->get(disc_param_header);
+      if (!header_to_be_preserved.empty()) {
+        preserved_disc_headers_->addCopy(disc_param_header,
                                          header_to_be_preserved[0]->value().getStringView());
         ENVOY_STREAM_LOG(trace, "stored disc_param_header ='{}' from dyn.MD", *callbacks_,
                          disc_param_header);
@@ -76,10 +76,10 @@ void Filter::saveDiscoveryHeadersToBePreserved(
     }
     ENVOY_STREAM_LOG(trace, "removing disc headers not to be preserved", *callbacks_);
     downstream_headers_->removeIf([&](const Http::HeaderEntry& header) -> bool {
-      auto header_name = Http::LowerCaseString(header.key().getStringView());
       if (!isDiscoveryHeader(header)) {
         return false;
       }
+      const Http::LowerCaseString header_name(header.key().getStringView());
       if (preserved_disc_headers_->get(header_name).empty()) {
         ENVOY_STREAM_LOG(trace, "removing disc header '{}'", *callbacks_, header_name);
         return true;
@@ -135,8 +135,7 @@ void Filter::removeAllDiscoveryHeaders() {
 }
 
 bool Filter::isDiscoveryHeader(const Http::HeaderEntry& header) {
-  return absl::StartsWith(Http::LowerCaseString(header.key().getStringView()),
-                          Http::LowerCaseString("3gpp-Sbi-Discovery-"));
+  return SbiCustomHeaders::isDiscoveryHeader(header);
 }
 
 } // namespace Router
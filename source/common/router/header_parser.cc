@@ -13,6 +13,7 @@
 #include "source/common/http/headers.h"
 #include "source/common/json/json_loader.h"
 #include "source/common/protobuf/utility.h"
+#include "source/common/runtime/runtime_features.h"
 
 #include "absl/strings/str_cat.h"
 #include "absl/strings/str_replace.h"
@@ -184,14 +185,32 @@ void HeaderParser::evaluateHeaders(Http::HeaderMap& headers,
     }
   }
 
-  // First overwrite all headers which need to be overwritten.
-  for (const auto& header : headers_to_overwrite) {
-    headers.setReferenceKey(header.first, header.second);
+  if (!Runtime::runtimeFeatureEnabled("envoy.reloadable_features.header_parser_replace_in_place")) {
+    // First overwrite all headers which need to be overwritten. This moves them to the end.
+    for (const auto& header : headers_to_overwrite) {
+      headers.setReferenceKey(header.first, header.second);
+    }
+
+    // Now add headers which should be added.
+    for (const auto& header : headers_to_add) {
+      headers.addReferenceKey(header.first, header.second);
+    }
+    return;
   }
 
-  // Now add headers which should be added.
+  // First overwrite all headers which need to be overwritten, then add headers which should be
+  // added. Both are applied as one batch. Overwriting a header which exists once only replaces its
+  // value and keeps its position, other overwritten headers move to the end.
+  absl::InlinedVector<Http::HeaderMutation, 4> mutations;
+  mutations.reserve(headers_to_overwrite.size() + headers_to_add.size());
+  for (const auto& header : headers_to_overwrite) {
+    mutations.push_back({Http::HeaderMutation::Type::Set, header.first, header.second, true});
+  }
   for (const auto& header : headers_to_add) {
-    headers.addReferenceKey(header.first, header.second);
+    mutations.push_back({Http::HeaderMutation::Type::Add, header.first, header.second, true});
+  }
+  if (!mutations.empty()) {
+    headers.applyMutations(mutations);
   }
 }
 
@@ -78,7 +78,8 @@ RdsRouteConfigSubscription::RdsRouteConfigSubscription(
                                       manager_identifier, factory_context, stat_prefix + "rds.",
                                       "RDS", route_config_provider_manager),
       config_update_info_(static_cast<RouteConfigUpdateReceiver*>(
-          Rds::RdsRouteConfigSubscription::config_update_info_.get())) {}
+          Rds::RdsRouteConfigSubscription::config_update_info_.get())),
+      build_stats_(RouteConfigBuildStats::generateStats(*scope_)) {}
 
 RdsRouteConfigSubscription::~RdsRouteConfigSubscription() { config_update_info_.release(); }
 
@@ -100,6 +101,8 @@ void RdsRouteConfigSubscription::beforeProviderUpdate(
 }
 
 void RdsRouteConfigSubscription::afterProviderUpdate() {
+  build_stats_.record(config_update_info_->parsedConfiguration());
+
   // RDS update removed VHDS configuration
   if (!config_update_info_->protobufConfigurationCast().has_vhds()) {
     vhds_subscription_.release();
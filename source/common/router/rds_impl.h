@@ -37,6 +37,7 @@
 #include "source/common/rds/route_config_provider_manager.h"
 #include "source/common/rds/route_config_update_receiver_impl.h"
 #include "source/common/rds/static_route_config_provider_impl.h"
+#include "source/common/router/config_impl.h"
 #include "source/common/router/vhds.h"
 
 #include "absl/container/node_hash_map.h"
@@ -123,6 +124,7 @@ private:
 
   VhdsSubscriptionPtr vhds_subscription_;
   RouteConfigUpdatePtr config_update_info_;
+  RouteConfigBuildStats build_stats_;
   Common::CallbackManager<> update_callback_manager_;
 
   // Access to addUpdateCallback
@@ -49,6 +49,18 @@ ConfigTraitsImpl::createConfig(const Protobuf::Message& rc,
       validator_, validate_clusters_default);
 }
 
+Rds::ConfigConstSharedPtr ConfigTraitsImpl::createConfigFromPrevious(
+    const Protobuf::Message& rc, Server::Configuration::ServerFactoryContext& factory_context,
+    bool validate_clusters_default, const Rds::ConfigConstSharedPtr& previous_config) const {
+  ASSERT(dynamic_cast<const envoy::config::route::v3::RouteConfiguration*>(&rc));
+  // The previous config is the null config before the first update. The new config is the
+  // previous one of the next update.
+  return std::make_shared<ConfigImpl>(
+      static_cast<const envoy::config::route::v3::RouteConfiguration&>(rc), factory_context,
+      validator_, validate_clusters_default,
+      dynamic_cast<const ConfigImpl*>(previous_config.get()), true);
+}
+
 bool RouteConfigUpdateReceiverImpl::onRdsUpdate(const Protobuf::Message& rc,
                                                 const std::string& version_info) {
   uint64_t new_hash = base_.getHash(rc);
@@ -1487,7 +1487,7 @@ void Filter::directProcessing() {
 
   // ULID(R09)
   ENVOY_STREAM_UL_LOG(debug, "Removing Target-Api-Root header.", *callbacks_, ULID(R09));
-  downstream_headers_->remove(Http::LowerCaseString("3gpp-Sbi-target-apiRoot"));
+  downstream_headers_->removeInline(SbiCustomHeaders::targetApiRoot());
 
   // ULID(R34)  In directProcessing we should unconditionally remove all discovery headers
   removeAllDiscoveryHeaders();
@@ -1521,23 +1521,23 @@ void Filter::indirectProcessing() {
         // ULID(R18)
         ENVOY_STREAM_UL_LOG(debug, "Setting 3gpp-Sbi-target-apiRoot header from Dynamic Metadata.",
                          *callbacks_, ULID(R18));
-        downstream_headers_->setCopy(Http::LowerCaseString("3gpp-Sbi-target-apiRoot"),
-                                     EricProxyFilter::extractFromDynMetadata(
-                                         cb_filter_md, "eric_proxy", "target-api-root-value"));
+        downstream_headers_->setInline(SbiCustomHeaders::targetApiRoot(),
+                                       EricProxyFilter::extractFromDynMetadata(
+                                           cb_filter_md, "eric_proxy", "target-api-root-value"));
       } else if (EricProxyFilter::findInDynMetadata(cb_filter_md, "eric_proxy",
                                                     "target-api-root-values")) {
         // ULID(R31)  This is "remote-round-robin"
         ENVOY_STREAM_UL_LOG(trace, "inserting the next value to the  3gpp-Sbi-target-apiRoot header.",
                          *callbacks_, ULID(R31));
-        downstream_headers_->setCopy(Http::LowerCaseString("3gpp-Sbi-target-apiRoot"),
-                                     tar_list_->getNextTarValue());
+        downstream_headers_->setInline(SbiCustomHeaders::targetApiRoot(),
+                                       tar_list_->getNextTarValue());
       } else {
         ENVOY_STREAM_UL_LOG(debug, "Removed Target-Api-Root header.", *callbacks_, ULID(R32));
-          downstream_headers_->remove(Http::LowerCaseString("3gpp-Sbi-target-apiRoot"));
+          downstream_headers_->removeInline(SbiCustomHeaders::targetApiRoot());
       }
   } else {
     ENVOY_STREAM_UL_LOG(debug, "Removed Target-Api-Root header.", *callbacks_, ULID(R22));
-      downstream_headers_->remove(Http::LowerCaseString("3gpp-Sbi-target-apiRoot"));
+      downstream_headers_->removeInline(SbiCustomHeaders::targetApiRoot());
   }
 
   // ULID(R33)  Preserve discovery parameter handling
@@ -1658,13 +1658,18 @@ void Filter::onUpstreamHostSelected(Upstream::HostDescriptionConstSharedPtr host
   if (host) {
     if ((host->metadata() != nullptr)) {
       // ULID(R28) NF-PeerInfo Handling
-      const auto sbi_nf_peer_info_pr =
-          std::make_unique<Extensions::HttpFilters::EricProxy::SbiNfPeerInfoHeaderRequestMetadata>(
-              callbacks_->streamInfo().dynamicMetadata(), host->metadata());
-      if (sbi_nf_peer_info_pr->isActivated()) {
-        sbi_nf_peer_info_pr->setSelectedFqdn(host->hostname());
-        sbi_nf_peer_info_pr->setAll(*downstream_headers_);
-        sbi_nf_peer_info_pr->saveUpdatedHeaderInMetadata(callbacks_, *downstream_headers_);
+      auto* sbi_nf_peer_info_state =
+          callbacks_->streamInfo()
+              .filterState()
+              ->getDataMutable<Extensions::HttpFilters::EricProxy::SbiNfPeerInfoState>(
+                  Extensions::HttpFilters::EricProxy::SbiNfPeerInfoState::key());
+      Extensions::HttpFilters::EricProxy::SbiNfPeerInfoHeaderRequestMetadata sbi_nf_peer_info_pr(
+          sbi_nf_peer_info_state, host->metadata());
+      if (sbi_nf_peer_info_pr.isActivated()) {
+        sbi_nf_peer_info_pr.setSelectedFqdn(host->hostname());
+        sbi_nf_peer_info_pr.setAll(*downstream_headers_);
+        sbi_nf_peer_info_pr.saveUpdatedHeaderInState(*sbi_nf_peer_info_state, callbacks_,
+                                                     *downstream_headers_);
       }
       const StreamInfo::FilterStateSharedPtr& filter_state =
           callbacks_->streamInfo().filterState();
@@ -1747,7 +1752,7 @@ void Filter::onUpstreamHostSelected(Upstream::HostDescriptionConstSharedPtr host
 
                 // ULID(R21)
                 ENVOY_STREAM_UL_LOG(debug, "Removing Target-Api-Root header.", *callbacks_, ULID(R21));
-                  downstream_headers_->remove(Http::LowerCaseString("3gpp-Sbi-target-apiRoot"));
+                  downstream_headers_->removeInline(SbiCustomHeaders::targetApiRoot());
 
                 if (EricProxyFilter::findInDynMetadata(cb_filter_md, "eric_proxy",
                                                        "preferred-host")) {
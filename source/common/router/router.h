@@ -48,6 +48,7 @@
 #include "source/common/upstream/upstream_factory_context_impl.h"
 
 #include "source/extensions/filters/http/eric_proxy/filter.h"
+#include "source/extensions/filters/http/eric_proxy/sbi_custom_headers.h"
 #include "source/common/router/eric_proxy.h"
 
 namespace Envoy {
@@ -560,6 +561,8 @@ protected:
 private:
   friend class UpstreamRequest;
   using EricProxyFilter = Extensions::HttpFilters::EricProxy::EricProxyFilter;
+  using SbiCustomHeaders = Extensions::HttpFilters::EricProxy::SbiCustomHeaders;
+  using SbiHeaders = Extensions::HttpFilters::EricProxy::SbiHeaders;
   enum class TimeoutRetry { Yes, No };
   enum PathType {
     Absolute = 0,
@@ -30,6 +30,7 @@ VhdsSubscription::VhdsSubscription(RouteConfigUpdatePtr& config_update_info,
       scope_(factory_context.scope().createScope(
           stat_prefix + "vhds." + config_update_info_->protobufConfigurationCast().name() + ".")),
       stats_({ALL_VHDS_STATS(POOL_COUNTER(*scope_))}),
+      build_stats_(RouteConfigBuildStats::generateStats(*scope_)),
       init_target_(fmt::format("VhdsConfigSubscription {}",
                                config_update_info_->protobufConfigurationCast().name()),
                    [this]() {
@@ -84,8 +85,11 @@ absl::Status VhdsSubscription::onConfigUpdate(
     added_vhosts.emplace_back(
         dynamic_cast<const envoy::config::route::v3::VirtualHost&>(resource.get().resource()));
   }
-  if (config_update_info_->onVhdsUpdate(added_vhosts, added_resource_ids, removed_resources,
-                                        version_info)) {
+  const bool config_changed = config_update_info_->onVhdsUpdate(
+      added_vhosts, added_resource_ids, removed_resources, version_info);
+  // The route configuration is built again even if no virtual host changed.
+  build_stats_.record(config_update_info_->parsedConfiguration());
+  if (config_changed) {
     stats_.config_reload_.inc();
     ENVOY_LOG(debug, "vhds: loading new configuration: config_name={} hash={}",
               config_update_info_->protobufConfigurationCast().name(),
@@ -22,6 +22,7 @@
 #include "source/common/config/subscription_base.h"
 #include "source/common/init/target_impl.h"
 #include "source/common/protobuf/utility.h"
+#include "source/common/router/config_impl.h"
 
 #include "absl/container/node_hash_set.h"
 
@@ -71,6 +72,7 @@ private:
   RouteConfigUpdatePtr& config_update_info_;
   Stats::ScopeSharedPtr scope_;
   VhdsStats stats_;
+  RouteConfigBuildStats build_stats_;
   Envoy::Config::SubscriptionPtr subscription_;
   Init::TargetImpl init_target_;
   Rds::RouteConfigProvider* route_config_provider_;
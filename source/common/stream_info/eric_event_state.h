@@ -13,7 +13,7 @@ class EricEventState: public FilterState::Object {
 public:
   static const std::string& key() { CONSTRUCT_ON_FIRST_USE(std::string, "envoy.eric_event_state"); }
 
-  void addEvent(EricEvent::EventT&& event) { events_.push_back(event); }
+  void addEvent(EricEvent::EventT&& event) { events_.push_back(std::move(event)); }
 
   const std::vector<EricEvent::EventT>& events() const { return events_; }
   const EricEvent::EventT& getCurrentEvent() const { return events_.at(indx_); }
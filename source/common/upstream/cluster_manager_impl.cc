@@ -1546,6 +1546,58 @@ void ClusterManagerImpl::ThreadLocalClusterManagerImpl::ClusterEntry::updateHost
     ENVOY_LOG(debug, "re-creating local LB for TLS cluster {}", name);
     lb_ = lb_factory_->create({priority_set_, parent_.local_priority_set_});
   }
+
+  if (!hosts_added.empty()) {
+    prewarmConnPools(hosts_added);
+  }
+}
+
+void ClusterManagerImpl::ThreadLocalClusterManagerImpl::ClusterEntry::prewarmConnPools(
+    const HostVector& hosts_added) {
+  // The ratio has the same meaning as the predictive preconnect ratio for a pool that has no
+  // streams yet: the pool connects until it has capacity for ratio streams. Like the preconnect
+  // policy it is capped at 3. Only this cluster's pools are prewarmed, connections are not
+  // shared with other clusters that have a host with the same address.
+  const float ratio = std::min<double>(
+      parent_.parent_.runtime_.snapshot().getDouble("upstream.prewarm_connection_ratio", 0), 3);
+  if (!(ratio > 0) || !requestsUseDefaultConnPool()) {
+    return;
+  }
+  for (const auto& host : hosts_added) {
+    // Unhealthy hosts are not preconnected by the pools anyway, see
+    // ConnPoolImplBase::shouldCreateNewConnection().
+    if (host->coarseHealth() != Host::Health::Healthy) {
+      continue;
+    }
+    // The pool is the one used by requests that bring no socket or transport socket options of
+    // their own, on the cluster's protocol for an HTTP/1.1 or unknown downstream.
+    Http::ConnectionPool::Instance* pool =
+        httpConnPoolForHost(host, ResourcePriority::Default, absl::nullopt, nullptr);
+    if (pool != nullptr && pool->maybePreconnect(ratio)) {
+      ENVOY_LOG(debug, "prewarmed connection to {} for TLS cluster {}",
+                host->address()->asString(), cluster_info_->name());
+    }
+  }
+}
+
+bool ClusterManagerImpl::ThreadLocalClusterManagerImpl::ClusterEntry::requestsUseDefaultConnPool()
+    const {
+  // Requests to this cluster are hashed to pools that a prewarm cannot predict if
+  // - the upstream protocol follows the downstream protocol (e.g. HTTP/2 downstreams),
+  // - the SNI or SAN validation is derived from the host or the request and becomes part of
+  //   the transport socket options,
+  // - every downstream connection has pools of its own.
+  if (cluster_info_->features() & ClusterInfo::Features::USE_DOWNSTREAM_PROTOCOL) {
+    return false;
+  }
+  const auto& upstream_http_protocol_options = cluster_info_->upstreamHttpProtocolOptions();
+  if (upstream_http_protocol_options.has_value() &&
+      (upstream_http_protocol_options->auto_sni() ||
+       upstream_http_protocol_options->auto_san_validation() ||
+       upstream_http_protocol_options->enable_sni_from_host())) {
+    return false;
+  }
+  return !cluster_info_->connectionPoolPerDownstreamConnection();
 }
 
 void ClusterManagerImpl::ThreadLocalClusterManagerImpl::ClusterEntry::drainConnPools(
@@ -2011,6 +2063,13 @@ ClusterManagerImpl::ThreadLocalClusterManagerImpl::ClusterEntry::httpConnPoolImp
     return nullptr;
   }
 
+  return httpConnPoolForHost(host, priority, downstream_protocol, context);
+}
+
+Http::ConnectionPool::Instance*
+ClusterManagerImpl::ThreadLocalClusterManagerImpl::ClusterEntry::httpConnPoolForHost(
+    const HostConstSharedPtr& host, ResourcePriority priority,
+    absl::optional<Http::Protocol> downstream_protocol, LoadBalancerContext* context) {
   // Right now, HTTP, HTTP/2 and ALPN pools are considered separate.
   // We could do better here, and always use the ALPN pool and simply make sure
   // we end up on a connection of the correct protocol, but for simplicity we're
@@ -2049,10 +2108,10 @@ ClusterManagerImpl::ThreadLocalClusterManagerImpl::ClusterEntry::httpConnPoolImp
       const auto parsed_authority = Http::Utility::parseAuthority(host->hostname());
       bool should_set_sni = !parsed_authority.is_ip_address_;
       absl::string_view sni_value = parsed_authority.host_;
-      if (should_set_sni) {
+      if (should_set_sni && context) {
         context->setSniFromHostName(sni_value);
       }
-      if (upstream_http_protocol_options.value().auto_san_validation()) {
+      if (context && upstream_http_protocol_options.value().auto_san_validation()) {
         context->setAutoSanValidation(sni_value);
       }
     }
@@ -622,6 +622,16 @@ private:
       httpConnPoolImpl(ResourcePriority priority,
                        absl::optional<Http::Protocol> downstream_protocol,
                        LoadBalancerContext* context, bool peek);
+      Http::ConnectionPool::Instance*
+      httpConnPoolForHost(const HostConstSharedPtr& host, ResourcePriority priority,
+                          absl::optional<Http::Protocol> downstream_protocol,
+                          LoadBalancerContext* context);
+      // Preconnects the default HTTP connection pools of the added hosts if
+      // upstream.prewarm_connection_ratio is set.
+      void prewarmConnPools(const HostVector& hosts_added);
+      // Whether requests without socket or transport socket options of their own use the pool
+      // returned by httpConnPoolForHost() without a context, i.e. whether prewarming it helps.
+      bool requestsUseDefaultConnPool() const;
 
       Tcp::ConnectionPool::Instance* tcpConnPoolImpl(ResourcePriority priority,
                                                      LoadBalancerContext* context, bool peek);
@@ -21,6 +21,7 @@
 #include "source/common/runtime/runtime_features.h"
 
 #include "absl/container/fixed_array.h"
+#include "absl/hash/hash.h"
 
 namespace Envoy {
 namespace Upstream {
@@ -749,12 +750,23 @@ HostConstSharedPtr ZoneAwareLoadBalancerBase::chooseHost(LoadBalancerContext* co
   HostConstSharedPtr host;
 
   const size_t max_attempts = context ? context->hostSelectionRetryCount() + 1 : 1;
-  for (size_t i = 0; i < max_attempts; ++i) {
+  uint32_t ejection_pending_reselects = 0;
+  for (size_t i = 0; i < max_attempts + ejection_pending_reselects; ++i) {
     ENVOY_LOG(debug, "Calling chooseHostOnce(), try={} max_attempts: {}", i, max_attempts);
     host = chooseHostOnce(context);
     if(host != nullptr) {
       ENVOY_LOG(debug, "Candidate host returned by chooseHostOnce() host {} (ip {})",
                         host->hostname(),host->address()->asStringView());
+      // A worker has seen the host reach a consecutive error threshold, but the main thread has
+      // not ejected it yet. Pick again a few times, these picks do not count as attempts. If
+      // there is no other host, the host is still returned.
+      if (host->outlierDetector().ejectionPending() &&
+          ejection_pending_reselects < MaxEjectionPendingReselects) {
+        ENVOY_LOG(debug, "Candidate host {} (ip {}) has a pending outlier ejection",
+                  host->hostname(), host->address()->asStringView());
+        ++ejection_pending_reselects;
+        continue;
+      }
     }
     // If host selection failed or the host is accepted by the filter, return.
     // Otherwise, try again.
@@ -1040,13 +1052,25 @@ EdfLoadBalancerBase::EdfLoadBalancerBase(
                                                slow_start_config.value(), min_weight_percent, 10) /
                                                100.0
                                          : 0.1) {
-  // We fully recompute the schedulers for a given host set here on membership change, which is
-  // consistent with what other LB implementations do (e.g. thread aware).
-  // The downside of a full recompute is that time complexity is O(n * log n),
-  // so we will need to do better at delta tracking to scale (see
+  // We recompute the schedulers for a given host set here on membership change, which is
+  // consistent with what other LB implementations do (e.g. thread aware). Only the host
+  // sources whose hosts changed are recomputed, see refresh().
+  // The downside of a recompute is that time complexity is O(n * log n) per changed
+  // source, so we will need to do better at delta tracking to scale (see
   // https://github.com/envoyproxy/envoy/issues/2874).
   priority_update_cb_ = priority_set.addPriorityUpdateCb(
-      [this](uint32_t priority, const HostVector&, const HostVector&) { refresh(priority); });
+      [this](uint32_t priority, const HostVector& hosts_added, const HostVector& hosts_removed) {
+        if (!hosts_added.empty() || !hosts_removed.empty()) {
+          // Host signatures cannot tell a new host from a removed one at the same address,
+          // rebuild all schedulers of the priority.
+          for (auto& [source, scheduler] : scheduler_) {
+            if (source.priority_ == priority) {
+              scheduler.hosts_signature_.reset();
+            }
+          }
+        }
+        refresh(priority);
+      });
   member_update_cb_ = priority_set.addMemberUpdateCb(
       [this](const HostVector& hosts_added, const HostVector&) -> void {
         if (isSlowStartEnabled()) {
@@ -1085,8 +1109,29 @@ void EdfLoadBalancerBase::recalculateHostsInSlowStart(const HostVector& hosts) {
   }
 }
 
+uint64_t EdfLoadBalancerBase::hostsSignature(const HostVector& hosts) {
+  uint64_t signature = hosts.size();
+  for (const auto& host : hosts) {
+    signature = absl::HashOf(signature, host.get(), host->weight());
+  }
+  return signature;
+}
+
 void EdfLoadBalancerBase::refresh(uint32_t priority) {
   const auto add_hosts_source = [this](HostsSource source, const HostVector& hosts) {
+    // A partial update (e.g. the health of a single host changed) leaves most host
+    // sources of a priority unchanged, typically all localities but one. Keep their
+    // schedulers, rebuilding them is O(n * log n) per source. With slow start the weights
+    // depend on time, so the scheduler is always rebuilt.
+    absl::optional<uint64_t> signature;
+    if (!isSlowStartEnabled()) {
+      signature = hostsSignature(hosts);
+      auto existing = scheduler_.find(source);
+      if (existing != scheduler_.end() && existing->second.edf_ != nullptr &&
+          existing->second.hosts_signature_ == signature) {
+        return;
+      }
+    }
     // Nuke existing scheduler if it exists.
     auto& scheduler = scheduler_[source] = Scheduler{};
     refreshHostSource(source);
@@ -1103,6 +1148,7 @@ void EdfLoadBalancerBase::refresh(uint32_t priority) {
       return;
     }
     scheduler.edf_ = std::make_unique<EdfScheduler<const Host>>();
+    scheduler.hosts_signature_ = signature;
 
     // Populate scheduler with host list.
     // TODO(mattklein123): We must build the EDF schedule even if all of the hosts are currently
@@ -1305,6 +1351,50 @@ double LeastRequestLoadBalancer::hostWeight(const Host& host) const {
   }
 }
 
+LeastRequestLoadBalancer::~LeastRequestLoadBalancer() {
+  for (auto& [source, mirror] : worker_active_requests_) {
+    removeWorkerActiveRequests(mirror);
+  }
+}
+
+void LeastRequestLoadBalancer::removeWorkerActiveRequests(WorkerActiveRequestsMirror& mirror) {
+  for (size_t i = 0; i < mirror.hosts_.size(); ++i) {
+    WorkerActiveRequests::removeCounter(*mirror.hosts_[i], mirror.active_requests_[i]);
+  }
+  mirror.hosts_.clear();
+  mirror.active_requests_.reset();
+}
+
+void LeastRequestLoadBalancer::refreshHostSource(const HostsSource& source) {
+  const HostVector& hosts = hostSourceToHosts(source);
+  if (use_worker_active_requests_) {
+    WorkerActiveRequestsMirror& mirror = worker_active_requests_[source];
+    // Hosts that stay in the source keep their count
+    absl::flat_hash_map<const HostDescription*, uint32_t> previous_counts;
+    for (size_t i = 0; i < mirror.hosts_.size(); ++i) {
+      previous_counts.emplace(mirror.hosts_[i], mirror.active_requests_[i]);
+    }
+    removeWorkerActiveRequests(mirror);
+    mirror.hosts_.reserve(hosts.size());
+    mirror.active_requests_ = std::make_unique<uint32_t[]>(hosts.size());
+    for (size_t i = 0; i < hosts.size(); ++i) {
+      mirror.hosts_.push_back(hosts[i].get());
+      const auto previous = previous_counts.find(hosts[i].get());
+      if (previous != previous_counts.end()) {
+        mirror.active_requests_[i] = previous->second;
+      }
+      WorkerActiveRequests::addCounter(*hosts[i], mirror.active_requests_[i]);
+    }
+    return;
+  }
+  std::vector<const Stats::PrimitiveGauge*>& rq_active_gauges = rq_active_gauges_[source];
+  rq_active_gauges.clear();
+  rq_active_gauges.reserve(hosts.size());
+  for (const auto& host : hosts) {
+    rq_active_gauges.push_back(&host->stats().rq_active_);
+  }
+}
+
 HostConstSharedPtr LeastRequestLoadBalancer::unweightedHostPeek(const HostVector&,
                                                                 const HostsSource&) {
   // LeastRequestLoadBalancer can not do deterministic preconnecting, because
@@ -1313,29 +1403,47 @@ HostConstSharedPtr LeastRequestLoadBalancer::unweightedHostPeek(const HostVector
   return nullptr;
 }
 
-HostConstSharedPtr LeastRequestLoadBalancer::unweightedHostPick(const HostVector& hosts_to_use,
-                                                                const HostsSource&) {
-  HostSharedPtr candidate_host = nullptr;
+template <class ActiveRequests>
+HostConstSharedPtr LeastRequestLoadBalancer::pickLeastActive(const HostVector& hosts_to_use,
+                                                            ActiveRequests active_requests) {
+  // Only the index of the candidate is tracked, the host shared pointer is copied once for the
+  // host that is returned.
+  size_t candidate_idx = 0;
+  uint64_t candidate_active_rq = 0;
 
   for (uint32_t choice_idx = 0; choice_idx < choice_count_; ++choice_idx) {
-    const int rand_idx = random_.random() % hosts_to_use.size();
-    const HostSharedPtr& sampled_host = hosts_to_use[rand_idx];
-
-    if (candidate_host == nullptr) {
-
-      // Make a first choice to start the comparisons.
-      candidate_host = sampled_host;
-      continue;
-    }
+    const size_t rand_idx = random_.random() % hosts_to_use.size();
+    const uint64_t sampled_active_rq = active_requests(rand_idx);
 
-    const auto candidate_active_rq = candidate_host->stats().rq_active_.value();
-    const auto sampled_active_rq = sampled_host->stats().rq_active_.value();
-    if (sampled_active_rq < candidate_active_rq) {
-      candidate_host = sampled_host;
+    // The first choice starts the comparisons.
+    if (choice_idx == 0 || sampled_active_rq < candidate_active_rq) {
+      candidate_idx = rand_idx;
+      candidate_active_rq = sampled_active_rq;
     }
   }
 
-  return candidate_host;
+  return hosts_to_use[candidate_idx];
+}
+
+HostConstSharedPtr LeastRequestLoadBalancer::unweightedHostPick(const HostVector& hosts_to_use,
+                                                                const HostsSource& source) {
+  if (use_worker_active_requests_) {
+    const auto mirror_it = worker_active_requests_.find(source);
+    ASSERT(mirror_it != worker_active_requests_.end() &&
+           mirror_it->second.hosts_.size() == hosts_to_use.size());
+    const uint32_t* active_requests = mirror_it->second.active_requests_.get();
+    return pickLeastActive(hosts_to_use, [active_requests](size_t idx) -> uint64_t {
+      return active_requests[idx];
+    });
+  }
+
+  const auto gauges_it = rq_active_gauges_.find(source);
+  ASSERT(gauges_it != rq_active_gauges_.end() &&
+         gauges_it->second.size() == hosts_to_use.size());
+  const std::vector<const Stats::PrimitiveGauge*>& rq_active_gauges = gauges_it->second;
+  return pickLeastActive(hosts_to_use, [&rq_active_gauges](size_t idx) -> uint64_t {
+    return rq_active_gauges[idx]->value();
+  });
 }
 
 HostConstSharedPtr RandomLoadBalancer::peekAnotherHost(LoadBalancerContext* context) {
@@ -24,6 +24,7 @@
 #include "source/common/runtime/runtime_protos.h"
 #include "source/common/upstream/edf_scheduler.h"
 #include "source/common/upstream/subset_lb_config.h"
+#include "source/common/upstream/worker_active_requests.h"
 
 namespace Envoy {
 namespace Upstream {
@@ -265,6 +266,9 @@ public:
   HostConstSharedPtr chooseHost(LoadBalancerContext* context) override;
   void analyzePrioritySet(LoadBalancerContext* context) override;
 
+  // How often chooseHost() picks again when the chosen host has a pending outlier ejection.
+  static constexpr uint32_t MaxEjectionPendingReselects = 3;
+
 protected:
   // Both priority_set and local_priority_set if non-null must have at least one host set.
   ZoneAwareLoadBalancerBase(const PrioritySet& priority_set, const PrioritySet* local_priority_set,
@@ -540,11 +544,17 @@ protected:
     // host weights of 2 or more hosts differ. When not present, the
     // implementation of chooseHostOnce falls back to unweightedHostPick.
     std::unique_ptr<EdfScheduler<const Host>> edf_;
+    // Hash of the hosts (their addresses in memory) and weights edf_ was built from.
+    // If a refresh leaves them unchanged, the scheduler is kept instead of being rebuilt.
+    // Not set with slow start, or after hosts were added to or removed from the priority:
+    // a new host can be allocated where a removed one was and would hash the same.
+    absl::optional<uint64_t> hosts_signature_;
   };
 
   void initialize();
 
   virtual void refresh(uint32_t priority);
+  static uint64_t hostsSignature(const HostVector& hosts);
 
   bool isSlowStartEnabled() const;
   bool noHostsAreInSlowStart() const;
@@ -705,7 +715,8 @@ public:
             least_request_config.has_value() && least_request_config->has_active_request_bias()
                 ? absl::optional<Runtime::Double>(
                       {least_request_config->active_request_bias(), runtime})
-                : absl::nullopt) {
+                : absl::nullopt),
+        use_worker_active_requests_(useWorkerActiveRequests(runtime)) {
     initialize();
   }
 
@@ -724,10 +735,13 @@ public:
             least_request_config.has_active_request_bias()
                 ? absl::optional<Runtime::Double>(
                       {least_request_config.active_request_bias(), runtime})
-                : absl::nullopt) {
+                : absl::nullopt),
+        use_worker_active_requests_(useWorkerActiveRequests(runtime)) {
     initialize();
   }
 
+  ~LeastRequestLoadBalancer() override;
+
 protected:
   void refresh(uint32_t priority) override {
     active_request_bias_ = active_request_bias_runtime_ != absl::nullopt
@@ -745,12 +759,31 @@ protected:
   }
 
 private:
-  void refreshHostSource(const HostsSource&) override {}
+  // The active requests of the hosts of one host source, counted by the connection pools of
+  // this worker, see WorkerActiveRequests.
+  struct WorkerActiveRequestsMirror {
+    // Only used to remove the counters, the hosts are not dereferenced
+    std::vector<const HostDescription*> hosts_;
+    // Allocated once per refresh, the counters are added at their addresses
+    std::unique_ptr<uint32_t[]> active_requests_;
+  };
+
+  static bool useWorkerActiveRequests(Runtime::Loader& runtime) {
+    return runtime.snapshot().getBoolean("upstream.least_request.worker_active_requests", false);
+  }
+  void removeWorkerActiveRequests(WorkerActiveRequestsMirror& mirror);
+
+  void refreshHostSource(const HostsSource& source) override;
   double hostWeight(const Host& host) const override;
   HostConstSharedPtr unweightedHostPeek(const HostVector& hosts_to_use,
                                         const HostsSource& source) override;
   HostConstSharedPtr unweightedHostPick(const HostVector& hosts_to_use,
                                         const HostsSource& source) override;
+  // Samples choice_count_ hosts and returns the one with the fewest active requests, as returned
+  // by active_requests(host index).
+  template <class ActiveRequests>
+  HostConstSharedPtr pickLeastActive(const HostVector& hosts_to_use,
+                                     ActiveRequests active_requests);
 
   const uint32_t choice_count_;
 
@@ -760,6 +793,19 @@ private:
   double active_request_bias_{};
 
   const absl::optional<Runtime::Double> active_request_bias_runtime_;
+
+  // The active request gauges of the hosts of each host source, in host order. The unweighted
+  // pick compares the sampled hosts through this array instead of dereferencing the host shared
+  // pointers and going through Host::stats() for every sample.
+  absl::flat_hash_map<HostsSource, std::vector<const Stats::PrimitiveGauge*>, HostsSourceHash>
+      rq_active_gauges_;
+
+  // Opt-in with the runtime key upstream.least_request.worker_active_requests: the unweighted
+  // pick compares the active requests of this worker, kept in an array per host source, instead
+  // of the hosts' gauges.
+  const bool use_worker_active_requests_;
+  absl::flat_hash_map<HostsSource, WorkerActiveRequestsMirror, HostsSourceHash>
+      worker_active_requests_;
 };
 
 /**
@@ -60,6 +60,14 @@ void DetectorHostMonitorImpl::uneject(MonotonicTime unejection_time) {
   last_unejection_time_ = (unejection_time);
 }
 
+void DetectorHostMonitorImpl::setEjectionPending(DetectorImpl& detector) {
+  // Let the load balancers of this and the other workers avoid the host right away instead of
+  // after the main thread has processed the ejection and updated the host sets.
+  if (detector.runtime().snapshot().getBoolean(WorkerFastEjectionRuntime, false)) {
+    ejection_pending_.store(true, std::memory_order_relaxed);
+  }
+}
+
 void DetectorHostMonitorImpl::updateCurrentSuccessRateBucket() {
   external_origin_sr_monitor_.updateCurrentSuccessRateBucket();
   local_origin_sr_monitor_.updateCurrentSuccessRateBucket();
@@ -77,6 +85,7 @@ void DetectorHostMonitorImpl::putHttpResponseCode(uint64_t response_code) {
       if (++consecutive_gateway_failure_ ==
           detector->runtime().snapshot().getInteger(
               ConsecutiveGatewayFailureRuntime, detector->config().consecutiveGatewayFailure())) {
+        setEjectionPending(*detector);
         detector->onConsecutiveGatewayFailure(host_.lock());
       }
     } else {
@@ -85,6 +94,7 @@ void DetectorHostMonitorImpl::putHttpResponseCode(uint64_t response_code) {
 
     if (++consecutive_5xx_ == detector->runtime().snapshot().getInteger(
                                   Consecutive5xxRuntime, detector->config().consecutive5xx())) {
+      setEjectionPending(*detector);
       detector->onConsecutive5xx(host_.lock());
     }
   } else {
@@ -190,6 +200,7 @@ void DetectorHostMonitorImpl::localOriginFailure() {
       detector->runtime().snapshot().getInteger(
           ConsecutiveLocalOriginFailureRuntime,
           detector->config().consecutiveLocalOriginFailure())) {
+    setEjectionPending(*detector);
     detector->onConsecutiveLocalOriginFailure(host_.lock());
   }
 }
@@ -569,9 +580,13 @@ void DetectorImpl::onConsecutiveErrorWorker(HostSharedPtr host,
                                             envoy::data::cluster::v3::OutlierEjectionType type) {
   // Ejections come in cross thread. There is a chance that the host has already been removed from
   // the set. If so, just ignore it.
-  if (host_monitors_.count(host) == 0) {
+  auto monitor_it = host_monitors_.find(host);
+  if (monitor_it == host_monitors_.end()) {
     return;
   }
+  // From here on the host is selected according to its health flags again, whether it is ejected
+  // below or not (e.g. because of max_ejection_percent).
+  monitor_it->second->clearEjectionPending();
   if (host->healthFlagGet(Host::HealthFlag::FAILED_OUTLIER_CHECK)) {
     return;
   }
@@ -624,13 +639,26 @@ DetectorImpl::EjectionPair DetectorImpl::successRateEjectionThreshold(
   // variance = 400
   // stdev = 20
   // threshold returned = 52
-  double mean = success_rate_sum / valid_success_rate_hosts.size();
+  std::vector<double> success_rates;
+  success_rates.reserve(valid_success_rate_hosts.size());
+  for (const auto& host_success_rate_pair : valid_success_rate_hosts) {
+    success_rates.push_back(host_success_rate_pair.success_rate_);
+  }
+  return successRateEjectionThreshold(success_rate_sum, success_rates, success_rate_stdev_factor);
+}
+
+DetectorImpl::EjectionPair
+DetectorImpl::successRateEjectionThreshold(double success_rate_sum,
+                                           const std::vector<double>& success_rates,
+                                           double success_rate_stdev_factor) {
+  const double mean = success_rate_sum / success_rates.size();
+  // A plain loop over contiguous doubles, which the compiler can vectorize.
   double variance = 0;
-  std::for_each(valid_success_rate_hosts.begin(), valid_success_rate_hosts.end(),
-                [&variance, mean](HostSuccessRatePair v) {
-                  variance += std::pow(v.success_rate_ - mean, 2);
-                });
-  variance /= valid_success_rate_hosts.size();
+  for (const double success_rate : success_rates) {
+    const double diff = success_rate - mean;
+    variance += diff * diff;
+  }
+  variance /= success_rates.size();
   double stdev = std::sqrt(variance);
 
   return {mean, (mean - (success_rate_stdev_factor * stdev))};
@@ -647,8 +675,29 @@ void DetectorImpl::processSuccessRateEjections(
   uint64_t failure_percentage_request_volume = runtime_.snapshot().getInteger(
       FailurePercentageRequestVolumeRuntime, config_.failurePercentageRequestVolume());
 
-  std::vector<HostSuccessRatePair> valid_success_rate_hosts;
-  std::vector<HostSuccessRatePair> valid_failure_percentage_hosts;
+  // The hosts with enough request volume, as struct-of-arrays: the success rates are
+  // contiguous for the mean/stdev pass, the host and its monitor are kept next to them so
+  // that ejecting a host does not need another lookup in host_monitors_.
+  struct ValidHosts {
+    void reserve(size_t size) {
+      hosts_.reserve(size);
+      monitors_.reserve(size);
+      success_rates_.reserve(size);
+    }
+    void add(const HostSharedPtr& host, DetectorHostMonitorImpl* monitor, double success_rate) {
+      hosts_.push_back(host);
+      monitors_.push_back(monitor);
+      success_rates_.push_back(success_rate);
+    }
+    size_t size() const { return success_rates_.size(); }
+    bool empty() const { return success_rates_.empty(); }
+
+    std::vector<HostSharedPtr> hosts_;
+    std::vector<DetectorHostMonitorImpl*> monitors_;
+    std::vector<double> success_rates_;
+  };
+  ValidHosts valid_success_rate_hosts;
+  ValidHosts valid_failure_percentage_hosts;
   double success_rate_sum = 0;
 
   // Reset the Detector's success rate mean and stdev.
@@ -684,11 +733,11 @@ void DetectorImpl::processSuccessRateEjections(
       }
 
       if (request_volume >= success_rate_request_volume) {
-        valid_success_rate_hosts.emplace_back(HostSuccessRatePair(host.first, success_rate));
+        valid_success_rate_hosts.add(host.first, host.second, success_rate);
         success_rate_sum += success_rate;
       }
       if (request_volume >= failure_percentage_request_volume) {
-        valid_failure_percentage_hosts.emplace_back(HostSuccessRatePair(host.first, success_rate));
+        valid_failure_percentage_hosts.add(host.first, host.second, success_rate);
       }
     }
   }
@@ -700,17 +749,15 @@ void DetectorImpl::processSuccessRateEjections(
                                        config_.successRateStdevFactor()) /
         1000.0;
     getSRNums(monitor_type) = successRateEjectionThreshold(
-        success_rate_sum, valid_success_rate_hosts, success_rate_stdev_factor);
+        success_rate_sum, valid_success_rate_hosts.success_rates_, success_rate_stdev_factor);
     const double success_rate_ejection_threshold = getSRNums(monitor_type).ejection_threshold_;
-    for (const auto& host_success_rate_pair : valid_success_rate_hosts) {
-      if (host_success_rate_pair.success_rate_ < success_rate_ejection_threshold) {
+    for (size_t i = 0; i < valid_success_rate_hosts.size(); i++) {
+      if (valid_success_rate_hosts.success_rates_[i] < success_rate_ejection_threshold) {
         stats_.ejections_success_rate_.inc(); // Deprecated.
         const envoy::data::cluster::v3::OutlierEjectionType type =
-            host_monitors_[host_success_rate_pair.host_]
-                ->getSRMonitor(monitor_type)
-                .getEjectionType();
+            valid_success_rate_hosts.monitors_[i]->getSRMonitor(monitor_type).getEjectionType();
         updateDetectedEjectionStats(type);
-        ejectHost(host_success_rate_pair.host_, type);
+        ejectHost(valid_success_rate_hosts.hosts_[i], type);
       }
     }
   }
@@ -720,8 +767,9 @@ void DetectorImpl::processSuccessRateEjections(
     const double failure_percentage_threshold = runtime_.snapshot().getInteger(
         FailurePercentageThresholdRuntime, config_.failurePercentageThreshold());
 
-    for (const auto& host_success_rate_pair : valid_failure_percentage_hosts) {
-      if ((100.0 - host_success_rate_pair.success_rate_) >= failure_percentage_threshold) {
+    for (size_t i = 0; i < valid_failure_percentage_hosts.size(); i++) {
+      if ((100.0 - valid_failure_percentage_hosts.success_rates_[i]) >=
+          failure_percentage_threshold) {
         // We should eject.
 
         // The ejection type returned by the SuccessRateMonitor's getEjectionType() will be a
@@ -731,7 +779,7 @@ void DetectorImpl::processSuccessRateEjections(
                 ? envoy::data::cluster::v3::FAILURE_PERCENTAGE
                 : envoy::data::cluster::v3::FAILURE_PERCENTAGE_LOCAL_ORIGIN;
         updateDetectedEjectionStats(type);
-        ejectHost(host_success_rate_pair.host_, type);
+        ejectHost(valid_failure_percentage_hosts.hosts_[i], type);
       }
     }
   }
@@ -740,7 +788,7 @@ void DetectorImpl::processSuccessRateEjections(
 void DetectorImpl::onIntervalTimer() {
   MonotonicTime now = time_source_.monotonicTime();
 
-  for (auto host : host_monitors_) {
+  for (const auto& host : host_monitors_) {
     checkHostForUneject(host.first, host.second, now);
 
     // Need to update the writer bucket to keep the data valid.
@@ -755,7 +803,7 @@ void DetectorImpl::onIntervalTimer() {
   processSuccessRateEjections(DetectorHostMonitor::SuccessRateMonitorType::LocalOrigin);
 
   // Decrement time backoff for all hosts which have not been ejected.
-  for (auto host : host_monitors_) {
+  for (const auto& host : host_monitors_) {
     if (!host.first->healthFlagGet(Host::HealthFlag::FAILED_OUTLIER_CHECK)) {
       auto& monitor = host.second;
       // Node is healthy and was not ejected since the last check.
@@ -864,23 +912,26 @@ void EventLoggerImpl::setCommonEventParams(envoy::data::cluster::v3::OutlierDete
 
 SuccessRateAccumulatorBucket* SuccessRateAccumulator::updateCurrentWriter() {
   // Right now current is being written to and backup is not. Flush the backup and swap.
-  backup_success_rate_bucket_->success_request_counter_ = 0;
-  backup_success_rate_bucket_->total_request_counter_ = 0;
+  SuccessRateAccumulatorBucket& backup = buckets_[current_ ^ 1];
+  backup.success_request_counter_.store(0, std::memory_order_relaxed);
+  backup.total_request_counter_.store(0, std::memory_order_relaxed);
 
-  current_success_rate_bucket_.swap(backup_success_rate_bucket_);
+  current_ ^= 1;
 
-  return current_success_rate_bucket_.get();
+  return &buckets_[current_];
 }
 
 absl::optional<std::pair<double, uint64_t>> SuccessRateAccumulator::getSuccessRateAndVolume() {
-  if (!backup_success_rate_bucket_->total_request_counter_) {
+  const SuccessRateAccumulatorBucket& backup = buckets_[current_ ^ 1];
+  const uint64_t total = backup.total_request_counter_.load(std::memory_order_relaxed);
+  if (!total) {
     return absl::nullopt;
   }
 
-  double success_rate = backup_success_rate_bucket_->success_request_counter_ * 100.0 /
-                        backup_success_rate_bucket_->total_request_counter_;
+  double success_rate =
+      backup.success_request_counter_.load(std::memory_order_relaxed) * 100.0 / total;
 
-  return {{success_rate, backup_success_rate_bucket_->total_request_counter_}};
+  return {{success_rate, total}};
 }
 
 } // namespace Outlier
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <array>
 #include <atomic>
 #include <chrono>
 #include <cstdint>
@@ -62,9 +63,12 @@ struct SuccessRateAccumulatorBucket {
  */
 class SuccessRateAccumulator {
 public:
-  SuccessRateAccumulator()
-      : current_success_rate_bucket_(new SuccessRateAccumulatorBucket()),
-        backup_success_rate_bucket_(new SuccessRateAccumulatorBucket()) {}
+  SuccessRateAccumulator() {
+    for (auto& bucket : buckets_) {
+      bucket.success_request_counter_ = 0;
+      bucket.total_request_counter_ = 0;
+    }
+  }
 
   /**
    * This function updates the bucket to write data to.
@@ -83,8 +87,11 @@ public:
   absl::optional<std::pair<double, uint64_t>> getSuccessRateAndVolume();
 
 private:
-  std::unique_ptr<SuccessRateAccumulatorBucket> current_success_rate_bucket_;
-  std::unique_ptr<SuccessRateAccumulatorBucket> backup_success_rate_bucket_;
+  // Both buckets are stored inline so that the interval pass over all hosts does not
+  // chase two extra heap pointers per host. The workers write to buckets_[current_],
+  // the main thread reads the other one.
+  std::array<SuccessRateAccumulatorBucket, 2> buckets_;
+  uint32_t current_{0};
 };
 
 class SuccessRateMonitor {
@@ -100,9 +107,15 @@ public:
   void updateCurrentSuccessRateBucket() {
     success_rate_accumulator_bucket_.store(success_rate_accumulator_.updateCurrentWriter());
   }
-  void incTotalReqCounter() { success_rate_accumulator_bucket_.load()->total_request_counter_++; }
+  // Called by the workers for every request. Relaxed ordering is enough, the counters
+  // are only read by the main thread on the next interval after the writer was switched.
+  void incTotalReqCounter() {
+    success_rate_accumulator_bucket_.load(std::memory_order_relaxed)
+        ->total_request_counter_.fetch_add(1, std::memory_order_relaxed);
+  }
   void incSuccessReqCounter() {
-    success_rate_accumulator_bucket_.load()->success_request_counter_++;
+    success_rate_accumulator_bucket_.load(std::memory_order_relaxed)
+        ->success_request_counter_.fetch_add(1, std::memory_order_relaxed);
   }
 
   envoy::data::cluster::v3::OutlierEjectionType getEjectionType() const { return ejection_type_; }
@@ -131,6 +144,7 @@ public:
   void resetConsecutive5xx() { consecutive_5xx_ = 0; }
   void resetConsecutiveGatewayFailure() { consecutive_gateway_failure_ = 0; }
   void resetConsecutiveLocalOriginFailure() { consecutive_local_origin_failure_ = 0; }
+  void clearEjectionPending() { ejection_pending_.store(false, std::memory_order_relaxed); }
   static absl::optional<Http::Code> resultToHttpCode(Result result);
 
   // Upstream::Outlier::DetectorHostMonitor
@@ -157,6 +171,9 @@ public:
   double successRate(SuccessRateMonitorType type) const override {
     return getSRMonitor(type).getSuccessRate();
   }
+  bool ejectionPending() const override {
+    return ejection_pending_.load(std::memory_order_relaxed);
+  }
   void updateCurrentSuccessRateBucket();
   void successRate(SuccessRateMonitorType type, double new_success_rate) {
     getSRMonitor(type).setSuccessRate(new_success_rate);
@@ -190,6 +207,10 @@ private:
   // counters for local origin failures
   std::atomic<uint32_t> consecutive_local_origin_failure_{0};
 
+  // set on a worker when a consecutive error threshold is reached, cleared on the main thread
+  // once the ejection has been processed
+  std::atomic<bool> ejection_pending_{false};
+
   // jitter for outlier ejection time
   std::chrono::milliseconds jitter_;
 
@@ -201,6 +222,7 @@ private:
   SuccessRateMonitor external_origin_sr_monitor_;
   SuccessRateMonitor local_origin_sr_monitor_;
 
+  void setEjectionPending(DetectorImpl& detector);
   void putResultNoLocalExternalSplit(Result result, absl::optional<uint64_t> code);
   void putResultWithLocalExternalSplit(Result result, absl::optional<uint64_t> code);
   std::function<void(DetectorHostMonitorImpl*, Result, absl::optional<uint64_t> code)>
@@ -277,6 +299,7 @@ constexpr absl::string_view FailurePercentageThresholdRuntime =
     "outlier_detection.failure_percentage_threshold";
 constexpr absl::string_view MaxEjectionTimeJitterMsRuntime =
     "outlier_detection.max_ejection_time_jitter_ms";
+constexpr absl::string_view WorkerFastEjectionRuntime = "outlier_detection.worker_fast_ejection";
 
 /**
  * Configuration for the outlier detection.
@@ -413,6 +436,10 @@ public:
   successRateEjectionThreshold(double success_rate_sum,
                                const std::vector<HostSuccessRatePair>& valid_success_rate_hosts,
                                double success_rate_stdev_factor);
+  // Same on a contiguous array of success rates (used by the interval timer)
+  static EjectionPair successRateEjectionThreshold(double success_rate_sum,
+                                                   const std::vector<double>& success_rates,
+                                                   double success_rate_stdev_factor);
 
   const absl::node_hash_map<HostSharedPtr, DetectorHostMonitorImpl*>& getHostMonitors() {
     return host_monitors_;
@@ -839,7 +839,8 @@ void MainPrioritySetImpl::updateCrossPriorityHostMap(const HostVector& hosts_add
   // Since read_only_all_host_map_ may be shared by multiple threads, when the host set changes,
   // we cannot directly modify read_only_all_host_map_.
   if (mutable_cross_priority_host_map_ == nullptr) {
-    // Copy old read only host map to mutable host map.
+    // Copy old read only host map to mutable host map. The copy shares all chunks with the
+    // read only map, only the chunks touched by the update below are cloned.
     mutable_cross_priority_host_map_ = std::make_shared<HostMap>(*const_cross_priority_host_map_);
   }
 
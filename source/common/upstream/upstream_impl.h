@@ -178,6 +178,7 @@ public:
   const absl::optional<MonotonicTime>& lastEjectionTime() override { return time_; }
   const absl::optional<MonotonicTime>& lastUnejectionTime() override { return time_; }
   double successRate(SuccessRateMonitorType) const override { return -1; }
+  bool ejectionPending() const override { return false; }
 
 private:
   const absl::optional<MonotonicTime> time_{};
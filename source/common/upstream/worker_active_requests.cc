@@ -0,0 +1,65 @@
+#include "source/common/upstream/worker_active_requests.h"
+
+#include <algorithm>
+
+namespace Envoy {
+namespace Upstream {
+
+absl::flat_hash_map<const HostDescription*, WorkerActiveRequests::Counters>&
+WorkerActiveRequests::countersForCurrentThread() {
+  // The pools and load balancers of a worker only run on that worker, so the counters need no
+  // locking
+  thread_local absl::flat_hash_map<const HostDescription*, Counters> counters;
+  return counters;
+}
+
+void WorkerActiveRequests::onStreamAttached(const HostDescription& host) {
+  auto& counters = countersForCurrentThread();
+  if (counters.empty()) {
+    return;
+  }
+  auto it = counters.find(&host);
+  if (it == counters.end()) {
+    return;
+  }
+  for (uint32_t* counter : it->second) {
+    ++*counter;
+  }
+}
+
+void WorkerActiveRequests::onStreamClosed(const HostDescription& host) {
+  auto& counters = countersForCurrentThread();
+  if (counters.empty()) {
+    return;
+  }
+  auto it = counters.find(&host);
+  if (it == counters.end()) {
+    return;
+  }
+  for (uint32_t* counter : it->second) {
+    if (*counter > 0) {
+      --*counter;
+    }
+  }
+}
+
+void WorkerActiveRequests::addCounter(const HostDescription& host, uint32_t& counter) {
+  countersForCurrentThread()[&host].push_back(&counter);
+}
+
+void WorkerActiveRequests::removeCounter(const HostDescription& host, const uint32_t& counter) {
+  auto& counters = countersForCurrentThread();
+  auto it = counters.find(&host);
+  if (it == counters.end()) {
+    return;
+  }
+  Counters& host_counters = it->second;
+  host_counters.erase(std::remove(host_counters.begin(), host_counters.end(), &counter),
+                      host_counters.end());
+  if (host_counters.empty()) {
+    counters.erase(it);
+  }
+}
+
+} // namespace Upstream
+} // namespace Envoy
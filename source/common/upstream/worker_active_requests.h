@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstdint>
+
+#include "envoy/upstream/host_description.h"
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/container/inlined_vector.h"
+
+namespace Envoy {
+namespace Upstream {
+
+/**
+ * Worker-local mirror of the active requests of hosts. A load balancer that compares hosts by
+ * their active requests can add a counter per host, kept in an array it owns, instead of reading
+ * the host's rq_active gauge for every sample. The connection pools of the same worker update the
+ * added counters when a stream is attached to or closed on a connection to the host.
+ *
+ * The counters only count the requests of the worker they are added on. Streams attached before
+ * a counter was added are not counted, closing them leaves the counter at 0.
+ */
+class WorkerActiveRequests {
+public:
+  // Called by the connection pools.
+  static void onStreamAttached(const HostDescription& host);
+  static void onStreamClosed(const HostDescription& host);
+
+  // Called by the load balancers. The counter must not move until it is removed.
+  static void addCounter(const HostDescription& host, uint32_t& counter);
+  static void removeCounter(const HostDescription& host, const uint32_t& counter);
+
+private:
+  using Counters = absl::InlinedVector<uint32_t*, 2>;
+  static absl::flat_hash_map<const HostDescription*, Counters>& countersForCurrentThread();
+};
+
+} // namespace Upstream
+} // namespace Envoy
@@ -3,6 +3,7 @@
 #include "source/common/http/message_impl.h"
 #include "source/common/http/utility.h"
 #include "source/common/common/utility.h"
+#include "absl/container/flat_hash_set.h"
 #include "source/extensions/common/tap/utility.h"
 #include "source/extensions/filters/http/eric_proxy/filter.h"
 #include "source/extensions/filters/http/eric_proxy/eric_sbi_nf_peer_info/sbi_nf_peer_info_request_meta.h"
@@ -147,6 +148,7 @@ void EricProxyFilter::onNfDiscoveryFailure(Http::AsyncClient::FailureReason fail
 // Received a 200 OK from the NLF
 void EricProxyFilter::processNfDiscoveryOk(const std::string& body) {
   ENVOY_STREAM_LOG(trace, "processNfDiscoveryOk()", *decoder_callbacks_);
+  nf_discovery_result_.reset();
   // Decode the NF discovery result into a JSON object
   try {
     discovery_result_json_ = Json::parse(body);
@@ -208,11 +210,13 @@ void EricProxyFilter::processNfDiscoveryOk(const std::string& body) {
   default:
     break;  
   }
+  // Decode once for nf-selection-on-priority and a later remote routing
+  nf_discovery_result_ = decodeNfDiscoveryResult(discovery_result_json_, nf_disc_ip_version_);
 
   // User configured NF-selection-on-priority -> set preferred-host + nf-set-id
   if (deferred_lookup_action_->protoConfig().action_nf_discovery().has_nf_selection_on_priority()) {
     ENVOY_STREAM_LOG(trace, "nf selection on priority", *decoder_callbacks_);
-    const auto& selected_nf = selectNfOnPriority(discovery_result_json_, nf_disc_ip_version_);
+    const auto& selected_nf = selectNfOnPriority(*nf_discovery_result_);
     if (!selected_nf.ok()) {
       if (selected_nf.status().code() == absl::StatusCode::kInvalidArgument) {
         sendLocalReplyWithSpecificContentType(
@@ -240,9 +244,9 @@ void EricProxyFilter::processNfDiscoveryOk(const std::string& body) {
       nf_set_id_ = selected_nf->set_id.value();
     }
     if (config_->isNfPeerinfoActivated() && selected_nf->nfInstanceId.has_value()) {
-      ENVOY_STREAM_LOG(debug, "Setting the producer id to metadata", *decoder_callbacks_);
+      ENVOY_STREAM_LOG(debug, "Setting the producer id to the nf-peer-info state", *decoder_callbacks_);
       ENVOY_STREAM_LOG(trace, "Found selected_nf_id: {}", *decoder_callbacks_, selected_nf->nfInstanceId.value_or("empty"));
-      SbiNfPeerInfoHeaderRequestMetadata::updateDstInstInMetadata(decoder_callbacks_, selected_nf->nfInstanceId.value());
+      SbiNfPeerInfoHeaderRequestMetadata::updateDstInstInState(decoder_callbacks_, selected_nf->nfInstanceId.value());
     }
   }
   // If the user uses action-remote-round-robin, the extraction of TaR headers from
@@ -400,12 +404,151 @@ void EricProxyFilter::addToQueryString(std::string& query_string, absl::string_v
 }
 
 
+// Status of the first malformed value the endpoints of the NF service depend on:
+// the scheme, the IP endpoints, a host or a port
+const absl::Status& NfDiscoveryResult::endpointsStatus(size_t service) const {
+  const auto& scheme_status = service_scheme[service].status();
+  return scheme_status.ok() ? service_endpoints_status[service] : scheme_status;
+}
+
+// Status of the priority or, if that is valid, of the capacity of the NF service
+const absl::Status& NfDiscoveryResult::priorityAndCapacityStatus(size_t service) const {
+  const auto& priority_status = service_priority[service].status();
+  return priority_status.ok() ? service_capacity[service].status() : priority_status;
+}
+
+// Decode the NF discovery result once into packed arrays for the NF selection
+// routines. Hosts, port, scheme, api-prefix, priority, capacity and nf-set-id are
+// extracted with the same helper functions the selection used on the JSON before.
+// Malformed values only keep the status of their cause here, the selection routines
+// return it only if they reach the affected NF instance or NF service.
+NfDiscoveryResult EricProxyFilter::decodeNfDiscoveryResult(const Json& nlf_lookup_result,
+                                                           const IPver& ip_version) {
+  NfDiscoveryResult discovery_result;
+  discovery_result.ip_version = ip_version;
+
+  const auto& nf_instances = nlf_lookup_result.at("nfInstances");
+  discovery_result.instance_first_service.reserve(nf_instances.size() + 1);
+  discovery_result.instance_services_status.reserve(nf_instances.size());
+  discovery_result.instance_nf_set_id.reserve(nf_instances.size());
+  discovery_result.instance_nf_instance_id.reserve(nf_instances.size());
+  discovery_result.instance_first_service.push_back(0);
+  discovery_result.service_first_authority.push_back(0);
+
+  for (const auto& nf_instance : nf_instances) {
+    absl::Status services_status;
+    if (nf_instance.contains("nfServiceList")) {
+      const auto& nf_service_list = nf_instance.at("nfServiceList");
+      // Invalid NF service list
+      if (!nf_service_list.is_object()) {
+        services_status = absl::InvalidArgumentError("Invalid NF service list");
+      } else {
+        for (const auto& nf_service : nf_service_list.items()) {
+          decodeNfService(nf_instance, nf_service.value(), discovery_result);
+        }
+      }
+    } else if (nf_instance.contains("nfServices")) {
+      const auto& nf_services = nf_instance.at("nfServices");
+      // Invalid NF services
+      if (!nf_services.is_array()) {
+        services_status = absl::InvalidArgumentError("Invalid NF services");
+      } else {
+        for (const auto& nf_service : nf_services) {
+          decodeNfService(nf_instance, nf_service, discovery_result);
+        }
+      }
+    }
+
+    discovery_result.instance_nf_set_id.push_back(getNfSetIdForEndpoint(nf_instance));
+    discovery_result.instance_nf_instance_id.push_back(getNfInstanceIdForEndpoint(nf_instance));
+    discovery_result.instance_services_status.push_back(std::move(services_status));
+    discovery_result.instance_first_service.push_back(discovery_result.service_scheme.size());
+  }
+
+  return discovery_result;
+}
+
+// Decode one NF service of an NF instance and append it to the discovery result.
+// For an NF service without IP endpoints only the first host is kept, that is
+// the only one the selection routines consider.
+void EricProxyFilter::decodeNfService(const Json& nf_instance, const Json& nf_service,
+                                      NfDiscoveryResult& discovery_result) {
+  auto scheme = getSchemeForEndpoint(nf_service);
+  bool has_ip_endpoints = false;
+  absl::Status endpoints_status;
+
+  auto& authorities = discovery_result.authorities;
+  const size_t first_authority = authorities.size();
+  // Appends "host:port" for the endpoint. Endpoints without host or port are skipped,
+  // returns the status of the host or port if the endpoint is malformed.
+  const auto append_authorities = [&](const Json* ip_endpoint, bool front_only) -> absl::Status {
+    const auto& host_list = getHostListForEndpoints(nf_instance, nf_service,
+      discovery_result.ip_version, ip_endpoint);
+    if (!host_list.ok()) {
+      return host_list.status().code() == absl::StatusCode::kInvalidArgument ?
+        host_list.status() : absl::OkStatus();
+    }
+    if (host_list.value().empty()) {
+      return absl::OkStatus();
+    }
+    const auto& port = getPortForEndpoint(nf_service, ip_endpoint);
+    if (!port.ok()) {
+      return port.status().code() == absl::StatusCode::kInvalidArgument ?
+        port.status() : absl::OkStatus();
+    }
+    for (const auto& host : host_list.value()) {
+      authorities.push_back(absl::StrCat(host, ":", port.value()));
+      if (front_only) {
+        break;
+      }
+    }
+    return absl::OkStatus();
+  };
+
+  // The default port depends on the scheme, so hosts are only extracted for a valid one
+  if (scheme.ok()) {
+    if (nf_service.contains("ipEndPoints")) {
+      has_ip_endpoints = true;
+      const auto& ip_endpoints = nf_service.at("ipEndPoints");
+      // Invalid IP endpoints
+      if (!ip_endpoints.is_array()) {
+        endpoints_status = absl::InvalidArgumentError("Invalid IP endpoints");
+      } else {
+        for (const auto& ip_endpoint : ip_endpoints) {
+          endpoints_status = append_authorities(&ip_endpoint, false);
+          if (!endpoints_status.ok()) {
+            break;
+          }
+        }
+      }
+    } else {
+      endpoints_status = append_authorities(nullptr, true);
+    }
+    if (!endpoints_status.ok()) {
+      authorities.resize(first_authority);
+    }
+  }
+
+  discovery_result.service_scheme.push_back(std::move(scheme));
+  discovery_result.service_api_prefix.push_back(getApiPrefixForEndpoint(nf_service));
+  discovery_result.service_endpoints_status.push_back(std::move(endpoints_status));
+  discovery_result.service_has_ip_endpoints.push_back(has_ip_endpoints);
+  discovery_result.service_priority.push_back(getPriorityForEndpoint(nf_instance, nf_service));
+  discovery_result.service_capacity.push_back(getCapacityForEndpoint(nf_instance, nf_service));
+  discovery_result.service_first_authority.push_back(authorities.size());
+}
+
 // Extract constraints parameters (preferred host + port and nf-set-id)
 // from NLF lookup result on reception of initial request.
 // The parameter nlf_lookup_result exists (instead of using discovery_result_json_)
 // so that we can have unit tests for this function.
 absl::StatusOr<NfInstance>
 EricProxyFilter::selectNfOnPriority(const Json& nlf_lookup_result, const IPver& ip_version) {
+  return selectNfOnPriority(decodeNfDiscoveryResult(nlf_lookup_result, ip_version));
+}
+
+absl::StatusOr<NfInstance>
+EricProxyFilter::selectNfOnPriority(const NfDiscoveryResult& discovery_result) {
   // Find high priority endpoints including hostnames and
   // corresponding nf-set-ids with capacities on highest
   // priority level from NLF lookup result.
@@ -419,57 +562,79 @@ EricProxyFilter::selectNfOnPriority(const Json& nlf_lookup_result, const IPver&
   // endpoint would be considered for selection.
   // If IP endpoint is not present then only create endpoint
   // from NF service level attributes.
-  std::pair<std::vector<NfInstance>,
-  std::vector<uint64_t /*Cumulative capacity*/>> high_priority_endpoints;
-  std::set<std::string> unique_hostnames;
+  // Candidates are kept as indexes into the discovery result, the
+  // NfInstance is only created for the selected one.
+  std::vector<std::pair<uint32_t /*Instance*/, uint32_t /*Authority*/>> high_priority_endpoints;
+  std::vector<uint64_t /*Cumulative capacity*/> cumulative_capacity_list;
+  absl::flat_hash_set<absl::string_view> unique_hostnames;
+  std::vector<uint32_t> hostnames;
   uint64_t max_priority = 65535;
 
-  for (const auto& nf_instance : nlf_lookup_result.at("nfInstances")) {
-    if (nf_instance.contains("nfServiceList")) {
-      // Invalid NF service list
-      // ULID(A16)
-      if (!nf_instance.at("nfServiceList").is_object()) {
-        ENVOY_LOG(trace, "Invalid NF service list");
-        return absl::InvalidArgumentError("Invalid NF service list");
+  for (uint32_t instance = 0; instance < discovery_result.numInstances(); instance++) {
+    // Invalid NF service list or NF services
+    // ULID(A16) ULID(A18)
+    const auto& services_status = discovery_result.instance_services_status[instance];
+    if (!services_status.ok()) {
+      ENVOY_LOG(trace, "{}", services_status.message());
+      return services_status;
+    }
+    for (uint32_t service = discovery_result.instance_first_service[instance];
+         service < discovery_result.instance_first_service[instance + 1]; service++) {
+      // ULID(A17) ULID(A19)
+      const auto& endpoints_status = discovery_result.endpointsStatus(service);
+      if (!endpoints_status.ok()) {
+        return endpoints_status;
       }
-      if (nf_instance.at("nfServiceList").empty()) {
+      const uint32_t first = discovery_result.service_first_authority[service];
+      const uint32_t last = discovery_result.service_first_authority[service + 1];
+      const bool has_ip_endpoints = discovery_result.service_has_ip_endpoints[service];
+      hostnames.clear();
+      if (has_ip_endpoints) {
+        for (uint32_t authority = first; authority < last; authority++) {
+          if (unique_hostnames.insert(discovery_result.authorities[authority]).second) {
+            hostnames.push_back(authority);
+          }
+        }
+      } else if (first != last && !unique_hostnames.contains(discovery_result.authorities[first])) {
+        hostnames.push_back(first);
+      }
+      if (hostnames.empty()) {
         continue;
       }
-      for (const auto& nf_service : nf_instance.at("nfServiceList").items()) {
-        const auto& status = getHighPriorityEndpointsFromNfService(
-          nf_instance, nf_service.value(), ip_version, high_priority_endpoints,
-          unique_hostnames, max_priority
-        );
-        if (!status.ok()) {
-          // ULID(A17)
-          return status;
-        }
+      const auto& nf_set = discovery_result.instance_nf_set_id[instance];
+      if (!nf_set.ok() && nf_set.status().code() == absl::StatusCode::kInvalidArgument) {
+        return nf_set.status();
       }
-    } else if (nf_instance.contains("nfServices")) {
-      // Invalid NF services
-      // ULID(A18)
-      if (!nf_instance.at("nfServices").is_array()) {
-        ENVOY_LOG(trace, "Invalid NF services");
-        return absl::InvalidArgumentError("Invalid NF services");
+      const auto& priority_capacity_status = discovery_result.priorityAndCapacityStatus(service);
+      if (!priority_capacity_status.ok()) {
+        return priority_capacity_status;
       }
-      if (nf_instance.at("nfServices").empty()) {
-        continue;
+      const uint64_t priority = discovery_result.service_priority[service].value();
+      const uint64_t capacity = discovery_result.service_capacity[service].value();
+      const uint64_t individual_capacity = has_ip_endpoints ? capacity / hostnames.size() : capacity;
+      // Without IP endpoints a hostname is only reserved once it is a candidate
+      if (!has_ip_endpoints && priority <= max_priority) {
+        unique_hostnames.insert(discovery_result.authorities[first]);
       }
-      for (const auto& nf_service : nf_instance.at("nfServices")) {
-        const auto& status = getHighPriorityEndpointsFromNfService(
-          nf_instance, nf_service, ip_version, high_priority_endpoints,
-          unique_hostnames, max_priority
-        );
-        if (!status.ok()) {
-          // ULIDA19)
-          return status;
+      for (const auto authority : hostnames) {
+        if (priority == max_priority) {
+          high_priority_endpoints.emplace_back(instance, authority);
+          cumulative_capacity_list.push_back(cumulative_capacity_list.empty() ? individual_capacity :
+            cumulative_capacity_list.back() + individual_capacity);
+        }
+        if (priority < max_priority) {
+          high_priority_endpoints.clear();
+          cumulative_capacity_list.clear();
+          high_priority_endpoints.emplace_back(instance, authority);
+          cumulative_capacity_list.push_back(individual_capacity);
+          max_priority = priority;
         }
       }
     }
   }
 
   // No endpoints are found in NLF lookup result
-  if (high_priority_endpoints.first.empty()) {
+  if (high_priority_endpoints.empty()) {
     // ULID(A20)
     ENVOY_LOG(trace, "No endpoints are found in NLF lookup result");
     return absl::NotFoundError("No endpoints are found in NLF lookup result");
@@ -480,27 +645,28 @@ EricProxyFilter::selectNfOnPriority(const Json& nlf_lookup_result, const IPver&
   // If there is only one endpoint in high priority endpoints, then
   // that endpoint will be selected and further process based on
   // capacity or weight will not be continued.
-  if (high_priority_endpoints.first.size() == 1) {
-    ENVOY_LOG(trace, "pref_host: '{}', nf-set-id: '{}'",
-      high_priority_endpoints.first.front().hostname.value_or("empty"),
-      high_priority_endpoints.first.front().set_id.value_or("empty")
-    );
-    return high_priority_endpoints.first.front();
+  uint32_t selected = 0;
+  if (high_priority_endpoints.size() > 1) {
+    const auto& selected_idx = randomSelectionByWeight(cumulative_capacity_list);
+    if (!selected_idx.has_value()) {
+      ENVOY_LOG(trace, "No endpoints were selected");
+      return absl::NotFoundError("No endpoints were selected");
+    }
+    selected = selected_idx.value();
   }
 
-  const auto& cumulative_capacity_list = high_priority_endpoints.second;
-  const auto& selected_idx = randomSelectionByWeight(cumulative_capacity_list);
-  if (!selected_idx.has_value()) {
-    ENVOY_LOG(trace, "No endpoints were selected");
-    return absl::NotFoundError("No endpoints were selected");
+  const auto [instance, authority] = high_priority_endpoints[selected];
+  NfInstance selected_nf;
+  selected_nf.hostname = discovery_result.authorities[authority];
+  if (discovery_result.instance_nf_set_id[instance].ok()) {
+    selected_nf.set_id = discovery_result.instance_nf_set_id[instance].value();
   }
+  selected_nf.nfInstanceId = discovery_result.instance_nf_instance_id[instance];
 
   ENVOY_LOG(trace, "pref_host: '{}', nf-set-id: '{}'",
-    high_priority_endpoints.first.at(selected_idx.value()).hostname.value_or("empty"),
-    high_priority_endpoints.first.at(selected_idx.value()).set_id.value_or("empty")
+    selected_nf.hostname.value_or("empty"), selected_nf.set_id.value_or("empty")
   );
-
-  return high_priority_endpoints.first.at(selected_idx.value());
+  return selected_nf;
 }
 
 // Extract list of TaRs from NLF lookup result for remote routing.
@@ -526,6 +692,17 @@ absl::StatusOr<std::vector<std::string>> EricProxyFilter::selectTarsForRemoteRou
   const absl::optional<std::string>& nf_set_id,
   const absl::optional<uint32_t>& num_retries,
   const absl::optional<std::string>& preferred_tar
+) {
+  return selectTarsForRemoteRouting(decodeNfDiscoveryResult(nlf_lookup_result, ip_version),
+    num_reselections, nf_set_id, num_retries, preferred_tar);
+}
+
+absl::StatusOr<std::vector<std::string>> EricProxyFilter::selectTarsForRemoteRouting(
+  const NfDiscoveryResult& discovery_result,
+  const uint32_t& num_reselections,
+  const absl::optional<std::string>& nf_set_id,
+  const absl::optional<uint32_t>& num_retries,
+  const absl::optional<std::string>& preferred_tar
 ) {
   std::vector<std::string> selected_tar_list;
 
@@ -543,56 +720,83 @@ absl::StatusOr<std::vector<std::string>> EricProxyFilter::selectTarsForRemoteRou
   // from NF service level attributes.
   std::map<uint64_t /*Priority*/, std::pair<std::vector<std::string /*TaR*/>,
   std::vector<uint64_t /*Cumulative capacity*/>>> priority_levels;
-  std::set<std::string> unique_tars;
+  absl::flat_hash_set<std::string> unique_tars;
+  std::vector<std::string> tars;
 
-  for (const auto& nf_instance : nlf_lookup_result.at("nfInstances")) {
+  for (uint32_t instance = 0; instance < discovery_result.numInstances(); instance++) {
     if (nf_set_id.has_value()) {
-      const auto& nf_set = getNfSetIdForEndpoint(nf_instance);
+      const auto& nf_set = discovery_result.instance_nf_set_id[instance];
       if (!nf_set.ok()) {
         if (nf_set.status().code() == absl::StatusCode::kInvalidArgument) {
           return nf_set.status();
         }
-      } else {
-        if (nf_set_id.value() != nf_set.value()) {
-          continue;
-        }
+      } else if (nf_set_id.value() != nf_set.value()) {
+        continue;
       }
     }
-    if (nf_instance.contains("nfServiceList")) {
-      // Invalid NF service list
-      if (!nf_instance.at("nfServiceList").is_object()) {
-        ENVOY_LOG(trace, "Invalid NF service list");
-        return absl::InvalidArgumentError("Invalid NF service list");
+    // Invalid NF service list or NF services
+    const auto& services_status = discovery_result.instance_services_status[instance];
+    if (!services_status.ok()) {
+      ENVOY_LOG(trace, "{}", services_status.message());
+      return services_status;
+    }
+    for (uint32_t service = discovery_result.instance_first_service[instance];
+         service < discovery_result.instance_first_service[instance + 1]; service++) {
+      // Every TaR of the NF service contains the scheme and the api prefix
+      const auto& scheme_status = discovery_result.service_scheme[service].status();
+      if (!scheme_status.ok()) {
+        return scheme_status;
       }
-      if (nf_instance.at("nfServiceList").empty()) {
-        continue;
+      const auto& api_prefix_status = discovery_result.service_api_prefix[service].status();
+      if (!api_prefix_status.ok()) {
+        return api_prefix_status;
       }
-      for (const auto& nf_service : nf_instance.at("nfServiceList").items()) {
-        const auto& status = getPriorityLevelsFromNfService(
-          nf_instance, nf_service.value(), ip_version, priority_levels,
-          unique_tars, preferred_tar
-        );
-        if (!status.ok()) {
-          return status;
-        }
+      const auto& endpoints_status = discovery_result.service_endpoints_status[service];
+      if (!endpoints_status.ok()) {
+        return endpoints_status;
       }
-    } else if (nf_instance.contains("nfServices")) {
-      // Invalid NF services
-      if (!nf_instance.at("nfServices").is_array()) {
-        ENVOY_LOG(trace, "Invalid NF services");
-        return absl::InvalidArgumentError("Invalid NF services");
+      const uint32_t first = discovery_result.service_first_authority[service];
+      const uint32_t last = discovery_result.service_first_authority[service + 1];
+      const bool has_ip_endpoints = discovery_result.service_has_ip_endpoints[service];
+      const auto& scheme = discovery_result.service_scheme[service].value();
+      const auto& api_prefix = discovery_result.service_api_prefix[service].value();
+      tars.clear();
+      if (has_ip_endpoints) {
+        for (uint32_t authority = first; authority < last; authority++) {
+          auto tar = absl::StrCat(scheme, "://", discovery_result.authorities[authority], api_prefix);
+          if (preferred_tar.has_value() && tar == preferred_tar.value()) {
+            continue;
+          }
+          if (!unique_tars.insert(tar).second) {
+            continue;
+          }
+          tars.push_back(std::move(tar));
+        }
+      } else if (first != last) {
+        auto tar = absl::StrCat(scheme, "://", discovery_result.authorities[first], api_prefix);
+        if (!unique_tars.contains(tar) &&
+            !(preferred_tar.has_value() && tar == preferred_tar.value())) {
+          tars.push_back(std::move(tar));
+        }
       }
-      if (nf_instance.at("nfServices").empty()) {
+      if (tars.empty()) {
         continue;
       }
-      for (const auto& nf_service : nf_instance.at("nfServices")) {
-        const auto& status = getPriorityLevelsFromNfService(
-          nf_instance, nf_service, ip_version, priority_levels,
-          unique_tars, preferred_tar
-        );
-        if (!status.ok()) {
-          return status;
-        }
+      const auto& priority_capacity_status = discovery_result.priorityAndCapacityStatus(service);
+      if (!priority_capacity_status.ok()) {
+        return priority_capacity_status;
+      }
+      const uint64_t capacity = discovery_result.service_capacity[service].value();
+      const uint64_t individual_capacity = has_ip_endpoints ? capacity / tars.size() : capacity;
+      // Without IP endpoints a TaR is only reserved once it is added
+      if (!has_ip_endpoints) {
+        unique_tars.insert(tars.front());
+      }
+      auto& priority_level = priority_levels[discovery_result.service_priority[service].value()];
+      for (auto& tar : tars) {
+        priority_level.first.push_back(std::move(tar));
+        priority_level.second.push_back(priority_level.second.empty() ? individual_capacity :
+          priority_level.second.back() + individual_capacity);
       }
     }
   }
@@ -648,242 +852,6 @@ absl::StatusOr<std::vector<std::string>> EricProxyFilter::selectTarsForRemoteRou
   return selected_tar_list;
 }
 
-absl::Status EricProxyFilter::getHighPriorityEndpointsFromNfService(
-  const Json& nf_instance, const Json& nf_service, const IPver& ip_version,
-  std::pair<std::vector<NfInstance>, std::vector<uint64_t>>& high_priority_endpoints,
-  std::set<std::string>& unique_hostnames, uint64_t& max_priority
-) {
-  const auto& scheme = getSchemeForEndpoint(nf_service);
-  if (!scheme.ok()) {
-    return scheme.status();
-  }
-  if (nf_service.contains("ipEndPoints")) {
-    // Invalid IP endpoints
-    if (!nf_service.at("ipEndPoints").is_array()) {
-      ENVOY_LOG(trace, "Invalid IP endpoints");
-      return absl::InvalidArgumentError("Invalid IP endpoints");
-    }
-    if (nf_service.at("ipEndPoints").empty()) {
-      return absl::OkStatus();
-    }
-    std::vector<std::string> hostnames;
-    for (const auto& ip_endpoint : nf_service.at("ipEndPoints")) {
-      const auto& hostname_list = getHostnameListForEndpoints(nf_instance,
-        nf_service, ip_version, ip_endpoint);
-      if (!hostname_list.ok()) {
-        if (hostname_list.status().code() == absl::StatusCode::kInvalidArgument) {
-          return hostname_list.status();
-        }
-        continue;
-      }
-      for (const auto& hostname : hostname_list.value()) {
-        if (!unique_hostnames.insert(hostname).second) {
-          continue;
-        }
-        hostnames.push_back(hostname);
-      }
-    }
-    if (hostnames.empty()) {
-      return absl::OkStatus();
-    }
-    absl::optional<std::string> nf_set_id = absl::nullopt;
-    const auto& nf_set = getNfSetIdForEndpoint(nf_instance);
-    if (!nf_set.ok()) {
-      if (nf_set.status().code() == absl::StatusCode::kInvalidArgument) {
-        return nf_set.status();
-      }
-    } else {
-      nf_set_id = nf_set.value();
-    }
-    const auto& priority = getPriorityForEndpoint(nf_instance, nf_service);
-    if (!priority.ok()) {
-      return priority.status();
-    }
-    const auto& capacity = getCapacityForEndpoint(nf_instance, nf_service);
-    if (!capacity.ok()) {
-      return capacity.status();
-    }
-    const uint64_t individual_capacity = capacity.value() / hostnames.size();
-    for (const auto& hostname : hostnames) {
-      if (priority.value() == max_priority) {
-        high_priority_endpoints.first.push_back({hostname, nf_set_id, getNfInstanceIdForEndpoint(nf_instance)});
-        if (high_priority_endpoints.second.empty()) {
-          high_priority_endpoints.second.push_back(individual_capacity);
-        } else {
-          const auto& prev_cumulative_capacity = high_priority_endpoints.second.back();
-          high_priority_endpoints.second.push_back(prev_cumulative_capacity + individual_capacity);
-        }
-      }
-      if (priority.value() < max_priority) {
-        high_priority_endpoints.first.clear();
-        high_priority_endpoints.second.clear();
-        high_priority_endpoints.first.push_back({hostname, nf_set_id, getNfInstanceIdForEndpoint(nf_instance)});
-        high_priority_endpoints.second.push_back(individual_capacity);
-        max_priority = priority.value();
-      }
-    }
-  } else {
-    const auto& hostname_list = getHostnameListForEndpoints(nf_instance,
-      nf_service, ip_version);
-    if (!hostname_list.ok()) {
-      if (hostname_list.status().code() == absl::StatusCode::kInvalidArgument) {
-        return hostname_list.status();
-      }
-      return absl::OkStatus();
-    }
-    if (hostname_list.value().empty()) {
-      return absl::OkStatus();
-    }
-    const auto& hostname = hostname_list.value().front();
-    if (unique_hostnames.find(hostname) != unique_hostnames.end()) {
-      return absl::OkStatus();
-    }
-    absl::optional<std::string> nf_set_id = absl::nullopt;
-    const auto& nf_set = getNfSetIdForEndpoint(nf_instance);
-    if (!nf_set.ok()) {
-      if (nf_set.status().code() == absl::StatusCode::kInvalidArgument) {
-        return nf_set.status();
-      }
-    } else {
-      nf_set_id = nf_set.value();
-    }
-    const auto& priority = getPriorityForEndpoint(nf_instance, nf_service);
-    if (!priority.ok()) {
-      return priority.status();
-    }
-    const auto& capacity = getCapacityForEndpoint(nf_instance, nf_service);
-    if (!capacity.ok()) {
-      return capacity.status();
-    }
-    if (priority.value() == max_priority) {
-      high_priority_endpoints.first.push_back({hostname, nf_set_id, getNfInstanceIdForEndpoint(nf_instance)});
-      if (high_priority_endpoints.second.empty()) {
-        high_priority_endpoints.second.push_back(capacity.value());
-      } else {
-        const auto& prev_cumulative_capacity = high_priority_endpoints.second.back();
-        high_priority_endpoints.second.push_back(prev_cumulative_capacity + capacity.value());
-      }
-      unique_hostnames.insert(hostname);
-    }
-    if (priority.value() < max_priority) {
-      high_priority_endpoints.first.clear();
-      high_priority_endpoints.second.clear();
-      high_priority_endpoints.first.push_back({hostname, nf_set_id, getNfInstanceIdForEndpoint(nf_instance)});
-      high_priority_endpoints.second.push_back(capacity.value());
-      unique_hostnames.insert(hostname);
-      max_priority = priority.value();
-    }
-  }
-
-  return absl::OkStatus();
-}
-
-absl::Status EricProxyFilter::getPriorityLevelsFromNfService(
-  const Json& nf_instance, const Json& nf_service, const IPver& ip_version,
-  std::map<uint64_t, std::pair<std::vector<std::string>,
-  std::vector<uint64_t>>>& priority_levels, std::set<std::string>& unique_tars,
-  const absl::optional<std::string>& preferred_tar
-) {
-  const auto& scheme = getSchemeForEndpoint(nf_service);
-  const auto& api_prefix = getApiPrefixForEndpoint(nf_service);
-  if (!scheme.ok()) {
-    return scheme.status();
-  }
-  if (nf_service.contains("ipEndPoints")) {
-    // Invalid IP endpoints
-    if (!nf_service.at("ipEndPoints").is_array()) {
-      ENVOY_LOG(trace, "Invalid IP endpoints");
-      return absl::InvalidArgumentError("Invalid IP endpoints");
-    }
-    if (nf_service.at("ipEndPoints").empty()) {
-      return absl::OkStatus();
-    }
-    std::vector<std::string> tars;
-    for (const auto& ip_endpoint : nf_service.at("ipEndPoints")) {
-      const auto& tar_list = getTarListForEndpoints(scheme.value(),api_prefix.value(), nf_instance,
-      nf_service, ip_version, ip_endpoint);
-      if (!tar_list.ok()) {
-        if (tar_list.status().code() == absl::StatusCode::kInvalidArgument) {
-          return tar_list.status();
-        }
-        continue;
-      }
-      for (const auto& tar : tar_list.value()) {
-        if (preferred_tar.has_value() && tar == preferred_tar.value()) {
-          continue;
-        }
-        if (!unique_tars.insert(tar).second) {
-          continue;
-        }
-        tars.push_back(tar);
-      }
-    }
-    if (tars.empty()) {
-      return absl::OkStatus();
-    }
-    const auto& priority = getPriorityForEndpoint(nf_instance, nf_service);
-    if (!priority.ok()) {
-      return priority.status();
-    }
-    const auto& capacity = getCapacityForEndpoint(nf_instance, nf_service);
-    if (!capacity.ok()) {
-      return capacity.status();
-    }
-    const uint64_t individual_capacity = capacity.value() / tars.size();
-    for (const auto& tar : tars) {
-      if (priority_levels.find(priority.value()) != priority_levels.end()) {
-        priority_levels.at(priority.value()).first.push_back(tar);
-        const auto& prev_cumulative_capacity = priority_levels.at(priority.value()).second.back();
-        priority_levels.at(priority.value()).second.push_back(prev_cumulative_capacity + individual_capacity);
-      } else {
-        priority_levels[priority.value()] = std::make_pair(
-          std::vector<std::string> {tar}, std::vector<uint64_t> {individual_capacity}
-        );
-      }
-    }
-  } else {
-    const auto& tar_list = getTarListForEndpoints(scheme.value(),api_prefix.value(), nf_instance,
-    nf_service, ip_version);
-    if (!tar_list.ok()) {
-      if (tar_list.status().code() == absl::StatusCode::kInvalidArgument) {
-        return tar_list.status();
-      }
-      return absl::OkStatus();
-    }
-    if (tar_list.value().empty()) {
-      return absl::OkStatus();
-    }
-    const auto& tar = tar_list.value().front();
-    if (unique_tars.find(tar) != unique_tars.end()) {
-      return absl::OkStatus();
-    }
-    if (preferred_tar.has_value() && tar == preferred_tar.value()) {
-      return absl::OkStatus();
-    }
-    const auto& priority = getPriorityForEndpoint(nf_instance, nf_service);
-    if (!priority.ok()) {
-      return priority.status();
-    }
-    const auto& capacity = getCapacityForEndpoint(nf_instance, nf_service);
-    if (!capacity.ok()) {
-      return capacity.status();
-    }
-    if (priority_levels.find(priority.value()) != priority_levels.end()) {
-      priority_levels.at(priority.value()).first.push_back(tar);
-      const auto& prev_cumulative_capacity = priority_levels.at(priority.value()).second.back();
-      priority_levels.at(priority.value()).second.push_back(prev_cumulative_capacity + capacity.value());
-      unique_tars.insert(tar);
-    } else {
-      priority_levels[priority.value()] = std::make_pair(
-        std::vector<std::string> {tar}, std::vector<uint64_t> {capacity.value()}
-      );
-      unique_tars.insert(tar);
-    }
-  }
-
-  return absl::OkStatus();
-}
-
 // Find scheme for the endpoint from NF service level
 absl::StatusOr<std::string> EricProxyFilter::getSchemeForEndpoint(const Json& nf_service) {
   // NF service does not contain scheme
@@ -913,61 +881,13 @@ absl::StatusOr<std::string> EricProxyFilter::getApiPrefixForEndpoint(const Json&
     return absl::StatusOr<std::string>("");
   }
 
-  return nf_service.at("apiPrefix");
-}
-
-// Find hostname for the endpoint
-absl::StatusOr<std::vector<std::string>> EricProxyFilter::getHostnameListForEndpoints(
-  const Json& nf_instance, const Json& nf_service,
-  const IPver& ip_version, const absl::optional<Json>& ip_endpoint
-) {
-  std::vector<std::string> hostname_list;
-  const auto& host_list = getHostListForEndpoints(nf_instance, nf_service, ip_version, ip_endpoint);
-  if (!host_list.ok()) {
-    return host_list.status();
-  }
-
-  if (host_list.value().empty()) {
-    return hostname_list;
-  }
-
-  const auto& port = getPortForEndpoint(nf_service, ip_endpoint);
-  if (!port.ok()) {
-    return port.status();
-  }
-
-  for (const auto& host : host_list.value()) {
-    hostname_list.push_back(absl::StrCat(host, ":", port.value()));
+  // Invalid api-prefix
+  if (!nf_service.at("apiPrefix").is_string()) {
+    ENVOY_LOG(trace, "Invalid api Prefix");
+    return absl::InvalidArgumentError("Invalid api Prefix");
   }
 
-  return hostname_list;
-}
-
-// Find TaR for the endpoint
-absl::StatusOr<std::vector<std::string>> EricProxyFilter::getTarListForEndpoints(
-  const std::string& scheme, const std::string& api_prefix, const Json& nf_instance, const Json& nf_service,
-  const IPver& ip_version, const absl::optional<Json>& ip_endpoint
-) {
-  std::vector<std::string> tar_list;
-  const auto& host_list = getHostListForEndpoints(nf_instance, nf_service, ip_version, ip_endpoint);
-  if (!host_list.ok()) {
-    return host_list.status();
-  }
-
-  if (host_list.value().empty()) {
-    return tar_list;
-  }
-
-  const auto& port = getPortForEndpoint(nf_service, ip_endpoint);
-  if (!port.ok()) {
-    return port.status();
-  }
-
-  for (const auto& host : host_list.value()) {
-    tar_list.push_back(absl::StrCat(scheme, "://", host, ":", port.value(),api_prefix));
-  }  
-
-  return tar_list;
+  return nf_service.at("apiPrefix");
 }
 
 // Find list of hosts for the endpoints where FQDN should
@@ -990,7 +910,7 @@ absl::StatusOr<std::vector<std::string>> EricProxyFilter::getTarListForEndpoints
 // should be ignored.
 absl::StatusOr<std::vector<std::string>> EricProxyFilter::getHostListForEndpoints(
   const Json& nf_instance, const Json& nf_service,
-  const IPver& ip_version, const absl::optional<Json>& ip_endpoint
+  const IPver& ip_version, const Json* ip_endpoint
 ) {
   std::vector<std::string> host_list;
   if (nf_service.contains("fqdn")) {
@@ -1015,15 +935,15 @@ absl::StatusOr<std::vector<std::string>> EricProxyFilter::getHostListForEndpoint
 
   if (ip_version == IPver::IPv4) {
     if (
-      ip_endpoint.has_value() &&
-      ip_endpoint.value().contains("ipv4Address")      
+      ip_endpoint != nullptr &&
+      ip_endpoint->contains("ipv4Address")      
     ) {
       // Invalid ipv4Address
-      if (!ip_endpoint.value().at("ipv4Address").is_string()) {
+      if (!ip_endpoint->at("ipv4Address").is_string()) {
         ENVOY_LOG(trace, "Invalid ipv4Address");
         return absl::InvalidArgumentError("Invalid ipv4Address");
       }
-      host_list.push_back(ip_endpoint.value().at("ipv4Address"));
+      host_list.push_back(ip_endpoint->at("ipv4Address"));
       return host_list;
     }
 
@@ -1050,15 +970,15 @@ absl::StatusOr<std::vector<std::string>> EricProxyFilter::getHostListForEndpoint
   
   if (ip_version == IPver::IPv6) {
     if (
-      ip_endpoint.has_value() &&
-      ip_endpoint.value().contains("ipv6Address")
+      ip_endpoint != nullptr &&
+      ip_endpoint->contains("ipv6Address")
     ) {
       // Invalid ipv6Address
-      if (!ip_endpoint.value().at("ipv6Address").is_string()) {
+      if (!ip_endpoint->at("ipv6Address").is_string()) {
         ENVOY_LOG(trace, "Invalid ipv6Address");
         return absl::InvalidArgumentError("Invalid ipv6Address");
       }
-      const std::string& ipv6_address = ip_endpoint.value().at("ipv6Address");
+      const std::string& ipv6_address = ip_endpoint->at("ipv6Address");
       host_list.push_back(absl::StrCat("[", ipv6_address, "]"));
       return host_list;
     }
@@ -1086,26 +1006,26 @@ absl::StatusOr<std::vector<std::string>> EricProxyFilter::getHostListForEndpoint
 
   if (ip_version == IPver::DualStack) {
     if (
-      ip_endpoint.has_value() &&
-      ip_endpoint.value().contains("ipv4Address")
+      ip_endpoint != nullptr &&
+      ip_endpoint->contains("ipv4Address")
     ) {
       // Invalid ipv4Address
-      if (!ip_endpoint.value().at("ipv4Address").is_string()) {
+      if (!ip_endpoint->at("ipv4Address").is_string()) {
         ENVOY_LOG(trace, "Invalid ipv4Address");
         return absl::InvalidArgumentError("Invalid ipv4Address");
       }
-      host_list.push_back(ip_endpoint.value().at("ipv4Address"));
+      host_list.push_back(ip_endpoint->at("ipv4Address"));
     }
     if (
-      ip_endpoint.has_value() &&
-      ip_endpoint.value().contains("ipv6Address")
+      ip_endpoint != nullptr &&
+      ip_endpoint->contains("ipv6Address")
     ) {
       // Invalid ipv6Address
-      if (!ip_endpoint.value().at("ipv6Address").is_string()) {
+      if (!ip_endpoint->at("ipv6Address").is_string()) {
         ENVOY_LOG(trace, "Invalid ipv6Address");
         return absl::InvalidArgumentError("Invalid ipv6Address");
       }
-      const std::string& ipv6_address = ip_endpoint.value().at("ipv6Address");
+      const std::string& ipv6_address = ip_endpoint->at("ipv6Address");
       host_list.push_back(absl::StrCat("[", ipv6_address, "]"));
     }
 
@@ -1161,18 +1081,18 @@ absl::StatusOr<std::vector<std::string>> EricProxyFilter::getHostListForEndpoint
 // If no port is defined in the IP endpoint, then port is considered
 // as 80 if scheme at NF service level is http and 443 if https.
 absl::StatusOr<std::string> EricProxyFilter::getPortForEndpoint(
-  const Json& nf_service, const absl::optional<Json>& ip_endpoint
+  const Json& nf_service, const Json* ip_endpoint
 ) {
   if (
-    ip_endpoint.has_value() &&
-    ip_endpoint.value().contains("port")
+    ip_endpoint != nullptr &&
+    ip_endpoint->contains("port")
   ) {
     // Invalid port
-    if (!ip_endpoint.value().at("port").is_number_integer()) {
+    if (!ip_endpoint->at("port").is_number_integer()) {
       ENVOY_LOG(trace, "Invalid port");
       return absl::InvalidArgumentError("Invalid port");
     }
-    const int& port = ip_endpoint.value().at("port");
+    const int& port = ip_endpoint->at("port");
     return std::to_string(port);
   }
 
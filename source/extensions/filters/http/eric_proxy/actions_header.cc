@@ -19,6 +19,27 @@ namespace Extensions {
 namespace HttpFilters {
 namespace EricProxy {
 
+namespace {
+
+// Replace all instances of a header with one instance per value, in one batch of header
+// mutations. If the header exists once and gets a single value, only the value is replaced.
+// Without values the header is removed.
+void replaceHeaderValues(Http::HeaderMap& headers, const Http::LowerCaseString& name,
+                         absl::Span<const std::string> values) {
+  absl::InlinedVector<Http::HeaderMutation, 4> mutations;
+  if (values.empty()) {
+    mutations.push_back({Http::HeaderMutation::Type::Remove, name});
+  }
+  for (const auto& value : values) {
+    mutations.push_back({mutations.empty() ? Http::HeaderMutation::Type::Set
+                                           : Http::HeaderMutation::Type::Add,
+                         name, value});
+  }
+  headers.applyMutations(mutations);
+}
+
+} // namespace
+
 //-------- Header Actions ---------------------------------------------------------------
 // Add Header
 ActionResultTuple EricProxyFilter::actionAddHeader(const ActionAddHeaderWrapper& action) {
@@ -49,11 +70,10 @@ ActionResultTuple EricProxyFilter::actionAddHeader(const ActionAddHeaderWrapper&
     break;
   case REPLACE:
     ENVOY_STREAM_LOG(debug, "Replacing header: {}", *decoder_callbacks_, name);
-    run_ctx_.getReqOrRespHeaders()->remove(name_lc);
     for(const auto& value: values){
       ENVOY_STREAM_LOG(debug, "  -> new value: {}", *decoder_callbacks_, value);
-      run_ctx_.getReqOrRespHeaders()->addCopy(name_lc, value);
     }
+    replaceHeaderValues(*run_ctx_.getReqOrRespHeaders(), name_lc, values);
     return std::make_tuple(ActionResult::Next, /*headers changed:*/true, std::nullopt);
     break;
   default:
@@ -83,18 +103,18 @@ ActionResultTuple EricProxyFilter::actionRemoveHeader(const FilterActionWrapper&
 ActionResultTuple EricProxyFilter::actionModifyHeader(const ActionModifyHeaderWrapper& action) {
   const auto proto_config = action.protoConfig().action_modify_header();
   const auto& name = proto_config.name();
-  auto header_to_be_modified = run_ctx_.getReqOrRespHeaders()->get(Http::LowerCaseString(name));
+  const Http::LowerCaseString name_lc(name);
+  auto header_to_be_modified = run_ctx_.getReqOrRespHeaders()->get(name_lc);
   if (!header_to_be_modified.empty()) {
     // Is it "replace"?
     if (proto_config.has_replace_value()) {
       auto values = varHeaderConstValueAsVector(proto_config.replace_value(), false);
       if (!values.empty()) {
         ENVOY_STREAM_LOG(debug, "Replacing value in header: {}", *decoder_callbacks_, name);
-        run_ctx_.getReqOrRespHeaders()->remove(Http::LowerCaseString(name));
         for(const auto& value: values){
           ENVOY_STREAM_LOG(debug, "{}: {}", *decoder_callbacks_, name, value);
-          run_ctx_.getReqOrRespHeaders()->addCopy(Http::LowerCaseString(name), value);
         }
+        replaceHeaderValues(*run_ctx_.getReqOrRespHeaders(), name_lc, values);
       }
     } else if (proto_config.has_append_value() || proto_config.has_prepend_value()) {
       // Append and/or prepend
@@ -117,14 +137,15 @@ ActionResultTuple EricProxyFilter::actionModifyHeader(const ActionModifyHeaderWr
           newHdrVal = newHdrVal.append(appendValue);
         }
         ENVOY_STREAM_LOG(trace, "Setting header: {} to value: '{}'", *decoder_callbacks_, name, newHdrVal);
-        run_ctx_.getReqOrRespHeaders()->setCopy(Http::LowerCaseString(name), newHdrVal);
+        replaceHeaderValues(*run_ctx_.getReqOrRespHeaders(), name_lc, {newHdrVal});
       }
       // The original header had multiple values:
       // -> Append/prepend to all instances of the header
       // DND-26377
       else if (header_to_be_modified.size() > 1){
         // HeaderMap implementation modifies only the first occurrence of the header (see setCopy method doc).
-        // So, we do a temporary deep copy of the values, remove the header, and add each value again.
+        // So, we do a temporary deep copy of the values, modify them, and replace the header with
+        // the modified values.
         // It is a bit costly and that's why we do it only for multple header values.
         absl::InlinedVector<std::string, 3> hdrValues; // is this better than std::vector?
         hdrValues.reserve(header_to_be_modified.size());
@@ -132,10 +153,8 @@ ActionResultTuple EricProxyFilter::actionModifyHeader(const ActionModifyHeaderWr
           hdrValues.push_back(std::string(header_to_be_modified[i]->value().getStringView()));
         }
 
-        ENVOY_STREAM_LOG(debug, "Removing header: {}", *decoder_callbacks_, name);
-        run_ctx_.getReqOrRespHeaders()->remove(Http::LowerCaseString(name)); // header_to_be_modified is gone
-
-        for (auto newHdrVal : hdrValues) {
+        ENVOY_STREAM_LOG(debug, "Replacing header: {}", *decoder_callbacks_, name);
+        for (auto& newHdrVal : hdrValues) {
            if (!prependValue.empty()) {
             ENVOY_STREAM_LOG(debug, "Prepending value: {} with value: '{}'",
                       *decoder_callbacks_, newHdrVal, prependValue);
@@ -146,8 +165,8 @@ ActionResultTuple EricProxyFilter::actionModifyHeader(const ActionModifyHeaderWr
                       *decoder_callbacks_, newHdrVal, appendValue);
             newHdrVal = newHdrVal.append(appendValue);
           }
-          run_ctx_.getReqOrRespHeaders()->addCopy(Http::LowerCaseString(name), newHdrVal);
         }
+        replaceHeaderValues(*run_ctx_.getReqOrRespHeaders(), name_lc, hdrValues);
       }
     } else if (
       proto_config.has_use_string_modifiers() &&
@@ -187,10 +206,11 @@ ActionResultTuple EricProxyFilter::actionModifyHeader(const ActionModifyHeaderWr
           }
           ENVOY_STREAM_LOG(trace, "header value after applying string modifier: {}", *decoder_callbacks_, *hdr_ptr);
         }
-        run_ctx_.getReqOrRespHeaders()->setCopy(Http::LowerCaseString(name), *hdr_ptr);
+        replaceHeaderValues(*run_ctx_.getReqOrRespHeaders(), name_lc, {*hdr_ptr});
       } else if (header_to_be_modified.size() > 1) {
         // HeaderMap implementation modifies only the first occurrence of the header (see setCopy method doc).
-        // So, we do a temporary deep copy of the values, remove the header, and add each value again.
+        // So, we do a temporary deep copy of the values, modify them, and replace the header with
+        // the modified values.
         // It is a bit costly and that's why we do it only for multple header values.
         absl::InlinedVector<std::string, 3> hdr_values; // is this better than std::vector?
         hdr_values.reserve(header_to_be_modified.size());
@@ -198,10 +218,8 @@ ActionResultTuple EricProxyFilter::actionModifyHeader(const ActionModifyHeaderWr
           hdr_values.push_back(std::string(header_to_be_modified[i]->value().getStringView()));
         }
 
-        ENVOY_STREAM_LOG(debug, "Removing header: {}", *decoder_callbacks_, name);
-        run_ctx_.getReqOrRespHeaders()->remove(Http::LowerCaseString(name)); // header_to_be_modified is gone
-
-        for (std::string hdr_value : hdr_values) {
+        ENVOY_STREAM_LOG(debug, "Replacing header: {}", *decoder_callbacks_, name);
+        for (std::string& hdr_value : hdr_values) {
           std::string *hdr_ptr = &hdr_value;
           for (const auto& string_modifier : string_modifiers) {
             const auto& modifier_function = prepareStringModifier(string_modifier, run_ctx_, decoder_callbacks_);
@@ -232,8 +250,8 @@ ActionResultTuple EricProxyFilter::actionModifyHeader(const ActionModifyHeaderWr
             }
             ENVOY_STREAM_LOG(trace, "header value after applying string modifier: {}", *decoder_callbacks_, *hdr_ptr);
           }
-          run_ctx_.getReqOrRespHeaders()->addCopy(Http::LowerCaseString(name), *hdr_ptr);
         }
+        replaceHeaderValues(*run_ctx_.getReqOrRespHeaders(), name_lc, hdr_values);
       }
       ENVOY_STREAM_LOG(trace, "header modification successful", *decoder_callbacks_);
     }
@@ -102,7 +102,7 @@ void EricProxyFilter::prepareScpStrictRoutingForDfP(Http::RequestOrResponseHeade
   if( absl::string_view(routing_behaviour_str_.at(behaviour)) == "STRICT_DFP" )
   {
     ENVOY_STREAM_UL_LOG(debug, "SCP: Prepare routing for Dyn Forwarding Proxy", *decoder_callbacks_, ULID(C18));
-    auto tar_hdr = headers.get(Http::LowerCaseString("3gpp-Sbi-Target-apiroot"));
+    auto tar_hdr = headers.get(SbiHeaders::get().TargetApiRoot);
     if(! tar_hdr.empty())
     {
       std::string scheme = "http";
@@ -182,7 +182,7 @@ void EricProxyFilter::prepareSeppRoutingExtToInt(Http::RequestOrResponseHeaderMa
             const auto modified_body_str = modified_body->dump();
             eric_proxy_sepp_state->setModifiedBody(std::move(modified_body_str));
           } else {
-            ENVOY_STREAM_UL_LOG(debug, "T-FQDN label creation failed for target '{}'",
+            ENVOY_STREAM_UL_LOG(debug, "T-FQDN label creation failed: '{}'",
                                 *decoder_callbacks_, ULID(T21), status.message());
           }
         }
@@ -192,7 +192,7 @@ void EricProxyFilter::prepareSeppRoutingExtToInt(Http::RequestOrResponseHeaderMa
     if (topo_hide_pseudo_fqdn_.has_value()) {
       ENVOY_STREAM_UL_LOG(debug, "Removing 3gpp-Sbi-target-apiRoot header", *decoder_callbacks_,
                           "H07");
-      headers.remove(Http::LowerCaseString("3gpp-Sbi-target-apiRoot"));
+      headers.remove(SbiHeaders::get().TargetApiRoot);
     }
   }
 }
@@ -251,7 +251,7 @@ std::string EricProxyFilter::getReqApiNameForSbaCb(absl::string_view sba_cb_hdr)
 
 std::string EricProxyFilter::getResource(Http::RequestOrResponseHeaderMap& headers) {
   auto path_hdr = headers.get(Http::LowerCaseString(":path"));
-  auto sbi_cb_hdr = headers.get(Http::LowerCaseString("3gpp-sbi-callback"));
+  auto sbi_cb_hdr = headers.get(SbiHeaders::get().Callback);
   // Only get resource from :path header if transaction is not a notification request
   if(!path_hdr.empty() && (sbi_cb_hdr.empty())) {
     auto strip_path = Http::Utility::stripQueryString(path_hdr[0]->value());
@@ -370,10 +370,10 @@ void EricProxyFilter::executeRoutingAction(const std::string& cluster_name,
 
   // Check headers 3gpp-sbi-target-apiroot and x-notify-uri for validity
   // TODO: should this be done earlier?
-  auto tar_hdr = run_ctx_.getReqOrRespHeaders()->get(Http::LowerCaseString("3gpp-Sbi-Target-apiRoot"));
+  auto tar_hdr = run_ctx_.getReqOrRespHeaders()->get(SbiHeaders::get().TargetApiRoot);
   if (routing_behaviour == RoutingBehaviour::STRICT || routing_behaviour == RoutingBehaviour::PREFERRED ||
       routing_behaviour == RoutingBehaviour::STRICT_DFP || routing_behaviour == RoutingBehaviour::REMOTE_PREFERRED) {
-    if (!isValidHeader(run_ctx_.getReqOrRespHeaders()->get(Http::LowerCaseString("3gpp-Sbi-Target-apiRoot")))) {
+    if (!isValidHeader(run_ctx_.getReqOrRespHeaders()->get(SbiHeaders::get().TargetApiRoot))) {
       sendLocalReplyWithSpecificContentType(
           400, "application/problem+json",
           R"({"status": 400, "title": "Bad Request", "cause": "MANDATORY_IE_INCORRECT", "detail": "3gpp-sbi-target-apiroot_header_malformed"})",
@@ -435,7 +435,7 @@ void EricProxyFilter::executeRoutingAction(const std::string& cluster_name,
   // TS29.500 R16 ch. 6.10.4
   // ULID(S29)
   if (!topo_hide_pseudo_fqdn_.has_value()) {
-    auto orig_tar_hdr = run_ctx_.getReqOrRespHeaders()->get(Http::LowerCaseString("3gpp-Sbi-Target-apiRoot"));
+    auto orig_tar_hdr = run_ctx_.getReqOrRespHeaders()->get(SbiHeaders::get().TargetApiRoot);
     if (!orig_tar_hdr.empty()) {
       original_tar_.emplace(orig_tar_hdr[0]->value().getStringView());
     }
@@ -1067,6 +1067,10 @@ void EricProxyFilter::executeRemoteRoutingAction(const FilterActionWrapper& acti
     return;
   }
 
+  if (!nf_discovery_result_.has_value()) {
+    nf_discovery_result_ = decodeNfDiscoveryResult(discovery_result_json_, nf_disc_ip_version_);
+  }
+
   ProtobufWkt::Struct metadata;
 
   // Flag to indicate that target-api-root processing is needed:
@@ -1088,7 +1092,7 @@ void EricProxyFilter::executeRemoteRoutingAction(const FilterActionWrapper& acti
 
   if (proto_config.routing_behaviour() == RoutingBehaviour::REMOTE_ROUND_ROBIN) {
     const auto& tar_list  = selectTarsForRemoteRouting(
-      discovery_result_json_, proto_config.remote_reselections().value(), nf_disc_ip_version_, nf_set_id_
+      *nf_discovery_result_, proto_config.remote_reselections().value(), nf_set_id_
     );
     if (!tar_list.ok()) {
       if (tar_list.status().code() == absl::StatusCode::kInvalidArgument) {
@@ -1118,7 +1122,7 @@ void EricProxyFilter::executeRemoteRoutingAction(const FilterActionWrapper& acti
       return;
     }
     const auto& tar_list = selectTarsForRemoteRouting(
-      discovery_result_json_, proto_config.remote_reselections().value(), nf_disc_ip_version_, nf_set_id_,
+      *nf_discovery_result_, proto_config.remote_reselections().value(), nf_set_id_,
       proto_config.remote_retries().value(), pref_host
     );
     if (!tar_list.ok()) {
@@ -0,0 +1,54 @@
+#include "source/extensions/filters/http/eric_proxy/body_buffer_budget.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace HttpFilters {
+namespace EricProxy {
+
+BodyBufferStats generateBodyBufferStats(Stats::Scope& scope) {
+  const std::string prefix = "http.eric_proxy.body_buffer.";
+  return BodyBufferStats{
+      ALL_BODY_BUFFER_STATS(POOL_COUNTER_PREFIX(scope, prefix), POOL_GAUGE_PREFIX(scope, prefix))};
+}
+
+BodyBufferBudget& BodyBufferBudget::forCurrentThread() {
+  // Streams never move between workers, so a plain thread-local is enough
+  thread_local BodyBufferBudget budget;
+  return budget;
+}
+
+bool BodyBufferReservation::update(uint64_t length) {
+  if (length > BodyBufferBudget::DefaultMaxMessageBytes) {
+    // Everything else buffered on this worker plus the whole body has to fit
+    if (budget_.bytes_ - bytes_ + length > max_bytes_) {
+      stats_.oversized_rejected_.inc();
+      return false;
+    }
+    if (!oversized_) {
+      oversized_ = true;
+      stats_.oversized_accepted_.inc();
+    }
+  }
+  // Bodies within the default limit are accounted even when the budget is used up,
+  // they are not rejected because of other large messages
+  if (length > bytes_) {
+    stats_.bytes_all_workers_.add(length - bytes_);
+  } else {
+    stats_.bytes_all_workers_.sub(bytes_ - length);
+  }
+  budget_.bytes_ = budget_.bytes_ - bytes_ + length;
+  bytes_ = length;
+  return true;
+}
+
+void BodyBufferReservation::release() {
+  stats_.bytes_all_workers_.sub(bytes_);
+  budget_.bytes_ -= bytes_;
+  bytes_ = 0;
+  oversized_ = false;
+}
+
+} // namespace EricProxy
+} // namespace HttpFilters
+} // namespace Extensions
+} // namespace Envoy
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <cstdint>
+
+#include "envoy/stats/scope.h"
+#include "envoy/stats/stats_macros.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace HttpFilters {
+namespace EricProxy {
+
+// The gauge is the sum over all workers, each worker has its own budget. A per-worker gauge
+// would need the worker's stat name on every stream and a scope that outlives the
+// thread-local budget; a worker running out of budget shows up in oversized_rejected.
+#define ALL_BODY_BUFFER_STATS(COUNTER, GAUGE)                                                      \
+  COUNTER(oversized_accepted)                                                                      \
+  COUNTER(oversized_rejected)                                                                      \
+  GAUGE(bytes_all_workers, Accumulate)
+
+struct BodyBufferStats {
+  ALL_BODY_BUFFER_STATS(GENERATE_COUNTER_STRUCT, GENERATE_GAUGE_STRUCT)
+};
+
+BodyBufferStats generateBodyBufferStats(Stats::Scope& scope);
+
+//--------------------------------------------------------------------------------------
+// Bytes of request and response bodies that the eric_proxy filters of one worker thread
+// currently hold in memory. Messages up to the default limit (used when no limit is
+// configured in the firewall checks) are always accepted. A larger message is only
+// accepted while all bodies buffered on the worker, including the large one, fit into
+// the worker's budget (body_buffer_worker_max_bytes in the filter config). That way an occasional very large NF message gets through without
+// raising the limit for all messages.
+class BodyBufferBudget {
+public:
+  static constexpr uint64_t DefaultMaxMessageBytes = 16000000;
+  static constexpr uint64_t DefaultWorkerBytes = 4 * DefaultMaxMessageBytes;
+
+  BodyBufferBudget() = default;
+  BodyBufferBudget(const BodyBufferBudget&) = delete;
+  BodyBufferBudget& operator=(const BodyBufferBudget&) = delete;
+
+  // The budget of the calling (worker) thread
+  static BodyBufferBudget& forCurrentThread();
+
+  uint64_t bytes() const { return bytes_; }
+
+private:
+  friend class BodyBufferReservation;
+
+  uint64_t bytes_ = 0;
+};
+
+//--------------------------------------------------------------------------------------
+// The part of a BodyBufferBudget used by one message body. Released when the body is
+// no longer buffered or at the latest when the reservation is destroyed. max_bytes is the
+// size of the worker's budget, it comes from the filter config of the stream.
+class BodyBufferReservation {
+public:
+  BodyBufferReservation(BodyBufferBudget& budget, uint64_t max_bytes, BodyBufferStats& stats)
+      : budget_(budget), max_bytes_(max_bytes), stats_(stats) {}
+  BodyBufferReservation(const BodyBufferReservation&) = delete;
+  BodyBufferReservation& operator=(const BodyBufferReservation&) = delete;
+  ~BodyBufferReservation() { release(); }
+
+  // Account for the buffered body having grown to length bytes. Returns false if the
+  // body is larger than the default message limit and the worker's budget cannot hold
+  // it, true otherwise.
+  bool update(uint64_t length);
+  void release();
+
+  uint64_t bytes() const { return bytes_; }
+
+private:
+  BodyBufferBudget& budget_;
+  const uint64_t max_bytes_;
+  BodyBufferStats& stats_;
+  uint64_t bytes_ = 0;
+  bool oversized_ = false;
+};
+
+} // namespace EricProxy
+} // namespace HttpFilters
+} // namespace Extensions
+} // namespace Envoy
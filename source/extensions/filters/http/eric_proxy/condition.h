@@ -248,7 +248,7 @@ public:
     }
     else
     {
-      auto hdr_maybe_list = run_ctx.headerValue(index1_, ror_);
+      const auto& hdr_maybe_list = run_ctx.headerValue(index1_, ror_);
       std::string hdr_maybe_list_str = absl::StrJoin(hdr_maybe_list,",");
       if(hdr_maybe_list_str == root_ctx_.constValue(index2_).get<std::string>())
       {
@@ -703,8 +703,8 @@ public:
     hdr_req.insert(header_index2);
   };
   bool eval(RunContext& run_ctx) override {
-    const auto t1 = run_ctx.headerValue(index1_, ror1_);
-    const auto t2 = run_ctx.headerValue(index2_, ror2_);
+    const auto& t1 = run_ctx.headerValue(index1_, ror1_);
+    const auto& t2 = run_ctx.headerValue(index2_, ror2_);
 
     return std::equal(t1.begin(), t1.end(), t2.begin(), t2.end(),
                       [](auto&& l, auto&& r) { return absl::EqualsIgnoreCase(l, r); });
@@ -732,7 +732,7 @@ public:
     if (!root_ctx_.constValue(index2_).is_string()) {
       return false;
     } else {
-      auto hdr_maybe_list = run_ctx.headerValue(index1_, ror_);
+      const auto& hdr_maybe_list = run_ctx.headerValue(index1_, ror_);
       const std::string hdr_maybe_list_str = StringUtil::toUpper(absl::StrJoin(hdr_maybe_list, ","));
       if (hdr_maybe_list_str == StringUtil::toUpper(root_ctx_.constValue(index2_).get<std::string>())) {
         return true;
@@ -3,6 +3,7 @@
 #include "source/extensions/filters/http/eric_proxy/contexts.h"
 #include "source/extensions/filters/http/eric_proxy/proxy_filter_config.h"
 #include "source/extensions/filters/http/eric_proxy/wrappers.h"
+#include <algorithm>
 #include <cctype>
 
 namespace Envoy {
@@ -118,14 +119,16 @@ ValueIndex RootContext::findOrInsertQueryParamName(const std::string& name) {
     return next_query_param_index_ - 1;
   }
 }
-std::vector<absl::string_view> RunContext::headerValue(ValueIndex index, int req_or_resp) {
+const HeaderValues& RunContext::headerValue(ValueIndex index, int req_or_resp) {
   if (!header_value_.at(req_or_resp).empty() && header_value_.at(req_or_resp).size() > index) {
     return header_value_.at(req_or_resp).at(index);
   } else {
-    return {{""}};
+    // Heap-allocated (no arena), shared by all run-contexts
+    static const HeaderValues* unknown_header = new HeaderValues{absl::string_view("")};
+    return *unknown_header;
   }
 }
-std::vector<absl::string_view> RunContext::headerValue(ValueIndex index, ReqOrResp req_or_resp) {
+const HeaderValues& RunContext::headerValue(ValueIndex index, ReqOrResp req_or_resp) {
   return headerValue(index, static_cast<int>(req_or_resp));
 }
 
@@ -357,22 +360,57 @@ std::string RootContext::debugStringKlvTables() {
 }
 
 //-------------------------------------------------------------------------------
-RunContext::RunContext(RootContext* root_ctx) : root_ctx_(root_ctx) {
+RunContext::RunContext(RootContext* root_ctx)
+    : arena_(root_ctx->arenaSizeHint()), root_ctx_(root_ctx) {
+  // All tables are allocated in the per-request arena, which is released
+  // as a whole with the run-context.
+  const ArenaAllocator<HeaderValues> header_alloc(&arena_);
+  const HeaderValues no_header_value{ArenaAllocator<absl::string_view>(&arena_)};
   // We know how many elements the arrays will have -> set correct size
   // now instead of growing them.  Do it for both, request- and response-
   // direction:
-  header_value_[0] = std::vector<std::vector<absl::string_view>>(root_ctx_->numHeaders());
-  header_value_[1] = std::vector<std::vector<absl::string_view>>(root_ctx_->numHeaders());
+  header_value_[0] = ArenaVector<HeaderValues>(root_ctx_->numHeaders(), no_header_value, header_alloc);
+  header_value_[1] = ArenaVector<HeaderValues>(root_ctx_->numHeaders(), no_header_value, header_alloc);
   // We know how many elements the array will have for query parameters -> set correct size
   // now instead of growing them.
-  query_param_value_ = std::vector<absl::string_view>(root_ctx_->numQueryParams());
+  query_param_value_ = ArenaVector<absl::string_view>(
+      root_ctx_->numQueryParams(), ArenaAllocator<absl::string_view>(&arena_));
   // Pre-allocate/resize the var_updated_by table in the run-context to the number of elements
   // in the var_configmap Set the updated_by column to null to indicate the value is invalid.
-  var_value_ = std::vector<Json>(root_ctx_->numVars());
-  var_updated_by_ = std::vector<FilterCaseWrapper*>(root_ctx_->numVars()); 
-  for (int i = 0 ; i < root_ctx_->numVars(); i++) {
-      updateVarUpdatedBy(i, nullptr);
-  }
+  var_value_ = ArenaVector<Json>(root_ctx_->numVars(), ArenaAllocator<Json>(&arena_));
+  var_updated_by_ = ArenaVector<FilterCaseWrapper*>(root_ctx_->numVars(), nullptr,
+                                                    ArenaAllocator<FilterCaseWrapper*>(&arena_));
+}
+
+RunContext::~RunContext() { root_ctx_->recordArenaUsage(arena_); }
+
+// Initial size of the per-request arena: the header, query-parameter and variable
+// tables of the configuration plus room for some header values, raised to the
+// usage of recent requests. Capped so that a single unusual request does not
+// inflate the arenas of all following requests, and the estimate decays so that
+// a burst of large requests does not either.
+size_t RootContext::arenaSizeHint() {
+  constexpr size_t min_arena_size = 512;
+  constexpr size_t max_arena_size = 64 * 1024;
+  const size_t configured_size =
+      2 * numHeaders() * (sizeof(HeaderValues) + 2 * sizeof(absl::string_view)) +
+      numQueryParams() * sizeof(absl::string_view) +
+      numVars() * (sizeof(Json) + sizeof(FilterCaseWrapper*));
+  const size_t size = std::max({min_arena_size, configured_size, arenaBytesEstimate()});
+  return std::min(size, max_arena_size);
+}
+
+void RootContext::recordArenaUsage(const RunContextArena& arena) {
+  const size_t bytes_used = arena.bytesUsed();
+  size_t estimate = arena_bytes_estimate_.load(std::memory_order_relaxed);
+  size_t new_estimate;
+  do {
+    new_estimate = bytes_used >= estimate
+                       ? bytes_used
+                       : estimate - (estimate - bytes_used + ArenaUsageDecay - 1) / ArenaUsageDecay;
+  } while (new_estimate != estimate &&
+           !arena_bytes_estimate_.compare_exchange_weak(estimate, new_estimate,
+                                                        std::memory_order_relaxed));
 }
 
 // Log all variables
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <array>
+#include <atomic>
 #include <map>
 #include <string>
 #include <tuple>
@@ -11,6 +12,7 @@
 #include "include/nlohmann/json.hpp"
 #include "source/common/common/logger.h"
 #include "source/common/http/utility.h"
+#include "source/extensions/filters/http/eric_proxy/run_context_arena.h"
 #include "absl/strings/str_join.h"
 #include "re2/re2.h"
 
@@ -27,6 +29,8 @@ using KeyValueTable = envoy::extensions::filters::http::eric_proxy::v3::KvTable;
 using KeyValueTablesProto = google::protobuf::RepeatedPtrField<KeyValueTable>;
 using KeyListValueTable = envoy::extensions::filters::http::eric_proxy::v3::KlvTable;
 using KeyListValueTablesProto = google::protobuf::RepeatedPtrField<KeyListValueTable>;
+// The values of one header in the run-context, allocated in the per-request arena
+using HeaderValues = ArenaVector<absl::string_view>;
 
 // a custom comparator function for the header_configmap_, so that comparisons are case insensitive
 struct CaseInsensitiveComparator {
@@ -321,6 +325,20 @@ public:
   RE2& getBootstrapContextRE() { return api_ctx_nrf_bootstrap_re_; }
   RE2& getServiceTokenContextRE() { return api_ctx_nrf_ouath_re_; }
 
+  // Support for the per-request arena of the run-context
+  // Initial arena size for a new run-context: what the configuration needs for the
+  // header, query-parameter and variable tables, or more if recent requests were
+  // observed to need more.
+  size_t arenaSizeHint();
+  // Record the usage of an arena at the end of a request (called from all workers)
+  void recordArenaUsage(const RunContextArena& arena);
+  // Arena bytes recent requests needed: follows a larger usage immediately and
+  // decays by 1/ArenaUsageDecay of the difference with every smaller one
+  size_t arenaBytesEstimate() const {
+    return arena_bytes_estimate_.load(std::memory_order_relaxed);
+  }
+  static constexpr size_t ArenaUsageDecay = 64;
+
 private:
   // The *_configmap map a name for (variables|headers|constants)
   // to an index in the corresponding *_value vectors. Only they
@@ -368,6 +386,9 @@ private:
   RE2 api_ctx_re_ = RE2(".*/(?P<apiName>.*)/(?P<apiVersion>v[\\d])/(?P<resource>.*)");
   RE2 api_ctx_nrf_bootstrap_re_ = RE2(".*/bootstrapping$|.*/bootstrapping/(?P<resource>.*)");
   RE2 api_ctx_nrf_ouath_re_ = RE2(".*/oauth2$|.*/oauth2/(?P<resource>.*)");
+
+  // Arena usage statistics of the run-contexts
+  std::atomic<size_t> arena_bytes_estimate_{0};
 };
 
 //--------------------------------------------------------------------------------------
@@ -375,16 +396,20 @@ private:
 class RunContext : public Logger::Loggable<Logger::Id::eric_proxy> {
 public:
   RunContext(RootContext* root_ctx);
+  ~RunContext();
+  // The containers point into the arena_, so a run-context cannot be copied or moved
+  RunContext(const RunContext&) = delete;
+  RunContext& operator=(const RunContext&) = delete;
 
   //---- Helper Functions -------------------------------------------------------
   // Split comma-separated header values into separate values
-  std::vector<absl::string_view> splitHeaderValues(ValueIndex index,
-                                                   std::vector<absl::string_view> values) {
+  HeaderValues splitHeaderValues(ValueIndex index, const std::vector<absl::string_view>& values) {
+    HeaderValues result{ArenaAllocator<absl::string_view>(&arena_)};
     if (root_ctx_->headerName(index) == "set-cookie") {
-      return values;
+      result.assign(values.begin(), values.end());
+      return result;
     }
 
-    std::vector<absl::string_view> result;
     for (const auto& value : values) {
       auto comma_separated = absl::StrSplit(value, ',');
       result.insert(result.end(), comma_separated.begin(), comma_separated.end());
@@ -414,7 +439,8 @@ public:
 
   // Removes a header (needed for action-remove-header to remove it also here)
   void removeHeader(ValueIndex index, int req_or_resp) {
-    header_value_.at(req_or_resp).at(index) = std::vector<absl::string_view>();
+    // Reset the arena-backed slot, that makes the header count as absent
+    header_value_.at(req_or_resp).at(index) = HeaderValues(ArenaAllocator<absl::string_view>(&arena_));
   };
   void removeHeader(std::string& name, int req_or_resp) {
     removeHeader(root_ctx_->findOrInsertHeaderName(name), req_or_resp);
@@ -440,15 +466,17 @@ public:
   std::size_t headerSize(const int req_or_resp) const { return header_value_.at(req_or_resp).size(); }
 
   // Return a header_value at a given index as vector of string_view
-  std::vector<absl::string_view> headerValue(ValueIndex index, ReqOrResp req_or_resp);
-  std::vector<absl::string_view> headerValue(ValueIndex index, int req_or_resp);
+  const HeaderValues& headerValue(ValueIndex index, ReqOrResp req_or_resp);
+  const HeaderValues& headerValue(ValueIndex index, int req_or_resp);
   // Return a header value at a given index as vector of strings
   std::vector<std::string> headerValueStrings(ValueIndex index, ReqOrResp req_or_resp) {
     return headerValueStrings(index, static_cast<int>(req_or_resp));
   }
   std::vector<std::string> headerValueStrings(ValueIndex index, int req_or_resp) {
+    const auto& values = header_value_.at(req_or_resp).at(index);
     std::vector<std::string> ret;
-    for (const auto& val : header_value_.at(req_or_resp).at(index)) {
+    ret.reserve(values.size());
+    for (const auto& val : values) {
       ret.push_back(std::string(val));
     }
     return ret;
@@ -457,10 +485,12 @@ public:
   // Update a header value at a given index
   // NOTE: There is a corresponding function updateHeaderValueForTest() that does the same but
   // logs differently. Change both functions when you make a change!
-  void updateHeaderValue(ValueIndex index, std::vector<absl::string_view> values, ReqOrResp req_or_resp) {
+  void updateHeaderValue(ValueIndex index, const std::vector<absl::string_view>& values,
+                         ReqOrResp req_or_resp) {
     return updateHeaderValue(index, values, static_cast<int>(req_or_resp));
   }
-  void updateHeaderValue(ValueIndex index, std::vector<absl::string_view> values, int req_or_resp) {
+  void updateHeaderValue(ValueIndex index, const std::vector<absl::string_view>& values,
+                         int req_or_resp) {
     ENVOY_STREAM_LOG(trace, "updateHeaderValue at index {} with {}", *decoder_callbacks_, index,
                      absl::StrJoin(values, ","));
     header_value_.at(req_or_resp).at(index) = splitHeaderValues(index, values);
@@ -579,15 +609,16 @@ public:
   };
 
   // Return a var_value at a given index
-  const Json varValue(ValueIndex index) { return var_value_.at(index); };
+  const Json& varValue(ValueIndex index) { return var_value_.at(index); };
 
   // Return a var_value converted to std::string at a given index
   const std::string varValueAsString(ValueIndex index) {
+    const auto& value = varValue(index);
     // Special treatment for strings, because dump() surrounds strings with double quotes:
-    if (varValue(index).is_string()) {
-      return varValue(index).get<std::string>();
+    if (value.is_string()) {
+      return value.get<std::string>();
     } else {
-      return varValue(index).dump();
+      return value.dump();
     }
   };
 
@@ -695,6 +726,9 @@ public:
   // Get the Roaming Partner name
   std::string getRoamingPartnerName() { return rp_name_; }
 
+  // The per-request arena backing the header, query-parameter and variable tables
+  const RunContextArena& arena() const { return arena_; }
+
   enum UpstreamHostScheme { Http, Https };
 
   void setSelectedHostScheme(UpstreamHostScheme scheme) { selected_host_scheme_ = scheme ;}
@@ -710,13 +744,16 @@ public:
   void setSelectedHostAuthority(const std::string& authority) { selected_host_authority_ = authority; }
 
 private:
+  // Must be declared before all containers allocating from it, so that it is
+  // destroyed after them
+  RunContextArena arena_;
   RootContext* root_ctx_;
 
   // Service Context based on 3gpp specs
   ServiceClassifierCtx service_ctx_;
   std::unique_ptr<StringModifierContext> string_modifier_ctx_;
-  std::vector<Json> var_value_;
-  std::vector<FilterCaseWrapper*> var_updated_by_;
+  ArenaVector<Json> var_value_;
+  ArenaVector<FilterCaseWrapper*> var_updated_by_;
   // 
   // header_value_ is used for header["name"] in conditions,
   // not when a header is copied into a variable
@@ -725,9 +762,9 @@ private:
   // second element contains the response header values. It is intended to
   // access the request or response headers via the enum values or ReqOrResp
   // defined in filter.h
-  std::array<std::vector<std::vector<absl::string_view>>, 2> header_value_;
+  std::array<ArenaVector<HeaderValues>, 2> header_value_;
   // query_param_value_ is used for query.param["name"] in conditions
-  std::vector<absl::string_view> query_param_value_;
+  ArenaVector<absl::string_view> query_param_value_;
   // Decoder callbacks are needed for ENVOY_STREAM_LOG():
   Http::StreamDecoderFilterCallbacks* decoder_callbacks_;
   // req_body_ and resp_body_ pointers are used to access request 
@@ -2,6 +2,7 @@
 
 #include <string>
 #include "envoy/http/header_map.h"
+#include "source/extensions/filters/http/eric_proxy/eric_sbi_nf_peer_info/sbi_nf_peer_info_tokens.h"
 
 namespace Envoy {
 namespace Extensions {
@@ -10,28 +11,29 @@ namespace EricProxy {
 
 // Product interface to handle SbiNfPeerInfo headers
 // Main idea to set values for each product
+// The single token setters work on the pre-parsed header, setAll() parses the
+// header once, applies all of them and writes the header once.
 class SbiNfPeerInfoInterface {
 public:
-  // set srcinst header
-  virtual void setSrcInst(Http::RequestOrResponseHeaderMap& headers) PURE;
-  // set srcservinst header
-  virtual void setSrcServInst(Http::RequestOrResponseHeaderMap& headers) PURE;
-  // set srcscp header
-  virtual void setSrcScp(Http::RequestOrResponseHeaderMap& headers) PURE;
-  // set srcsepp header
-  virtual void setSrcSepp(Http::RequestOrResponseHeaderMap& headers) PURE;
-  // set dstinst header
-  virtual void setDstInst(Http::RequestOrResponseHeaderMap& headers) PURE;
-  // set dstservinst header
-  virtual void setDstServInst(Http::RequestOrResponseHeaderMap& headers) PURE;
-  // set dstscp header
-  virtual void setDstScp(Http::RequestOrResponseHeaderMap& headers) PURE;
-  // set dstsepp header
-  virtual void setDstSepp(Http::RequestOrResponseHeaderMap& headers) PURE;
+  // set srcinst token
+  virtual void setSrcInst(SbiNfPeerInfoTokens& tokens) PURE;
+  // set srcservinst token
+  virtual void setSrcServInst(SbiNfPeerInfoTokens& tokens) PURE;
+  // set srcscp token
+  virtual void setSrcScp(SbiNfPeerInfoTokens& tokens) PURE;
+  // set srcsepp token
+  virtual void setSrcSepp(SbiNfPeerInfoTokens& tokens) PURE;
+  // set dstinst token
+  virtual void setDstInst(SbiNfPeerInfoTokens& tokens) PURE;
+  // set dstservinst token
+  virtual void setDstServInst(SbiNfPeerInfoTokens& tokens) PURE;
+  // set dstscp token
+  virtual void setDstScp(SbiNfPeerInfoTokens& tokens) PURE;
+  // set dstsepp token
+  virtual void setDstSepp(SbiNfPeerInfoTokens& tokens) PURE;
   // is nf peer info header feature activated
   virtual bool isActivated() PURE;
-  // set all headers (see headers above).
-  // you can set the headers one by one or all together
+  // set all tokens (see above) and write the header once
   virtual void setAll(Http::RequestOrResponseHeaderMap& headers) PURE;
 
   // save ownfqdn, need this for headers
@@ -45,4 +47,4 @@ public:
 } // namespace EricProxy
 } // namespace HttpFilters
 } // namespace Extensions
-} // namespace Envoy
\ No newline at end of file
+} // namespace Envoy
@@ -1,109 +1,88 @@
 #include "source/extensions/filters/http/eric_proxy/eric_sbi_nf_peer_info/sbi_nf_peer_info_local_response.h"
 #include "source/extensions/filters/http/eric_proxy/eric_sbi_nf_peer_info/sbi_nf_peer_info.h"
-#include "source/extensions/filters/http/eric_proxy/eric_sbi_nf_peer_info/sbi_nf_peer_info_values.h"
-#include "source/common/config/metadata.h"
 
 namespace Envoy {
 namespace Extensions {
 namespace HttpFilters {
 namespace EricProxy {
-void SbiNfPeerInfoHeaderLocalResponse::setSrcInst(Http::RequestOrResponseHeaderMap& headers) {
+
+using Key = SbiNfPeerInfoTokens::Key;
+
+void SbiNfPeerInfoHeaderLocalResponse::setSrcInst(SbiNfPeerInfoTokens& tokens) {
   ENVOY_LOG(trace, "removing SrcInst for Local Reply");
-  SbiNfPeerInfo::deleteSrcInst(headers);
+  tokens.remove(Key::SrcInst);
 }
 
-void SbiNfPeerInfoHeaderLocalResponse::setSrcServInst(Http::RequestOrResponseHeaderMap& headers) {
+void SbiNfPeerInfoHeaderLocalResponse::setSrcServInst(SbiNfPeerInfoTokens& tokens) {
   ENVOY_LOG(trace, "removing SrcServInst for Local Reply");
-  SbiNfPeerInfo::deleteSrcServInst(headers);
+  tokens.remove(Key::SrcServInst);
 }
 
-void SbiNfPeerInfoHeaderLocalResponse::setSrcScp(Http::RequestOrResponseHeaderMap& headers) {
+void SbiNfPeerInfoHeaderLocalResponse::setSrcScp(SbiNfPeerInfoTokens& tokens) {
   ENVOY_LOG(trace, "set SrcScp for Local Reply with value: {}", own_fqdn_);
 
   if (!own_fqdn_.empty()) {
-    SbiNfPeerInfo::setSrcScp(headers, own_fqdn_);
+    SbiNfPeerInfo::setSrcScp(tokens, own_fqdn_);
   }
 }
 
-void SbiNfPeerInfoHeaderLocalResponse::setSrcSepp(Http::RequestOrResponseHeaderMap& headers) {
+void SbiNfPeerInfoHeaderLocalResponse::setSrcSepp(SbiNfPeerInfoTokens& tokens) {
   ENVOY_LOG(trace, "set SrcSepp for Local Reply with value: {}", own_fqdn_);
 
   if (!own_fqdn_.empty()) {
-    SbiNfPeerInfo::setSrcSepp(headers, own_fqdn_);
+    SbiNfPeerInfo::setSrcSepp(tokens, own_fqdn_);
   }
 }
 
-void SbiNfPeerInfoHeaderLocalResponse::setDstServInst(Http::RequestOrResponseHeaderMap& headers) {
+void SbiNfPeerInfoHeaderLocalResponse::setDstServInst(SbiNfPeerInfoTokens& tokens) {
   ENVOY_LOG(trace, "set DstServInst for Local Reply");
 
-  const auto value = SbiNfPeerInfo::getValueFromVector(original_sbi_request_header_,
-                                                       SbiNfPeerInfoHeaders::get().SrcServInst);
+  const auto value = original_sbi_request_header_->get(Key::SrcServInst);
   ENVOY_LOG(trace, "value: {}", value.value_or("empty"));
   if (value.has_value()) {
-    SbiNfPeerInfo::setDstServInst(headers, std::string(value.value()));
+    tokens.set(Key::DstServInst, value.value());
   }
 }
 
-void SbiNfPeerInfoHeaderLocalResponse::setDstInst(Http::RequestOrResponseHeaderMap& headers) {
+void SbiNfPeerInfoHeaderLocalResponse::setDstInst(SbiNfPeerInfoTokens& tokens) {
   ENVOY_LOG(trace, "set DstInst for Local Reply");
-  const auto value = SbiNfPeerInfo::getValueFromVector(original_sbi_request_header_,
-                                                       SbiNfPeerInfoHeaders::get().SrcInst);
+  const auto value = original_sbi_request_header_->get(Key::SrcInst);
   ENVOY_LOG(trace, "value: {}", value.value_or("empty"));
   if (value.has_value()) {
-    SbiNfPeerInfo::setDstInst(headers, std::string(value.value()));
+    tokens.set(Key::DstInst, value.value());
   }
 }
 
-void SbiNfPeerInfoHeaderLocalResponse::setDstScp(Http::RequestOrResponseHeaderMap& headers) {
+void SbiNfPeerInfoHeaderLocalResponse::setDstScp(SbiNfPeerInfoTokens& tokens) {
   ENVOY_LOG(trace, "set DstScp for Local Reply");
-  const auto value = SbiNfPeerInfo::getValueFromVector(original_sbi_request_header_,
-                                                       SbiNfPeerInfoHeaders::get().SrcScp);
+  const auto value = original_sbi_request_header_->get(Key::SrcScp);
   ENVOY_LOG(trace, "value: {}", value.value_or("empty"));
   if (value.has_value()) {
-    SbiNfPeerInfo::setDstScp(headers, std::string(value.value()));
+    SbiNfPeerInfo::setDstScp(tokens, value.value());
   } else {
     ENVOY_LOG(trace, "Delete dstScp");
-    SbiNfPeerInfo::deleteDstScp(headers);
+    tokens.remove(Key::DstScp);
   }
 }
 
-void SbiNfPeerInfoHeaderLocalResponse::setDstSepp(Http::RequestOrResponseHeaderMap& headers) {
+void SbiNfPeerInfoHeaderLocalResponse::setDstSepp(SbiNfPeerInfoTokens& tokens) {
   ENVOY_LOG(trace, "setDstSepp for Local Reply");
-  const auto value = SbiNfPeerInfo::getValueFromVector(original_sbi_request_header_,
-                                                       SbiNfPeerInfoHeaders::get().SrcSepp);
+  const auto value = original_sbi_request_header_->get(Key::SrcSepp);
 
   ENVOY_LOG(trace, "value: {}", value.value_or("empty"));
   if (value.has_value()) {
-    SbiNfPeerInfo::setDstSepp(headers, std::string(value.value()));
+    SbiNfPeerInfo::setDstSepp(tokens, value.value());
   } else {
     ENVOY_LOG(trace, "Delete dstSepp");
-    SbiNfPeerInfo::deleteDstSepp(headers);
+    tokens.remove(Key::DstSepp);
   }
 }
 
-void SbiNfPeerInfoHeaderLocalResponse::parseMetaData(
-    const envoy::config::core::v3::Metadata* cb_metadata) {
-  const auto& sbi_request_meta_or =
-      Envoy::Config::Metadata::metadataValue(cb_metadata, SbiMetadataKeys::get().filter,
-                                             SbiMetadataKeys::get().original_request_header_path);
-
-  original_sbi_request_header_ = absl::StrSplit(sbi_request_meta_or.string_value(),
-                                                absl::ByAnyChar("=; "), absl::SkipWhitespace());
-}
-
 SbiNfPeerInfoHeaderLocalResponse::SbiNfPeerInfoHeaderLocalResponse(
-    const envoy::config::core::v3::Metadata& cb_metadata) {
-  is_activated_ =
-      Envoy::Config::Metadata::metadataValue(&cb_metadata, SbiMetadataKeys::get().filter,
-                                             SbiMetadataKeys::get().nf_peer_info_handling_is_on)
-              .has_bool_value()
-          ? Envoy::Config::Metadata::metadataValue(
-                &cb_metadata, SbiMetadataKeys::get().filter,
-                SbiMetadataKeys::get().nf_peer_info_handling_is_on)
-                .bool_value()
-          : false;
+    const SbiNfPeerInfoState* state) {
+  is_activated_ = state != nullptr && state->isNfPeerInfoHandlingOn();
   if (is_activated_) {
-    parseMetaData(&cb_metadata);
+    original_sbi_request_header_ = &state->originalRequestHeader();
   }
 }
 
@@ -113,15 +92,19 @@ void SbiNfPeerInfoHeaderLocalResponse::setAll(Http::RequestOrResponseHeaderMap&
   }
   ENVOY_LOG(trace, "set all headers for Local Reply");
 
-  setSrcInst(headers);
-  setSrcServInst(headers);
+  auto tokens = SbiNfPeerInfoTokens::fromHeaders(headers);
+
+  setSrcInst(tokens);
+  setSrcServInst(tokens);
+
+  getNodeType() == "scp" ? setSrcScp(tokens) : setSrcSepp(tokens);
 
-  getNodeType() == "scp" ? setSrcScp(headers) : setSrcSepp(headers);
+  setDstInst(tokens);
+  setDstServInst(tokens);
+  setDstScp(tokens);
+  setDstSepp(tokens);
 
-  setDstInst(headers);
-  setDstServInst(headers);
-  setDstScp(headers);
-  setDstSepp(headers);
+  tokens.writeTo(headers);
 }
 
 bool SbiNfPeerInfoHeaderLocalResponse::isActivated() { return is_activated_; }
@@ -129,4 +112,4 @@ bool SbiNfPeerInfoHeaderLocalResponse::isActivated() { return is_activated_; }
 } // namespace EricProxy
 } // namespace HttpFilters
 } // namespace Extensions
-} // namespace Envoy
\ No newline at end of file
+} // namespace Envoy
@@ -1,6 +1,7 @@
 #pragma once
 #include "source/extensions/filters/http/eric_proxy/eric_sbi_nf_peer_info/sbi_nf_peer_info_int.h"
-#include "envoy/config/core/v3/base.pb.h"
+#include "source/extensions/filters/http/eric_proxy/eric_sbi_nf_peer_info/sbi_nf_peer_info_state.h"
+#include "source/common/common/logger.h"
 #include <string>
 #include "envoy/http/header_map.h"
 
@@ -10,32 +11,29 @@ namespace HttpFilters {
 namespace EricProxy {
 
 // sets sbi peer info header for local responses
-// all values are recovered from Metadata
+// all values are recovered from the nf peer info filter state
 class SbiNfPeerInfoHeaderLocalResponse : public SbiNfPeerInfoInterface,
                                          public Logger::Loggable<Logger::Id::eric_proxy> {
 private:
-  void setSrcInst(Http::RequestOrResponseHeaderMap& headers) override;
-  void setSrcServInst(Http::RequestOrResponseHeaderMap& headers) override;
-  void setSrcScp(Http::RequestOrResponseHeaderMap& headers) override;
-  void setSrcSepp(Http::RequestOrResponseHeaderMap& headers) override;
-  void setDstServInst(Http::RequestOrResponseHeaderMap& headers) override;
-  void setDstInst(Http::RequestOrResponseHeaderMap& headers) override;
-  void setDstScp(Http::RequestOrResponseHeaderMap& headers) override;
-  void setDstSepp(Http::RequestOrResponseHeaderMap& headers) override;
-
-  // restore original sbi peer info header and save it as original_sbi_request_header_ vector
-  // called in constructor
-  void parseMetaData(const envoy::config::core::v3::Metadata* cb_metadata);
+  void setSrcInst(SbiNfPeerInfoTokens& tokens) override;
+  void setSrcServInst(SbiNfPeerInfoTokens& tokens) override;
+  void setSrcScp(SbiNfPeerInfoTokens& tokens) override;
+  void setSrcSepp(SbiNfPeerInfoTokens& tokens) override;
+  void setDstServInst(SbiNfPeerInfoTokens& tokens) override;
+  void setDstInst(SbiNfPeerInfoTokens& tokens) override;
+  void setDstScp(SbiNfPeerInfoTokens& tokens) override;
+  void setDstSepp(SbiNfPeerInfoTokens& tokens) override;
 
   std::string own_fqdn_;
   std::string own_node_type_; // sepp or scp
   bool is_activated_ = false;
 
-  std::vector<absl::string_view>
-      original_sbi_request_header_; // original sbi peer info header saved in md from request
+  // original sbi peer info header saved in the filter state from request
+  const SbiNfPeerInfoTokens* original_sbi_request_header_ = nullptr;
 
 public:
-  SbiNfPeerInfoHeaderLocalResponse(const envoy::config::core::v3::Metadata& cb_metadata);
+  // state can be nullptr, then the handling is not activated
+  SbiNfPeerInfoHeaderLocalResponse(const SbiNfPeerInfoState* state);
   void setOwnFqdn(const std::string& own_fqdn) override { own_fqdn_ = own_fqdn; }
   void setAll(Http::RequestOrResponseHeaderMap& headers) override;
   void setNodeType(const std::string& node_type) override { own_node_type_ = node_type; }
@@ -50,4 +48,4 @@ public:
 } // namespace EricProxy
 } // namespace HttpFilters
 } // namespace Extensions
-} // namespace Envoy
\ No newline at end of file
+} // namespace Envoy
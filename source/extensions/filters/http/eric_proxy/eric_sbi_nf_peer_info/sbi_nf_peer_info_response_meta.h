@@ -1,7 +1,7 @@
 #pragma once
 #include "source/extensions/filters/http/eric_proxy/eric_sbi_nf_peer_info/sbi_nf_peer_info_int.h"
-#include "envoy/config/core/v3/base.pb.h"
-#include "envoy/extensions/filters/http/eric_proxy/v3/eric_proxy.pb.h"
+#include "source/extensions/filters/http/eric_proxy/eric_sbi_nf_peer_info/sbi_nf_peer_info_state.h"
+#include "source/common/common/logger.h"
 #include <string>
 #include "envoy/http/header_map.h"
 
@@ -10,39 +10,36 @@ namespace Extensions {
 namespace HttpFilters {
 namespace EricProxy {
 // Process response sbi nf peer info headers
-// data is taken from MD
-// Needs dynamic metadata
+// data is taken from the nf peer info filter state
 class SbiNfPeerInfoHeaderResponseMetadata : public SbiNfPeerInfoInterface,
                                             public Logger::Loggable<Logger::Id::eric_proxy> {
 private:
-  void setSrcInst(Http::RequestOrResponseHeaderMap& headers) override;
-  void setSrcServInst(Http::RequestOrResponseHeaderMap& headers) override;
-  void setSrcScp(Http::RequestOrResponseHeaderMap& headers) override;
-  void setSrcSepp(Http::RequestOrResponseHeaderMap& headers) override;
-  void setDstServInst(Http::RequestOrResponseHeaderMap& headers) override;
-  void setDstInst(Http::RequestOrResponseHeaderMap& headers) override;
-  void setDstScp(Http::RequestOrResponseHeaderMap& headers) override;
-  void setDstSepp(Http::RequestOrResponseHeaderMap& headers) override;
-
-  //parse md and sets original_sbi_request_header_ and updated_sbi_request_header_ vectors
-  void parseMetaData(const envoy::config::core::v3::Metadata* cb_metadata);
+  void setSrcInst(SbiNfPeerInfoTokens& tokens) override;
+  void setSrcServInst(SbiNfPeerInfoTokens& tokens) override;
+  void setSrcScp(SbiNfPeerInfoTokens& tokens) override;
+  void setSrcSepp(SbiNfPeerInfoTokens& tokens) override;
+  void setDstServInst(SbiNfPeerInfoTokens& tokens) override;
+  void setDstInst(SbiNfPeerInfoTokens& tokens) override;
+  void setDstScp(SbiNfPeerInfoTokens& tokens) override;
+  void setDstSepp(SbiNfPeerInfoTokens& tokens) override;
 
   std::string own_fqdn_;
   std::string own_node_type_;
   bool is_activated_ = false;
 
-  std::vector<absl::string_view> original_sbi_request_header_; // original request sbi peer info header
-  std::vector<absl::string_view> updated_sbi_request_header_; // updated sbi beer info header after router phase
+  // original request sbi peer info header
+  const SbiNfPeerInfoTokens* original_sbi_request_header_ = nullptr;
+  // updated sbi peer info header after router phase
+  const SbiNfPeerInfoTokens* updated_sbi_request_header_ = nullptr;
 
 public:
   void setOwnFqdn(const std::string& own_fqdn) override { own_fqdn_ = own_fqdn; }
   void setAll(Http::RequestOrResponseHeaderMap& headers) override;
   void setNodeType(const std::string& node_type) override { own_node_type_ = node_type; }
 
-  SbiNfPeerInfoHeaderResponseMetadata(const envoy::config::core::v3::Metadata& cb_metadata);
+  // state can be nullptr, then the handling is not activated
+  SbiNfPeerInfoHeaderResponseMetadata(const SbiNfPeerInfoState* state);
 
-  void removeDstSepp(Http::RequestOrResponseHeaderMap& headers);
-  void removeDstScp(Http::RequestOrResponseHeaderMap& headers);
   bool isActivated() override;
 
   std::string getNodeType() { return own_node_type_; };
@@ -52,4 +49,4 @@ public:
 } // namespace EricProxy
 } // namespace HttpFilters
 } // namespace Extensions
-} // namespace Envoy
\ No newline at end of file
+} // namespace Envoy
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include "envoy/stream_info/filter_state.h"
+
+#include "source/extensions/filters/http/eric_proxy/eric_sbi_nf_peer_info/sbi_nf_peer_info_tokens.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace HttpFilters {
+namespace EricProxy {
+
+/*
+ * A FilterState object to share the nf-peer-info handling data between eric_proxy
+ * (request and response path) and the router.
+ * The headers are stored pre-parsed, so no component has to re-split them.
+ */
+class SbiNfPeerInfoState : public StreamInfo::FilterState::Object {
+public:
+  static const std::string& key() {
+    CONSTRUCT_ON_FIRST_USE(std::string, "envoy.eric_proxy.sbi_nf_peer_info_state");
+  }
+
+  // Returns the state of the stream, creates an empty one if there is none yet
+  static SbiNfPeerInfoState& getOrCreate(StreamInfo::FilterState& filter_state) {
+    auto* state = filter_state.getDataMutable<SbiNfPeerInfoState>(key());
+    if (state == nullptr) {
+      auto new_state = std::make_shared<SbiNfPeerInfoState>();
+      state = new_state.get();
+      filter_state.setData(key(), std::move(new_state), StreamInfo::FilterState::StateType::Mutable,
+                           StreamInfo::FilterState::LifeSpan::Request);
+    }
+    return *state;
+  }
+
+  // original sbi peer info header of the request (after in-request screening)
+  const SbiNfPeerInfoTokens& originalRequestHeader() const { return original_request_header_; }
+  SbiNfPeerInfoTokens& originalRequestHeader() { return original_request_header_; }
+
+  // sbi peer info header as modified by discovery/router
+  const SbiNfPeerInfoTokens& updatedRequestHeader() const { return updated_request_header_; }
+  SbiNfPeerInfoTokens& updatedRequestHeader() { return updated_request_header_; }
+
+  // own node type: "scp", "sepp" or empty if unknown
+  const std::string& nodeType() const { return node_type_; }
+  void setNodeType(const std::string& node_type) { node_type_ = node_type; }
+
+  const std::string& ownFqdn() const { return own_fqdn_; }
+  void setOwnFqdn(const std::string& own_fqdn) { own_fqdn_ = own_fqdn; }
+
+  bool isNfPeerInfoHandlingOn() const { return nf_peer_info_handling_is_on_; }
+  void setNfPeerInfoHandlingOn(bool is_on) { nf_peer_info_handling_is_on_ = is_on; }
+
+  bool isRequestOutScreeningOn() const { return request_out_screening_is_on_; }
+  void setRequestOutScreeningOn(bool is_on) { request_out_screening_is_on_ = is_on; }
+
+private:
+  SbiNfPeerInfoTokens original_request_header_;
+  SbiNfPeerInfoTokens updated_request_header_;
+  std::string node_type_;
+  std::string own_fqdn_;
+  bool nf_peer_info_handling_is_on_{false};
+  bool request_out_screening_is_on_{false};
+};
+
+} // namespace EricProxy
+} // namespace HttpFilters
+} // namespace Extensions
+} // namespace Envoy
@@ -0,0 +1,149 @@
+#include "source/extensions/filters/http/eric_proxy/eric_sbi_nf_peer_info/sbi_nf_peer_info_tokens.h"
+#include "source/extensions/filters/http/eric_proxy/eric_sbi_nf_peer_info/sbi_nf_peer_info_values.h"
+
+#include <algorithm>
+#include <array>
+
+#include "source/common/http/header_utility.h"
+#include "absl/strings/ascii.h"
+#include "absl/strings/str_cat.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace HttpFilters {
+namespace EricProxy {
+
+namespace {
+// Token names, indexed by SbiNfPeerInfoTokens::Key
+constexpr std::array<absl::string_view, static_cast<size_t>(SbiNfPeerInfoTokens::Key::NumKeys)>
+    KeyNames = {"srcinst", "srcservinst", "srcscp",  "srcsepp",
+                "dstinst", "dstservinst", "dstscp",  "dstsepp"};
+} // namespace
+
+absl::string_view SbiNfPeerInfoTokens::keyName(Key key) { return KeyNames[static_cast<size_t>(key)]; }
+
+absl::optional<SbiNfPeerInfoTokens::Key> SbiNfPeerInfoTokens::keyFromName(absl::string_view name) {
+  for (size_t i = 0; i < KeyNames.size(); i++) {
+    if (KeyNames[i] == name) {
+      return static_cast<Key>(i);
+    }
+  }
+  return absl::nullopt;
+}
+
+SbiNfPeerInfoTokens
+SbiNfPeerInfoTokens::fromHeaders(const Http::RequestOrResponseHeaderMap& headers) {
+  SbiNfPeerInfoTokens tokens;
+  const auto get_as_string =
+      Http::HeaderUtility::getAllOfHeaderAsString(headers, SbiNfPeerInfoHeaders::get().Root, ";");
+  if (get_as_string.result()) {
+    tokens.parse(get_as_string.result().value());
+  }
+  return tokens;
+}
+
+void SbiNfPeerInfoTokens::parse(absl::string_view header_value) {
+  clear();
+  // Single pass over the header value: "key1=value1; key2=value2". Repeated headers are
+  // merged into the inline header with ",", which separates tokens as well.
+  while (!header_value.empty()) {
+    const size_t end = header_value.find_first_of(";,");
+    const absl::string_view token = absl::StripAsciiWhitespace(header_value.substr(0, end));
+    header_value.remove_prefix(end == absl::string_view::npos ? header_value.size() : end + 1);
+    if (token.empty()) {
+      continue;
+    }
+    const size_t eq = token.find('=');
+    absl::optional<Key> key;
+    if (eq != absl::string_view::npos) {
+      key = keyFromName(absl::StripTrailingAsciiWhitespace(token.substr(0, eq)));
+    }
+    if (key.has_value()) {
+      tokens_.push_back(
+          {key, std::string(absl::StripLeadingAsciiWhitespace(token.substr(eq + 1)))});
+    } else {
+      tokens_.push_back({absl::nullopt, std::string(token)});
+    }
+  }
+  modified_ = false;
+}
+
+const SbiNfPeerInfoTokens::Token* SbiNfPeerInfoTokens::find(Key key) const {
+  // The first occurrence of a token wins
+  for (const auto& token : tokens_) {
+    if (token.key_ == key) {
+      return &token;
+    }
+  }
+  return nullptr;
+}
+
+absl::optional<absl::string_view> SbiNfPeerInfoTokens::get(Key key) const {
+  const Token* token = find(key);
+  if (token == nullptr) {
+    return absl::nullopt;
+  }
+  return absl::string_view(token->text_);
+}
+
+void SbiNfPeerInfoTokens::set(Key key, std::string&& value) {
+  tokens_.erase(std::remove_if(tokens_.begin(), tokens_.end(),
+                               [key](const Token& token) { return token.key_ == key; }),
+                tokens_.end());
+  tokens_.push_back({key, std::move(value)});
+  appended_ = true;
+  modified_ = true;
+}
+
+void SbiNfPeerInfoTokens::remove(Key key) {
+  if (tokens_.empty()) {
+    return;
+  }
+  tokens_.erase(std::remove_if(tokens_.begin(), tokens_.end(),
+                               [key](const Token& token) { return token.key_ == key; }),
+                tokens_.end());
+  appended_ = false;
+  modified_ = true;
+}
+
+void SbiNfPeerInfoTokens::clear() {
+  modified_ = modified_ || !tokens_.empty();
+  tokens_.clear();
+  appended_ = false;
+}
+
+bool SbiNfPeerInfoTokens::empty() const { return tokens_.empty(); }
+
+std::string SbiNfPeerInfoTokens::toString() const {
+  std::string header_value;
+  for (size_t i = 0; i < tokens_.size(); i++) {
+    absl::string_view separator = "; ";
+    if (i == 0) {
+      separator = "";
+    } else if (appended_ && i == tokens_.size() - 1) {
+      separator = ";";
+    }
+    const Token& token = tokens_[i];
+    if (token.key_.has_value()) {
+      absl::StrAppend(&header_value, separator, keyName(token.key_.value()), "=", token.text_);
+    } else {
+      absl::StrAppend(&header_value, separator, token.text_);
+    }
+  }
+  return header_value;
+}
+
+void SbiNfPeerInfoTokens::writeTo(Http::RequestOrResponseHeaderMap& headers) const {
+  if (!modified_) {
+    return;
+  }
+  headers.remove(SbiNfPeerInfoHeaders::get().Root);
+  if (!empty()) {
+    headers.addCopy(SbiNfPeerInfoHeaders::get().Root, toString());
+  }
+}
+
+} // namespace EricProxy
+} // namespace HttpFilters
+} // namespace Extensions
+} // namespace Envoy
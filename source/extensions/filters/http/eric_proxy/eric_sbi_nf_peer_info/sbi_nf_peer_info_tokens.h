@@ -0,0 +1,88 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "envoy/http/header_map.h"
+
+#include "absl/strings/string_view.h"
+#include "absl/types/optional.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace HttpFilters {
+namespace EricProxy {
+
+// Pre-parsed representation of a 3gpp-Sbi-NF-Peer-Info header value.
+// The header is parsed once, all updates are applied to the parsed tokens and the
+// result is serialized once into the outgoing header.
+// The tokens keep the order of the header: setting a token moves it to the end, removing
+// it leaves the other tokens (including unknown ones) where they are. A header that was
+// not modified is not rewritten. This gives the same header value as editing the header
+// string token by token.
+class SbiNfPeerInfoTokens {
+public:
+  enum class Key : uint8_t {
+    SrcInst = 0,
+    SrcServInst,
+    SrcScp,
+    SrcSepp,
+    DstInst,
+    DstServInst,
+    DstScp,
+    DstSepp,
+    NumKeys
+  };
+
+  SbiNfPeerInfoTokens() = default;
+  explicit SbiNfPeerInfoTokens(absl::string_view header_value) { parse(header_value); }
+
+  // parse all 3gpp-Sbi-NF-Peer-Info headers of the map (multiple headers are joined by ";")
+  static SbiNfPeerInfoTokens fromHeaders(const Http::RequestOrResponseHeaderMap& headers);
+
+  // replaces the current content with the tokens of the given header value
+  void parse(absl::string_view header_value);
+
+  absl::optional<absl::string_view> get(Key key) const;
+  bool has(Key key) const { return find(key) != nullptr; }
+  // removes all occurrences of the token and appends it with the new value
+  void set(Key key, absl::string_view value) { set(key, std::string(value)); }
+  void set(Key key, std::string&& value);
+  // removes all occurrences of the token
+  void remove(Key key);
+  void clear();
+  bool empty() const;
+
+  // serialize the tokens into a header value: "key1=value1; key2=value2"
+  std::string toString() const;
+
+  // replace the 3gpp-Sbi-NF-Peer-Info header(s) in the map with the serialized tokens
+  // or remove the header if there are no tokens left. Nothing is done if the tokens were
+  // not modified since they were parsed.
+  void writeTo(Http::RequestOrResponseHeaderMap& headers) const;
+
+  // token name as used in the header, e.g. "srcinst"
+  static absl::string_view keyName(Key key);
+
+private:
+  struct Token {
+    // empty for unknown tokens
+    absl::optional<Key> key_;
+    // the value of a known token, the whole token for unknown ones
+    std::string text_;
+  };
+
+  static absl::optional<Key> keyFromName(absl::string_view name);
+  const Token* find(Key key) const;
+
+  // in header order, there are only a handful of tokens, so lookups are linear
+  std::vector<Token> tokens_;
+  // the last update appended a token, it is separated by ";" instead of "; "
+  bool appended_ = false;
+  bool modified_ = false;
+};
+
+} // namespace EricProxy
+} // namespace HttpFilters
+} // namespace Extensions
+} // namespace Envoy
@@ -23,6 +23,8 @@ public:
 };
 
 // Metadata's keys.
+// Data shared between eric_proxy and router is kept in SbiNfPeerInfoState, the
+// dynamic metadata only mirrors it for access logs and other filters.
 class SbiMetadataKeyValues {
 public:
   const std::string filter{"eric_proxy.sbi_nf_peer_info"};
@@ -165,19 +165,24 @@ Http::FilterHeadersStatus EricProxyFilter::decodeHeaders(Http::RequestHeaderMap&
   // NfPeerInfo handling (indicating sender, receiver, and if indirect routing also
   // SCP/SEPP handling the message). See TS 29.500 R17 ch. 5.2.3.2.21
   if (config_->isNfPeerinfoActivated()) {
-    // Store in dyn. metadata: original nf-peer-info header, own node type (scp/sepp),
-    // own FQDN, and that nf-peer-info-handling is on and request-out-screening is off(?).
-    // Data is used by the router code.
+    // Store in the nf-peer-info filter state: original (pre-parsed) nf-peer-info header,
+    // own node type (scp/sepp), own FQDN, and that nf-peer-info-handling is on and
+    // request-out-screening is off(?). Data is used by the router code.
     // ULID(S49)
-    SbiNfPeerInfoHeaderRequestMetadata::saveMetaData(config_->nodeTypeLc(), config_->ownFqdnLc(),
-                                                     decoder_callbacks_,
-                                                     *run_ctx_.getReqOrRespHeaders());
+    SbiNfPeerInfoHeaderRequestMetadata::saveState(config_->nodeTypeLc(), config_->ownFqdnLc(),
+                                                  decoder_callbacks_,
+                                                  *run_ctx_.getReqOrRespHeaders());
   }
 
   if (end_stream) {
     // If the HTTP/2 stream's end-flag is set, then it's a header-only-request without body.
     // Process it now:
     return processRequest();
+  } else if (!config_->isRequestBodyRequired()) {
+    // Body will follow, but no configured rule looks at it. Process the request now so
+    // that the headers are forwarded right away, the body is streamed through in decodeData.
+    request_body_streamed_ = true;
+    return processRequest();
   } else {
     // Body will follow. Remember the headers and stop filter-chain processing.
     // The body-processing in decodeData will call processRequest.
@@ -191,6 +196,15 @@ Http::FilterHeadersStatus EricProxyFilter::decodeHeaders(Http::RequestHeaderMap&
 Http::FilterDataStatus EricProxyFilter::decodeData(Buffer::Instance& data, bool end_stream) {
   ENVOY_STREAM_LOG(debug, "EricProxy filter '{}' invoked on request for body data",
                    *decoder_callbacks_, config_->protoConfig().name());
+  if (request_body_streamed_) {
+    // The request has been processed on the headers. Forward the body, unless the processing
+    // is paused (e.g. for an SLF lookup), then buffer it until decoding is continued.
+    return deferred_filter_case_ptr_ == nullptr ? Http::FilterDataStatus::Continue
+                                                : Http::FilterDataStatus::StopIterationAndBuffer;
+  }
+  // Raise the default limit before buffering if this is an occasional large message
+  const Buffer::Instance* buffered = decoder_callbacks_->decodingBuffer();
+  adaptMaxRequestBytesLimit((buffered != nullptr ? buffered->length() : 0) + data.length());
   // We need to buffer here because we are not using the buffer_filter
   decoder_callbacks_->addDecodedData(data, true);
 
@@ -220,6 +234,10 @@ Http::FilterDataStatus EricProxyFilter::decodeData(Buffer::Instance& data, bool
 
     // Checks passed, now process the request
     auto result = map_filter_to_data_status_.at(processRequest());
+    if (result == Http::FilterDataStatus::Continue) {
+      // The body is passed on and no longer buffered by this filter
+      request_body_reservation_.release();
+    }
     return result;
   } else {
     // Body not complete yet
@@ -267,15 +285,18 @@ Http::FilterHeadersStatus EricProxyFilter::encodeHeaders(Http::ResponseHeaderMap
   // ULID(S50) 
   if (config_->isNfPeerinfoActivated()) {
     ENVOY_STREAM_LOG(trace, "Nf Peerinfo is activated", *encoder_callbacks_);
+    const auto* sbi_nf_peer_info_state =
+        encoder_callbacks_->streamInfo().filterState()->getDataReadOnly<SbiNfPeerInfoState>(
+            SbiNfPeerInfoState::key());
     std::unique_ptr<SbiNfPeerInfoInterface> sbi_nf_peer_info_pr;
     if (local_reply_) {
       ENVOY_STREAM_LOG(trace, "It's a local reply", *encoder_callbacks_);
-      sbi_nf_peer_info_pr = std::make_unique<SbiNfPeerInfoHeaderLocalResponse>(
-          encoder_callbacks_->streamInfo().dynamicMetadata());
+      sbi_nf_peer_info_pr =
+          std::make_unique<SbiNfPeerInfoHeaderLocalResponse>(sbi_nf_peer_info_state);
     } else {
       ENVOY_STREAM_LOG(trace, "It's a standard reply", *encoder_callbacks_);
-      sbi_nf_peer_info_pr = std::make_unique<SbiNfPeerInfoHeaderResponseMetadata>(
-          encoder_callbacks_->streamInfo().dynamicMetadata());
+      sbi_nf_peer_info_pr =
+          std::make_unique<SbiNfPeerInfoHeaderResponseMetadata>(sbi_nf_peer_info_state);
     }
 
     sbi_nf_peer_info_pr->setOwnFqdn(config_->ownFqdnLc());
@@ -310,6 +331,10 @@ Http::FilterDataStatus EricProxyFilter::encodeData(Buffer::Instance& data, bool
   // 2) If a filter is going to look at all buffered data from within a data callback with end
   //    stream set, this method can be called to immediately buffer the data. This avoids having
   //    to deal with the existing buffered data and the data from the current callback.
+  if (!local_reply_) {
+    const Buffer::Instance* buffered = encoder_callbacks_->encodingBuffer();
+    adaptMaxResponseBytesLimit((buffered != nullptr ? buffered->length() : 0) + data.length());
+  }
   encoder_callbacks_->addEncodedData(data, true);
 
   // Check max message bytes for response body if not a local reply  ULID(A29)
@@ -352,6 +377,14 @@ Http::FilterDataStatus EricProxyFilter::encodeData(Buffer::Instance& data, bool
 void EricProxyFilter::cleanup() {
   ENVOY_STREAM_LOG(debug, "EricProxy filter {} destroyed.", *decoder_callbacks_,
                    config_->protoConfig().name());
+  ENVOY_STREAM_LOG(trace, "Run-context arena: {} bytes used, {} reserved, {} overflow blocks",
+                   *decoder_callbacks_, run_ctx_.arena().bytesUsed(),
+                   run_ctx_.arena().bytesReserved(), run_ctx_.arena().numOverflowBlocks());
+  if (run_ctx_.arena().numOverflowBlocks() > 0) {
+    stats_->runContextArenaStats().overflow_.inc();
+  }
+  request_body_reservation_.release();
+  response_body_reservation_.release();
   if (lookup_request_ != nullptr) {
     ENVOY_STREAM_LOG(debug, "Cancelling lookup request.", *decoder_callbacks_);
     lookup_request_->cancel();
@@ -546,6 +579,9 @@ Http::FilterHeadersStatus EricProxyFilter::processResponse() {
 Http::FilterHeadersStatus EricProxyFilter::processFilterCase(ProcessFcMode fc_mode) {
   // Most actions result in continuing the filter chain:
   pfcstate_headers_changed_ = false;
+  // The header map or the body may have been changed outside of the filter-case
+  // processing (e.g. request vs. response), nothing loaded before can be reused
+  resetLoadedFilterRuleData();
 
   while (true) {
     switch (pfcstate_next_state_) {
@@ -560,6 +596,7 @@ Http::FilterHeadersStatus EricProxyFilter::processFilterCase(ProcessFcMode fc_mo
             run_ctx_.isRequest(), (run_ctx_.isRequest()) ^ (config_->isOriginExt()));
       }
 
+      resetLoadedFilterRuleData();
       if (pfcstate_filter_case_ == nullptr) {
         ENVOY_STREAM_LOG(warn, "Could not find-filter case in config: {}",
                          *decoder_callbacks_, pfcstate_fc_name_);
@@ -606,7 +643,12 @@ Http::FilterHeadersStatus EricProxyFilter::processFilterCase(ProcessFcMode fc_mo
       updateVariablesForFilterRule(pfcstate_filter_rule_it_);
 
       // 8.3  Foreach header-value-index in header_value_indices_required:
-      for (const auto& hdr_val_idx : (*pfcstate_filter_rule_it_)->headerValueIndicesRequired()) {
+      for (const auto& [hdr_val_idx, earlier_rule] :
+           startLoadingFilterRule(pfcstate_filter_rule_it_).header_value_indices) {
+        // Already loaded for a previous filter-rule and no action has run since then
+        if (isLoadedByEarlierRule(earlier_rule)) {
+          continue;
+        }
         // 8.3.1  Copy (= make absl::string_view of) the contents of the header whose name
         //  is found by looking up header_configmap_reverse with the header-value-index
         auto hdr_name = std::string(run_ctx_.rootContext()->headerName(hdr_val_idx));
@@ -678,6 +720,8 @@ Http::FilterHeadersStatus EricProxyFilter::processFilterCase(ProcessFcMode fc_mo
       break;
 
     case FCState::ExecuteAction: {
+      // The action can modify headers, body or variables
+      resetLoadedFilterRuleData();
       auto [action_result, action_changed_headers, next_filter_case_name] =
           executeAction(**pfcstate_action_it_);
       switch (action_result) {
@@ -726,7 +770,7 @@ Http::FilterHeadersStatus EricProxyFilter::processFilterCase(ProcessFcMode fc_mo
 // Service Context Populated from request
 // ULID(S41)
 void EricProxyFilter::populateServiceContext(RunContext& run_ctx, Http::StreamDecoderFilterCallbacks* decoder_callbacks) {
-  auto itr = run_ctx.getReqHeaders()->get(Http::LowerCaseString("3gpp-Sbi-Callback"));
+  auto itr = run_ctx.getReqHeaders()->get(SbiHeaders::get().Callback);
   if (!itr.empty()) {
     // Its a notification request do standard extraction from getReqApi*
     const auto& api_name = getReqApiNameForSbaCb(itr[0]->value().getStringView());
@@ -789,13 +833,19 @@ void EricProxyFilter::populateServiceContext(RunContext& run_ctx, Http::StreamDe
 // Common code to update variables for the current or next filter rule
 void EricProxyFilter::updateVariablesForFilterRule(std::vector<std::shared_ptr<FilterRuleWrapper>>::const_iterator pfcstate_filter_rule_iterator){
   if (pfcstate_headers_changed_ || !areVariablesUpdatedByFc(pfcstate_filter_case_)) {
-    for (const auto& filter_data_weak : (*pfcstate_filter_rule_iterator)->filterdataRequired()) {
-      if (std::shared_ptr<FilterDataWrapper> filter_data{filter_data_weak.lock()}) {
-        ENVOY_STREAM_LOG(debug, "Processing filter data: {} for filter rule: {}",
-            *decoder_callbacks_, filter_data->name(), (*pfcstate_filter_rule_iterator)->name());
-        updateVariables(pfcstate_filter_case_, filter_data);
-        pfcstate_headers_changed_ = false;
+    for (const auto& [filter_data, earlier_rule] :
+         startLoadingFilterRule(pfcstate_filter_rule_iterator).filter_data) {
+      // Extracting the same filter-data again before an action has run gives the
+      // same values, skip it
+      if (isLoadedByEarlierRule(earlier_rule)) {
+        ENVOY_STREAM_LOG(trace, "Filter data: {} already processed for this filter case",
+            *decoder_callbacks_, filter_data->name());
+        continue;
       }
+      ENVOY_STREAM_LOG(debug, "Processing filter data: {} for filter rule: {}",
+          *decoder_callbacks_, filter_data->name(), (*pfcstate_filter_rule_iterator)->name());
+      updateVariables(pfcstate_filter_case_, filter_data);
+      pfcstate_headers_changed_ = false;
     }
   }
 }
@@ -1017,6 +1067,8 @@ void EricProxyFilter::continueProcessingAfterSlfResponse() {
     // We are not reaching this line if action-reject-message or action-drop-message
     // is invoked, so it's safe to clear the cached route.
     decoder_callbacks_->downstreamCallbacks()->clearRouteCache();
+    // The body is passed on and no longer buffered by this filter
+    request_body_reservation_.release();
     decoder_callbacks_->continueDecoding();
   }
   // else nothing because iteration is already stopped
@@ -1531,7 +1583,7 @@ void EricProxyFilter::addTaRInResponse(Http::StreamEncoderFilterCallbacks* callb
 
   // If there is already a tar header, do nothing because the previous SCP was closer to
   // the producer and knows better
-  const auto tar_hdr = resp_hdrs->get(Http::LowerCaseString("3gpp-sbi-target-apiroot"));
+  const auto tar_hdr = resp_hdrs->get(SbiHeaders::get().TargetApiRoot);
 
   // If the status code is not 2xx, do nothing because no new resouce was created
   const auto status_hdr = resp_hdrs->get(Http::LowerCaseString(":status"));
@@ -1566,7 +1618,7 @@ void EricProxyFilter::addTaRInResponse(Http::StreamEncoderFilterCallbacks* callb
   // Add the target-apiroot header to the response
   ENVOY_STREAM_LOG(debug, "Adding response header '3gpp-sbi-target-apiroot' with value '{}'",
         *callbacks, new_tar_header);
-  resp_hdrs->addCopy(Http::LowerCaseString("3gpp-sbi-target-apiroot"), new_tar_header);
+  resp_hdrs->addCopy(SbiHeaders::get().TargetApiRoot, new_tar_header);
 }
 
 
@@ -2103,13 +2155,13 @@ void EricProxyFilter::createTargetApiRootfromString(std::string& new_value, Http
     tar_value = absl::StrCat(scheme, "://", new_value);
   }
   ENVOY_STREAM_LOG(trace, "created 3gpp-Sbi-target-apiRoot:{}, from value:{}",*decoder_callbacks_, tar_value, new_value);
-  headers->setCopy(Http::LowerCaseString("3gpp-Sbi-target-apiRoot"), tar_value);
+  headers->setCopy(SbiHeaders::get().TargetApiRoot, tar_value);
 }
 
 // Create and store the 3gpp-Sbi-Target-apiRoot header from a decoded T-FQDN Label (incl. a scheme)
 void EricProxyFilter::createTargetApiRootfromDecodedTFqdnLabel(std::string& new_value, Http::RequestOrResponseHeaderMap* headers) {
   ENVOY_STREAM_LOG(trace, "created 3gpp-Sbi-target-apiRoot:{},",*decoder_callbacks_, new_value);
-  headers->setCopy(Http::LowerCaseString("3gpp-Sbi-target-apiRoot"), new_value);
+  headers->setCopy(SbiHeaders::get().TargetApiRoot, new_value);
 }
 
 // Check if the authority header contains only the own fqdn. An eventual port is ignored.
@@ -15,6 +15,7 @@
 #include "source/extensions/filters/http/eric_proxy/proxy_filter_config.h"
 #include "source/extensions/filters/http/eric_proxy/stats.h"
 #include "source/extensions/filters/http/eric_proxy/wrappers.h"
+#include "source/extensions/filters/http/eric_proxy/sbi_custom_headers.h"
 #include "source/common/common/statusor.h"
 #include "source/common/config/metadata.h"
 #include "source/common/eric_event/eric_event_reporter.h"
@@ -94,6 +95,41 @@ struct NfInstance {
   }
 };
 
+// NF discovery result decoded once into packed arrays (struct-of-arrays).
+// All values the NF selection routines need (hosts, port, scheme, priority, capacity,
+// nf-set-id) are pre-extracted, so selectNfOnPriority() and selectTarsForRemoteRouting()
+// only do linear scans over these arrays instead of repeatedly walking the JSON DOM.
+// Malformed parts only keep the status of their cause while decoding: the selection
+// routines return that status only if they reach the element, exactly as when walking
+// the JSON.
+struct NfDiscoveryResult {
+  // IP version the hosts were extracted for
+  IPver ip_version = IPver::Default;
+
+  // NF instances, indexed by instance
+  std::vector<uint32_t> instance_first_service; // size: number of instances + 1
+  std::vector<absl::Status> instance_services_status; // nfServiceList/nfServices malformed
+  std::vector<absl::StatusOr<std::string>> instance_nf_set_id;
+  std::vector<absl::optional<std::string>> instance_nf_instance_id;
+
+  // NF services of all instances, indexed by service
+  std::vector<absl::StatusOr<std::string>> service_scheme;
+  std::vector<absl::StatusOr<std::string>> service_api_prefix;
+  // Malformed ipEndPoints, host or port. Endpoints are only decoded for a valid scheme.
+  std::vector<absl::Status> service_endpoints_status;
+  std::vector<bool> service_has_ip_endpoints;
+  std::vector<absl::StatusOr<uint64_t>> service_priority;
+  std::vector<absl::StatusOr<uint64_t>> service_capacity;
+  std::vector<uint32_t> service_first_authority; // size: number of services + 1
+
+  // "host:port" of the endpoints of all services, indexed by authority
+  std::vector<std::string> authorities;
+
+  size_t numInstances() const { return instance_first_service.size() - 1; }
+  const absl::Status& endpointsStatus(size_t service) const;
+  const absl::Status& priorityAndCapacityStatus(size_t service) const;
+};
+
 
 // Response code details for actions: reject-message, drop-message, modify-status-code. Used when sending local replies
 struct EricProxyResponseCodeDetailValues {
@@ -295,9 +331,13 @@ public:
       const std::string& metadata_parent, const std::string& metadata_child);
 
   // Option D
+  // Decode the NF discovery result once into packed arrays for the selection routines
+  static NfDiscoveryResult decodeNfDiscoveryResult(const Json& nlf_lookup_result,
+                                                   const IPver& ip_version);
   // Extract constraints parameters (preferred host + port and nf-set-id)
   // from NLF lookup result on reception of initial request
   static absl::StatusOr<NfInstance> selectNfOnPriority(const Json& nlf_lookup_result, const IPver& ip_version);
+  static absl::StatusOr<NfInstance> selectNfOnPriority(const NfDiscoveryResult& discovery_result);
   // Extract list of TaRs from NLF lookup result for remote routing
   static absl::StatusOr<std::vector<std::string>> selectTarsForRemoteRouting(
     const Json& nlf_lookup_result, const uint32_t& num_reselections, const IPver& ip_version,
@@ -305,33 +345,22 @@ public:
     const absl::optional<uint32_t>& num_retries = absl::nullopt,
     const absl::optional<std::string>& preferred_tar = absl::nullopt
   );
-  static absl::Status getHighPriorityEndpointsFromNfService(
-    const Json& nf_instance, const Json& nf_service, const IPver& ip_version,
-    std::pair<std::vector<NfInstance>,std::vector<uint64_t>>& high_priority_endpoints,
-    std::set<std::string>& unique_hostnames, uint64_t& max_priority
-  );
-  static absl::Status getPriorityLevelsFromNfService(
-    const Json& nf_instance, const Json& nf_service, const IPver& ip_version,
-    std::map<uint64_t, std::pair<std::vector<std::string>,
-    std::vector<uint64_t>>>& priority_levels, std::set<std::string>& unique_tars,
+  static absl::StatusOr<std::vector<std::string>> selectTarsForRemoteRouting(
+    const NfDiscoveryResult& discovery_result, const uint32_t& num_reselections,
+    const absl::optional<std::string>& nf_set_id = absl::nullopt,
+    const absl::optional<uint32_t>& num_retries = absl::nullopt,
     const absl::optional<std::string>& preferred_tar = absl::nullopt
   );
+  static void decodeNfService(const Json& nf_instance, const Json& nf_service,
+                              NfDiscoveryResult& discovery_result);
   static absl::StatusOr<std::string> getSchemeForEndpoint(const Json& nf_service);
   static absl::StatusOr<std::string> getApiPrefixForEndpoint(const Json& nf_service);
-  static absl::StatusOr<std::vector<std::string>> getHostnameListForEndpoints(
-    const Json& nf_instance, const Json& nf_service, const IPver& ip_version,
-    const absl::optional<Json>& ip_endpoint = absl::nullopt
-  );
-  static absl::StatusOr<std::vector<std::string>> getTarListForEndpoints(
-    const std::string& scheme,const std::string& api_prefix, const Json& nf_instance, const Json& nf_service,
-    const IPver& ip_version, const absl::optional<Json>& ip_endpoint = absl::nullopt
-  );
   static absl::StatusOr<std::vector<std::string>> getHostListForEndpoints(
     const Json& nf_instance, const Json& nf_service, const IPver& ip_version,
-    const absl::optional<Json>& ip_endpoint = absl::nullopt
+    const Json* ip_endpoint = nullptr
   );
   static absl::StatusOr<std::string> getPortForEndpoint(
-    const Json& nf_service, const absl::optional<Json>& ip_endpoint = absl::nullopt
+    const Json& nf_service, const Json* ip_endpoint = nullptr
   );
   static absl::StatusOr<std::string> getNfSetIdForEndpoint(const Json& nf_instance);
   static absl::optional<std::string> getNfInstanceIdForEndpoint(const Json& nf_instance);
@@ -356,6 +385,11 @@ private:
   std::shared_ptr<FilterCaseWrapper> pfcstate_filter_case_;
   std::vector<std::shared_ptr<FilterActionWrapper>>::const_iterator pfcstate_action_it_;
   std::vector<std::shared_ptr<FilterRuleWrapper>>::const_iterator pfcstate_filter_rule_it_;
+  // Index of the first filter-rule of the current filter-case loaded since the last
+  // executed action. Until the next action runs neither the headers nor the body can
+  // change, so values that filter-rule or a later one loaded are not loaded again
+  // (see FilterCaseWrapper::loadPlan()).
+  size_t pfcstate_loaded_from_rule_ = FilterCaseWrapper::NoEarlierRule;
 
   Http::StreamDecoderFilterCallbacks* decoder_callbacks_;
   Http::StreamEncoderFilterCallbacks* encoder_callbacks_;
@@ -367,6 +401,9 @@ private:
   // The result of an action-nf-discovery, parsed JSON
   // If the parsing failed or it was never parsed, the value will be a Json null
   Json discovery_result_json_;
+  // The result of an action-nf-discovery decoded for nf_disc_ip_version_, shared by
+  // nf-selection-on-priority and remote routing
+  absl::optional<NfDiscoveryResult> nf_discovery_result_;
   // The NF set id found from the result of an action-nf-discovery with nf-selection-on-priority.
   // If NF set id can not be found from the result, then it would be nullopt.
   absl::optional<std::string> nf_set_id_;
@@ -582,6 +619,20 @@ private:
   void updateVariables(std::shared_ptr<FilterCaseWrapper>, std::shared_ptr<FilterDataWrapper>);
   bool areVariablesUpdatedByFc(std::shared_ptr<FilterCaseWrapper>);
   void updateVariablesForFilterRule(std::vector<std::shared_ptr<FilterRuleWrapper>>::const_iterator pfcstate_filter_rule_iterator);
+  // Forget which filter-data and header values have been loaded (after an action)
+  void resetLoadedFilterRuleData() { pfcstate_loaded_from_rule_ = FilterCaseWrapper::NoEarlierRule; }
+  // Mark the filter-rule as loaded and return its load plan
+  const FilterCaseWrapper::FilterRuleLoadPlan& startLoadingFilterRule(
+      std::vector<std::shared_ptr<FilterRuleWrapper>>::const_iterator filter_rule_it) {
+    const size_t rule_idx = filter_rule_it - pfcstate_filter_case_->filterRules().begin();
+    pfcstate_loaded_from_rule_ = std::min(pfcstate_loaded_from_rule_, rule_idx);
+    return pfcstate_filter_case_->loadPlan(rule_idx);
+  }
+  // True if the value loaded by earlier_rule (from the load plan) is still loaded
+  bool isLoadedByEarlierRule(size_t earlier_rule) const {
+    return earlier_rule != FilterCaseWrapper::NoEarlierRule &&
+           earlier_rule >= pfcstate_loaded_from_rule_;
+  }
 
   ActionResultTuple executeAction(const FilterActionWrapper& action);
 
@@ -631,6 +682,10 @@ private:
   void populateResponseValidationConfig(const bool& is_global);
   void setMaxRequestBytesLimit();
   void setMaxResponseBytesLimit();
+  // Raise the default limit for a body about to grow to length bytes if the worker's
+  // body buffer budget can hold it. Configured limits are never raised.
+  void adaptMaxRequestBytesLimit(uint64_t length);
+  void adaptMaxResponseBytesLimit(uint64_t length);
   // following functions perform firewall related checks
   // returns true if filter iteration should continue
   // and false otherwise
@@ -752,6 +807,17 @@ private:
   bool internalRejected();
   bool internal_rejected_ = false;
   bool local_reply_ = false;
+  // The request was processed on its headers, the body is not buffered
+  // (see EricProxyFilterConfig::isRequestBodyRequired())
+  bool request_body_streamed_ = false;
+  // Share of the worker's body buffer budget used by the buffered request and response
+  // bodies. Lets a body grow beyond the default limit if the worker has room for it.
+  BodyBufferReservation request_body_reservation_{BodyBufferBudget::forCurrentThread(),
+                                                  config_->bodyBufferWorkerMaxBytes(),
+                                                  stats_->bodyBufferStats()};
+  BodyBufferReservation response_body_reservation_{BodyBufferBudget::forCurrentThread(),
+                                                   config_->bodyBufferWorkerMaxBytes(),
+                                                   stats_->bodyBufferStats()};
 
   bool isReqMarkedTFqdn();
   std::optional<std::string> topo_hide_pseudo_fqdn_;
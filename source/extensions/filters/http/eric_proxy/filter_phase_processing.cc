@@ -67,8 +67,8 @@ Http::FilterHeadersStatus EricProxyFilter::processRequestFilterPhases() {
   ENVOY_STREAM_UL_LOG(debug, "End In-Request-Screening", *decoder_callbacks_, ULID(S36));
 
   if (config_->isNfPeerinfoActivated()) {
-    // ULID(S53) Store 3gpp-sbi-nf-peer-info header in dyn-MD
-    SbiNfPeerInfoHeaderRequestMetadata::updateSbiPeerInfoHeaderInMd(
+    // ULID(S53) Store 3gpp-sbi-nf-peer-info header in the nf-peer-info filter state
+    SbiNfPeerInfoHeaderRequestMetadata::updateSbiPeerInfoHeaderInState(
         decoder_callbacks_, *run_ctx_.getReqOrRespHeaders());
     // ULID(S54) Delete 3gpp-sbi-nf-peer-info header from request
     SbiNfPeerInfoHeaderRequestMetadata::deleteSbiInfoHeader(*run_ctx_.getReqOrRespHeaders());
@@ -204,7 +204,7 @@ Http::FilterHeadersStatus EricProxyFilter::processRequestFilterPhases() {
   if (findInDynMetadata(&decoder_callbacks_->streamInfo().dynamicMetadata().filter_metadata(),
                         "eric_proxy", "target-api-root-processing", "true")) {
     auto tar_hdr =
-        run_ctx_.getReqOrRespHeaders()->get(Http::LowerCaseString("3gpp-sbi-target-apiroot"));
+        run_ctx_.getReqOrRespHeaders()->get(SbiHeaders::get().TargetApiRoot);
     if (!tar_hdr.empty()) {
       ENVOY_STREAM_UL_LOG(debug, "Setting target-api-root-value dyn MD after egress screening:'{}'",
                           *decoder_callbacks_, ULID(S60), tar_hdr[0]->value().getStringView());
@@ -62,7 +62,22 @@ void EricProxyFilter::setMaxRequestBytesLimit() {
   if (request_bytes_check_) {
     decoder_callbacks_->setDecoderBufferLimit(request_bytes_check_->max_message_bytes().value());
   } else { // No limit is configured, set default limit
-    decoder_callbacks_->setDecoderBufferLimit(16000000);
+    decoder_callbacks_->setDecoderBufferLimit(BodyBufferBudget::DefaultMaxMessageBytes);
+  }
+}
+
+void EricProxyFilter::adaptMaxRequestBytesLimit(uint64_t length) {
+  // A configured limit is strict, the body is not accounted in the worker's budget
+  if (request_bytes_check_) {
+    return;
+  }
+  if (!request_body_reservation_.update(length)) {
+    return;
+  }
+  if (length > decoder_callbacks_->decoderBufferLimit()) {
+    ENVOY_STREAM_LOG(debug, "Request body of {} bytes exceeds the default limit, accepted",
+                     *decoder_callbacks_, length);
+    decoder_callbacks_->setDecoderBufferLimit(length);
   }
 }
 
@@ -149,7 +164,22 @@ void EricProxyFilter::setMaxResponseBytesLimit() {
   if (response_bytes_check_) {
     encoder_callbacks_->setEncoderBufferLimit(response_bytes_check_->max_message_bytes().value());
   } else { // No limit is configured, set default limit
-    encoder_callbacks_->setEncoderBufferLimit(16000000);
+    encoder_callbacks_->setEncoderBufferLimit(BodyBufferBudget::DefaultMaxMessageBytes);
+  }
+}
+
+void EricProxyFilter::adaptMaxResponseBytesLimit(uint64_t length) {
+  // A configured limit is strict, the body is not accounted in the worker's budget
+  if (response_bytes_check_) {
+    return;
+  }
+  if (!response_body_reservation_.update(length)) {
+    return;
+  }
+  if (length > encoder_callbacks_->encoderBufferLimit()) {
+    ENVOY_STREAM_LOG(debug, "Response body of {} bytes exceeds the default limit, accepted",
+                     *encoder_callbacks_, length);
+    encoder_callbacks_->setEncoderBufferLimit(length);
   }
 }
 
@@ -2,6 +2,10 @@
 #include "contexts.h"
 #include "source/extensions/filters/http/eric_proxy/wrappers.h"
 #include "source/extensions/common/tap/utility.h"
+#include "source/common/common/macros.h"
+#include "source/common/protobuf/utility.h"
+#include "absl/container/flat_hash_map.h"
+#include "absl/container/flat_hash_set.h"
 #include <memory>
 #include <utility>
 #include <vector>
@@ -22,7 +26,9 @@ EricProxyFilterConfig::EricProxyFilterConfig(const EricProxyConfig& proto_config
               ? absl::StrCat(" ", proto_config_.plmn_ids().primary_plmn_id().mcc(), "-",
                              proto_config_.plmn_ids().primary_plmn_id().mnc(), "; src: SEPP-",
                              own_fqdn_lc_)
-              : ""} {
+              : ""},
+      body_buffer_worker_max_bytes_(PROTOBUF_GET_WRAPPED_OR_DEFAULT(
+          proto_config, body_buffer_worker_max_bytes, BodyBufferBudget::DefaultWorkerBytes)) {
   ENVOY_LOG(debug, "EricProxyFilterConfig instantiated");
   populateRootContext();
   populateRpPoolMap();
@@ -35,6 +41,7 @@ EricProxyFilterConfig::EricProxyFilterConfig(const EricProxyConfig& proto_config
   populateUsfwActionsAfterThreshold();
   populateViaHeaderCtx();
   is_tfqdn_configured_ = root_ctx_.hasKlvt(proto_config_.callback_uri_klv_table());
+  populateRequestBodyRequired();
   switch (proto_config.ip_version()) {
   case envoy::extensions::filters::http::eric_proxy::v3::IPFamily::Default:
   case envoy::extensions::filters::http::eric_proxy::v3::IPFamily::IPv4:
@@ -805,6 +812,151 @@ void EricProxyFilterConfig::populateViaHeaderCtx() {
   }
 }
 
+namespace {
+
+using Protobuf::FieldDescriptor;
+using Protobuf::Message;
+using Protobuf::Reflection;
+
+using FieldPredicate = bool (*)(const Message& message, const FieldDescriptor* field);
+
+const absl::flat_hash_set<absl::string_view>& requestBodyFieldNames() {
+  CONSTRUCT_ON_FIRST_USE(absl::flat_hash_set<absl::string_view>,
+                         {"body_json_pointer", "request_body_json_pointer", "op_isvalidjson",
+                          "term_body", "action_modify_json_body", "action_create_body",
+                          "action_nf_discovery"});
+}
+
+// Fields of a filter case that read or modify the request body when the filter case is
+// processed in the request direction
+bool isRequestBodyFieldInRequest(const Message&, const FieldDescriptor* field) {
+  return requestBodyFieldNames().contains(field->name());
+}
+
+// Fields of a filter case that read the request body when the filter case is processed in
+// the response direction. There, body_json_pointer and the body actions work on the
+// response body.
+bool isRequestBodyFieldInResponse(const Message& message, const FieldDescriptor* field) {
+  // request_body is the source of op_isvalidjson
+  if (field->name() == "request_body_json_pointer" || field->name() == "request_body") {
+    return true;
+  }
+  return field->name() == "term_body" &&
+         message.GetReflection()->GetString(message, field) == "request";
+}
+
+// Return true if the predicate holds for a field set anywhere in the message
+bool hasField(const Message& message, FieldPredicate predicate) {
+  const Reflection* reflection = message.GetReflection();
+  std::vector<const FieldDescriptor*> fields;
+  reflection->ListFields(message, &fields);
+  for (const FieldDescriptor* field : fields) {
+    if (predicate(message, field)) {
+      return true;
+    }
+    if (field->cpp_type() != FieldDescriptor::CPPTYPE_MESSAGE) {
+      continue;
+    }
+    if (field->is_repeated()) {
+      for (int i = 0; i < reflection->FieldSize(message, field); i++) {
+        if (hasField(reflection->GetRepeatedMessage(message, field, i), predicate)) {
+          return true;
+        }
+      }
+    } else if (hasField(reflection->GetMessage(message, field), predicate)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// Names of the start filter cases of the given filter phases
+std::vector<std::string>
+startFilterCases(std::initializer_list<std::shared_ptr<FilterPhaseWrapper>> fp_wrappers) {
+  std::vector<std::string> fc_names;
+  for (const auto& fp_wrapper : fp_wrappers) {
+    if (fp_wrapper == nullptr) {
+      continue;
+    }
+    fc_names.insert(fc_names.end(), fp_wrapper->own_nw_fc_.begin(), fp_wrapper->own_nw_fc_.end());
+    fc_names.insert(fc_names.end(), fp_wrapper->ext_nw_fc_default_.begin(),
+                    fp_wrapper->ext_nw_fc_default_.end());
+    for (const auto& [rp_name, rp_fc_names] : fp_wrapper->ext_nw_per_rp_fc_) {
+      fc_names.insert(fc_names.end(), rp_fc_names.begin(), rp_fc_names.end());
+    }
+    for (const auto& [cluster_name, cluster_fc_names] : fp_wrapper->cluster_fc_) {
+      fc_names.insert(fc_names.end(), cluster_fc_names.begin(), cluster_fc_names.end());
+    }
+  }
+  return fc_names;
+}
+
+// Return the name of the first filter case among the given ones and the ones reachable from
+// them through goto actions for which the predicate holds for a field, or an empty string
+std::string
+findFilterCase(const absl::flat_hash_map<absl::string_view, const FilterCase*>& fc_by_name,
+               std::vector<std::string> fc_names, FieldPredicate predicate) {
+  absl::flat_hash_set<std::string> visited;
+  while (!fc_names.empty()) {
+    std::string fc_name = std::move(fc_names.back());
+    fc_names.pop_back();
+    if (!visited.insert(fc_name).second) {
+      continue;
+    }
+    const auto it = fc_by_name.find(fc_name);
+    if (it == fc_by_name.end()) {
+      continue;
+    }
+    if (hasField(*it->second, predicate)) {
+      return fc_name;
+    }
+    for (const auto& fr : it->second->filter_rules()) {
+      for (const auto& action : fr.actions()) {
+        if (action.has_action_goto_filter_case()) {
+          fc_names.push_back(action.action_goto_filter_case());
+        }
+      }
+    }
+  }
+  return "";
+}
+
+} // namespace
+
+// The request body is needed if any filter case that can run in the request direction
+// (start filter cases of the in-request-screening, routing and out-request-screening phases,
+// and all filter cases reachable from them through goto actions) uses the body, or if any
+// filter case that can run in the response direction (same for the in- and
+// out-response-screening phases) reads the request body.
+// A SEPP always needs the body (T-FQDN, topology hiding, firewall checks), as does a
+// configured request message validation (body size and JSON checks).
+void EricProxyFilterConfig::populateRequestBodyRequired() {
+  if (isSeppNode() || proto_config_.has_request_validation()) {
+    request_body_required_ = true;
+    return;
+  }
+
+  absl::flat_hash_map<absl::string_view, const FilterCase*> fc_by_name;
+  for (const auto& fc : proto_config_.filter_cases()) {
+    fc_by_name.emplace(fc.name(), &fc);
+  }
+  std::string fc_name = findFilterCase(
+      fc_by_name, startFilterCases({fp_in_req_screening_, fp_routing_, fp_out_req_screening_}),
+      isRequestBodyFieldInRequest);
+  if (fc_name.empty()) {
+    fc_name = findFilterCase(fc_by_name,
+                             startFilterCases({fp_in_resp_screening_, fp_out_resp_screening_}),
+                             isRequestBodyFieldInResponse);
+  }
+  if (!fc_name.empty()) {
+    ENVOY_LOG(debug, "Request body required by filter case: {}", fc_name);
+    request_body_required_ = true;
+    return;
+  }
+  ENVOY_LOG(debug, "Request body not required, requests are processed on the headers");
+  request_body_required_ = false;
+}
+
 // Basically only used for SEPP because of other limitations in model
 std::string EricProxyFilterConfig::getFqdnForViaHeader(std::string rp_name) {
   const auto it = via_header_entries_.find(rp_name);
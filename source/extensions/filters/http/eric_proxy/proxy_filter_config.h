@@ -8,6 +8,7 @@
 #include "envoy/extensions/filters/http/eric_proxy/v3/eric_proxy.pb.h"
 #include "source/common/common/logger.h"
 
+#include "source/extensions/filters/http/eric_proxy/body_buffer_budget.h"
 #include "source/extensions/filters/http/eric_proxy/contexts.h"
 #include "envoy/upstream/cluster_manager.h"
 #include "re2/re2.h"
@@ -262,6 +263,16 @@ public:
   ActionOnFailure response_action_after_threshold_;
 
   void populateViaHeaderCtx() ;
+
+  // False if the request body is not needed to process a request: no rule of the filter cases
+  // reachable in the request direction reads or modifies the request body, no rule of the filter
+  // cases reachable in the response direction reads the request body, and neither message
+  // validation nor SEPP processing is configured. The request is then processed on the headers
+  // and the body is forwarded as it arrives instead of being buffered.
+  bool isRequestBodyRequired() const { return request_body_required_; }
+
+  // Budget for the bodies buffered by the eric_proxy filters of one worker, see BodyBufferBudget
+  uint64_t bodyBufferWorkerMaxBytes() const { return body_buffer_worker_max_bytes_; }
  
   std::string getFqdnForViaHeader(std::string rp_name);
   
@@ -291,7 +302,9 @@ private:
   // DND-601513: gpp-sbi-originating-network-id header handling. Hardcoded header value for when the
   // SEPP adds the header, instead of constructing it repeatedly on runtime
   const std::string network_id_header_val_;
+  const uint64_t body_buffer_worker_max_bytes_;
   bool is_tfqdn_configured_ = false;
+  bool request_body_required_ = true;
   RootContext root_ctx_; // common for all requests
 
   std::map<std::string, std::string> rp_pool_map_;
@@ -323,6 +336,9 @@ private:
   // Populate USFW actions after threshold is reached for header checks
   void populateUsfwActionsAfterThreshold();
 
+  // Determine if the request body has to be buffered before a request is processed
+  void populateRequestBodyRequired();
+
   // map<rp-name, map<sc-name, map<fc-name, fc-wrapper>>>
   std::map<std::string,
            std::map<std::string, std::map<std::string, std::shared_ptr<FilterCaseWrapper>>>>
@@ -0,0 +1,45 @@
+#include "source/extensions/filters/http/eric_proxy/run_context_arena.h"
+
+#include <algorithm>
+
+namespace Envoy {
+namespace Extensions {
+namespace HttpFilters {
+namespace EricProxy {
+
+RunContextArenaStats generateRunContextArenaStats(Stats::Scope& scope) {
+  const std::string prefix = "http.eric_proxy.run_context_arena.";
+  return RunContextArenaStats{ALL_RUN_CONTEXT_ARENA_STATS(POOL_COUNTER_PREFIX(scope, prefix))};
+}
+
+RunContextArena::RunContextArena(size_t initial_size) : next_block_size_(initial_size) {}
+
+void* RunContextArena::allocate(size_t size, size_t alignment) {
+  auto aligned = reinterpret_cast<char*>(
+      (reinterpret_cast<uintptr_t>(current_) + alignment - 1) & ~(alignment - 1));
+  if (current_ == nullptr || aligned + size > end_) {
+    // The first block is only allocated on first use. Then the block size
+    // grows so that a request needing a lot of memory adds few blocks.
+    addBlock(size + alignment);
+    aligned = reinterpret_cast<char*>(
+        (reinterpret_cast<uintptr_t>(current_) + alignment - 1) & ~(alignment - 1));
+  }
+  bytes_used_ += (aligned - current_) + size;
+  current_ = aligned + size;
+  return aligned;
+}
+
+void RunContextArena::addBlock(size_t min_size) {
+  const size_t block_size = std::max(next_block_size_, min_size);
+  // Not value-initialized, memory is always written before it is read
+  blocks_.push_back(std::unique_ptr<char[]>(new char[block_size]));
+  current_ = blocks_.back().get();
+  end_ = current_ + block_size;
+  bytes_reserved_ += block_size;
+  next_block_size_ = block_size * 2;
+}
+
+} // namespace EricProxy
+} // namespace HttpFilters
+} // namespace Extensions
+} // namespace Envoy
@@ -0,0 +1,108 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+#include "envoy/stats/scope.h"
+#include "envoy/stats/stats_macros.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace HttpFilters {
+namespace EricProxy {
+
+#define ALL_RUN_CONTEXT_ARENA_STATS(COUNTER)                                                       \
+  COUNTER(overflow)
+
+// Requests whose run-context arena needed more than the initially sized block
+struct RunContextArenaStats {
+  ALL_RUN_CONTEXT_ARENA_STATS(GENERATE_COUNTER_STRUCT)
+};
+
+RunContextArenaStats generateRunContextArenaStats(Stats::Scope& scope);
+
+//--------------------------------------------------------------------------------------
+// Bump allocator for the per-request data of the eric_proxy filter (the containers in
+// the RunContext). Allocations are carved out of large blocks, nothing is freed before
+// the arena itself is destroyed together with the RunContext at the end of the stream.
+// If the first block is too small, more blocks are added (each twice the size of the
+// previous one). The bytes used are reported to the RootContext so that later arenas
+// can be sized from the observed needs.
+class RunContextArena {
+public:
+  explicit RunContextArena(size_t initial_size);
+  RunContextArena(const RunContextArena&) = delete;
+  RunContextArena& operator=(const RunContextArena&) = delete;
+
+  // Return memory for size bytes with the given alignment (a power of two)
+  void* allocate(size_t size, size_t alignment);
+
+  // Bytes handed out by allocate(), including alignment padding
+  size_t bytesUsed() const { return bytes_used_; }
+  // Bytes allocated from the heap for all blocks
+  size_t bytesReserved() const { return bytes_reserved_; }
+  // Number of blocks that had to be added after the first one
+  uint32_t numOverflowBlocks() const { return blocks_.empty() ? 0 : blocks_.size() - 1; }
+
+private:
+  void addBlock(size_t min_size);
+
+  std::vector<std::unique_ptr<char[]>> blocks_;
+  char* current_ = nullptr;
+  char* end_ = nullptr;
+  size_t next_block_size_;
+  size_t bytes_used_ = 0;
+  size_t bytes_reserved_ = 0;
+};
+
+//--------------------------------------------------------------------------------------
+// STL allocator on top of a RunContextArena. deallocate() is a no-op for arena memory,
+// the memory is released when the arena is destroyed. A default-constructed allocator
+// (no arena) uses the heap, so that containers without a RunContext (e.g. static
+// defaults) have the same type.
+template <class T> class ArenaAllocator {
+public:
+  using value_type = T;
+  using propagate_on_container_move_assignment = std::true_type;
+  using propagate_on_container_swap = std::true_type;
+
+  ArenaAllocator() noexcept = default;
+  explicit ArenaAllocator(RunContextArena* arena) noexcept : arena_(arena) {}
+  template <class U>
+  ArenaAllocator(const ArenaAllocator<U>& other) noexcept : arena_(other.arena()) {} // NOLINT
+
+  T* allocate(size_t n) {
+    if (arena_ == nullptr) {
+      return std::allocator<T>().allocate(n);
+    }
+    return static_cast<T*>(arena_->allocate(n * sizeof(T), alignof(T)));
+  }
+
+  void deallocate(T* ptr, size_t n) noexcept {
+    if (arena_ == nullptr) {
+      std::allocator<T>().deallocate(ptr, n);
+    }
+  }
+
+  RunContextArena* arena() const { return arena_; }
+
+  template <class U> bool operator==(const ArenaAllocator<U>& other) const {
+    return arena_ == other.arena();
+  }
+  template <class U> bool operator!=(const ArenaAllocator<U>& other) const {
+    return arena_ != other.arena();
+  }
+
+private:
+  RunContextArena* arena_ = nullptr;
+};
+
+template <class T> using ArenaVector = std::vector<T, ArenaAllocator<T>>;
+
+} // namespace EricProxy
+} // namespace HttpFilters
+} // namespace Extensions
+} // namespace Envoy
@@ -0,0 +1,45 @@
+#include "source/extensions/filters/http/eric_proxy/sbi_custom_headers.h"
+
+#include "absl/strings/match.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace HttpFilters {
+namespace EricProxy {
+
+using RequestHeaderHandle = Http::CustomInlineHeaderRegistry::Handle<
+    Http::CustomInlineHeaderRegistry::Type::RequestHeaders>;
+using ResponseHeaderHandle = Http::CustomInlineHeaderRegistry::Handle<
+    Http::CustomInlineHeaderRegistry::Type::ResponseHeaders>;
+
+static SbiCustomHeaders custom_headers;
+
+// clang-format off
+const RequestHeaderHandle SbiCustomHeaders::targetApiRoot() { return custom_headers.target_api_root_.handle(); }
+const RequestHeaderHandle SbiCustomHeaders::callback() { return custom_headers.callback_.handle(); }
+const RequestHeaderHandle SbiCustomHeaders::nfPeerInfo() { return custom_headers.nf_peer_info_.handle(); }
+const RequestHeaderHandle SbiCustomHeaders::routingBinding() { return custom_headers.routing_binding_.handle(); }
+
+const ResponseHeaderHandle SbiCustomHeaders::responseTargetApiRoot() { return custom_headers.response_target_api_root_.handle(); }
+const ResponseHeaderHandle SbiCustomHeaders::responseNfPeerInfo() { return custom_headers.response_nf_peer_info_.handle(); }
+// clang-format on
+
+// clang-format off
+SbiCustomHeaders::SbiCustomHeaders()
+    : target_api_root_(SbiHeaders::get().TargetApiRoot),
+      callback_(SbiHeaders::get().Callback),
+      nf_peer_info_(SbiHeaders::get().NfPeerInfo),
+      routing_binding_(SbiHeaders::get().RoutingBinding),
+      response_target_api_root_(SbiHeaders::get().TargetApiRoot),
+      response_nf_peer_info_(SbiHeaders::get().NfPeerInfo) {}
+// clang-format on
+
+bool SbiCustomHeaders::isDiscoveryHeader(const Http::HeaderEntry& header) {
+  // The keys in a header map are lower case
+  return absl::StartsWith(header.key().getStringView(), SbiHeaders::get().DiscoveryPrefix);
+}
+
+} // namespace EricProxy
+} // namespace HttpFilters
+} // namespace Extensions
+} // namespace Envoy
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <string>
+
+#include "envoy/http/header_map.h"
+
+#include "source/common/singleton/const_singleton.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace HttpFilters {
+namespace EricProxy {
+
+// Names of the 3GPP SBI headers (TS 29.500) looked up on every request
+class SbiHeaderValues {
+public:
+  const Http::LowerCaseString TargetApiRoot{"3gpp-sbi-target-apiroot"};
+  const Http::LowerCaseString Callback{"3gpp-sbi-callback"};
+  const Http::LowerCaseString NfPeerInfo{"3gpp-sbi-nf-peer-info"};
+  const Http::LowerCaseString RoutingBinding{"3gpp-sbi-routing-binding"};
+  // Prefix of the discovery headers, one per discovery parameter
+  const std::string DiscoveryPrefix{"3gpp-sbi-discovery-"};
+};
+
+using SbiHeaders = ConstSingleton<SbiHeaderValues>;
+
+//--------------------------------------------------------------------------------------
+// The SBI headers are registered as O(1) inline headers. The handles give direct access
+// to them, lookups through HeaderMap::get() also find them through the inline header
+// table instead of a search of all headers.
+// Note that values added to an inline header are appended to the existing header
+// (comma separated) instead of adding a second header with the same name. All of these
+// headers are single-valued (TS 29.500), so this only affects malformed messages:
+// - a repeated target-apiRoot is not a valid URI and is rejected by the routing actions
+// - header modifications append/prepend once to the merged value
+// - NF-Peer-Info tokens are separated by "," as well, so repeated headers parse as before
+struct SbiCustomHeaders {
+  SbiCustomHeaders();
+
+  // clang-format off
+  const static Http::CustomInlineHeaderRegistry::Handle<Http::CustomInlineHeaderRegistry::Type::RequestHeaders> targetApiRoot();
+  const static Http::CustomInlineHeaderRegistry::Handle<Http::CustomInlineHeaderRegistry::Type::RequestHeaders> callback();
+  const static Http::CustomInlineHeaderRegistry::Handle<Http::CustomInlineHeaderRegistry::Type::RequestHeaders> nfPeerInfo();
+  const static Http::CustomInlineHeaderRegistry::Handle<Http::CustomInlineHeaderRegistry::Type::RequestHeaders> routingBinding();
+
+  const static Http::CustomInlineHeaderRegistry::Handle<Http::CustomInlineHeaderRegistry::Type::ResponseHeaders> responseTargetApiRoot();
+  const static Http::CustomInlineHeaderRegistry::Handle<Http::CustomInlineHeaderRegistry::Type::ResponseHeaders> responseNfPeerInfo();
+  // clang-format on
+
+  // Return true if the header is one of the 3gpp-Sbi-Discovery-* headers
+  static bool isDiscoveryHeader(const Http::HeaderEntry& header);
+
+  // clang-format off
+  Http::RegisterCustomInlineHeader<Http::CustomInlineHeaderRegistry::Type::RequestHeaders> target_api_root_;
+  Http::RegisterCustomInlineHeader<Http::CustomInlineHeaderRegistry::Type::RequestHeaders> callback_;
+  Http::RegisterCustomInlineHeader<Http::CustomInlineHeaderRegistry::Type::RequestHeaders> nf_peer_info_;
+  Http::RegisterCustomInlineHeader<Http::CustomInlineHeaderRegistry::Type::RequestHeaders> routing_binding_;
+
+  Http::RegisterCustomInlineHeader<Http::CustomInlineHeaderRegistry::Type::ResponseHeaders> response_target_api_root_;
+  Http::RegisterCustomInlineHeader<Http::CustomInlineHeaderRegistry::Type::ResponseHeaders> response_nf_peer_info_;
+  // clang-format on
+};
+
+} // namespace EricProxy
+} // namespace HttpFilters
+} // namespace Extensions
+} // namespace Envoy
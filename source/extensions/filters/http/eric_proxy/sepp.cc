@@ -348,7 +348,7 @@ SeppReqPreProcResult EricProxyFilter::seppRequestPreProcessing() {
         // ULID(T01)  T-FQDN in :authority ? N
         ENVOY_STREAM_UL_LOG(debug, "from internal network, T-FQDN not present", *decoder_callbacks_,
                             ULID(T01));
-        auto tar_hdr = run_ctx_.getReqOrRespHeaders()->get(Http::LowerCaseString("3gpp-Sbi-target-apiRoot"));
+        auto tar_hdr = run_ctx_.getReqOrRespHeaders()->get(SbiHeaders::get().TargetApiRoot);
         // ULID(T02)  3gpp-Sbi-target-apiRoot header present ?
         ENVOY_STREAM_UL_LOG(trace, "Is 3gpp-Sbi-target-apiRoot header empty: {}",
                             *decoder_callbacks_, ULID(T02), tar_hdr.empty());
@@ -500,7 +500,7 @@ SeppReqPreProcResult EricProxyFilter::seppRequestPreProcessing() {
     //           value of :authority into TaR and set own FQDN + **external** port into :authority.
     //           External port because we are here in the path of request from roaming-partner.
     const auto& tar_hdr =
-        run_ctx_.getReqOrRespHeaders()->get(Http::LowerCaseString("3gpp-Sbi-target-apiRoot"));
+        run_ctx_.getReqOrRespHeaders()->get(SbiHeaders::get().TargetApiRoot);
     ENVOY_STREAM_UL_LOG(trace, "Is 3gpp-Sbi-Target-apiRoot header empty: {}", *decoder_callbacks_,
                         ULID(P01), tar_hdr.empty());
     if (tar_hdr.empty()) { // No, not present
@@ -640,7 +640,7 @@ Http::FilterHeadersStatus EricProxyFilter::seppOutRequestEdgeProcessing() {
     rp_name_topology_hiding_ = rp_config_->name();
 
     // ULID(H31) Check if request is NF Status Notify and TH IP hiding configured for NF Type
-    auto callback_hdr = run_ctx_.getReqOrRespHeaders()->get(Http::LowerCaseString("3gpp-Sbi-Callback"));
+    auto callback_hdr = run_ctx_.getReqOrRespHeaders()->get(SbiHeaders::get().Callback);
     if (callback_hdr.empty()) {
       ENVOY_STREAM_UL_LOG(trace, "3gpp-Sbi-Callback header is not present, not hiding any IP addresses", *decoder_callbacks_, ULID(H31a));
       return Http::FilterHeadersStatus::Continue;
@@ -114,7 +114,9 @@ EricProxyStats::EricProxyStats(EricProxyFilterConfigSharedPtr config, Stats::Sco
           stat_name_set_->add("ip_address_hiding_configuration_error")),
       th_pseudo_search_result_(stat_name_set_->add("th_pseudo_search_result_total")),
       notify_(stat_name_set_->add("nf_status_notify")),
-      nf_discovery_(stat_name_set_->add("nf_discovery")) {
+      nf_discovery_(stat_name_set_->add("nf_discovery")),
+      body_buffer_stats_(generateBodyBufferStats(scope)),
+      run_context_arena_stats_(generateRunContextArenaStats(scope)) {
   ENVOY_LOG(debug, "EricProxyStats instantiated");
   buildIngressRoamingPartnerCounters();
   rememberRoamingPartnersForTopologyHiding();
@@ -9,6 +9,8 @@
 #include "contexts.h"
 #include "envoy/stats/scope.h"
 
+#include "source/extensions/filters/http/eric_proxy/body_buffer_budget.h"
+#include "source/extensions/filters/http/eric_proxy/run_context_arena.h"
 #include "source/extensions/filters/http/eric_proxy/proxy_filter_config.h"
 #include "source/common/http/utility.h"
 #include "source/common/http/codes.h"
@@ -176,6 +178,9 @@ private:
   const Stats::StatName notify_;
   const Stats::StatName nf_discovery_;
 
+  BodyBufferStats body_buffer_stats_;
+  RunContextArenaStats run_context_arena_stats_;
+
   std::unordered_map<std::string, std::optional<Stats::Counter*>> ingress_rp_rq_total_;
   std::unordered_map<std::string, std::optional<Stats::Counter*>> ingress_rp_rq_1xx_;
   std::unordered_map<std::string, std::optional<Stats::Counter*>> ingress_rp_rq_2xx_;
@@ -211,6 +216,8 @@ public:
   const Stats::StatName& fqdnMissing() { return ip_address_hiding_fqdn_missing_; }
   const Stats::StatName& configurationError() { return ip_address_hiding_configuration_error_; }
   const Stats::StatName& thPseudoSearchResult() { return th_pseudo_search_result_; }
+  BodyBufferStats& bodyBufferStats() { return body_buffer_stats_; }
+  RunContextArenaStats& runContextArenaStats() { return run_context_arena_stats_; }
 
   // const Stats::StatName& rejectRouting() { return ctr_reject_message_routing_; }
   // const Stats::StatName& dropRouting() { return ctr_drop_message_routing_; }
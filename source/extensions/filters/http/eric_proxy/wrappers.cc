@@ -640,6 +640,37 @@ FilterCaseWrapper::filterdataForVarIndex(ValueIndex index) {
   }
 }
 
+void FilterCaseWrapper::addFilterRule(std::shared_ptr<FilterRuleWrapper> fr) {
+  // Index of the closest earlier filter-rule whose load plan has the value, if any
+  auto earlier_rule = [this](auto has_value) -> size_t {
+    for (size_t idx = load_plans_.size(); idx > 0; idx--) {
+      if (has_value(load_plans_[idx - 1])) {
+        return idx - 1;
+      }
+    }
+    return NoEarlierRule;
+  };
+
+  FilterRuleLoadPlan plan;
+  for (const auto& fd_weak : fr->filterdataRequired()) {
+    if (std::shared_ptr<FilterDataWrapper> fd = fd_weak.lock()) {
+      plan.filter_data.emplace_back(fd, earlier_rule([&fd](const FilterRuleLoadPlan& p) {
+        return std::any_of(p.filter_data.begin(), p.filter_data.end(),
+                           [&fd](const auto& entry) { return entry.first == fd; });
+      }));
+    }
+  }
+  for (const auto& hdr_idx : fr->headerValueIndicesRequired()) {
+    plan.header_value_indices.emplace_back(
+        hdr_idx, earlier_rule([hdr_idx](const FilterRuleLoadPlan& p) {
+          return std::any_of(p.header_value_indices.begin(), p.header_value_indices.end(),
+                             [hdr_idx](const auto& entry) { return entry.first == hdr_idx; });
+        }));
+  }
+  filter_rules_.push_back(fr);
+  load_plans_.push_back(std::move(plan));
+}
+
 // Given the name of a filter-rule, return the filter-rule-wrapper.
 StatusOr<std::shared_ptr<FilterRuleWrapper>>
 FilterCaseWrapper::filterRuleByName(std::string& fr_name) {
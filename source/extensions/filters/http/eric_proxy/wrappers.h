@@ -1,5 +1,6 @@
 #pragma once
 
+#include <limits>
 #include <memory>
 #include <string>
 
@@ -355,7 +356,22 @@ public:
 
   StatusOr<std::shared_ptr<FilterRuleWrapper>> filterRuleByName(std::string& fr_name);
 
-  void addFilterRule(std::shared_ptr<FilterRuleWrapper> fr) { filter_rules_.push_back(fr); };
+  // Config-time: Append the filter-rule and compute its load plan. The condition and the
+  // actions of the rule have to be inserted before.
+  void addFilterRule(std::shared_ptr<FilterRuleWrapper> fr);
+
+  // Marks a value that no earlier filter-rule of this filter-case requires
+  static constexpr size_t NoEarlierRule = std::numeric_limits<size_t>::max();
+
+  // The filter-data and header values a filter-rule requires, each with the index of the
+  // closest earlier filter-rule of this filter-case that requires it as well. If that
+  // earlier filter-rule has been loaded since the last action ran, the value is already
+  // loaded and doesn't have to be extracted again.
+  struct FilterRuleLoadPlan {
+    std::vector<std::pair<std::shared_ptr<FilterDataWrapper>, size_t>> filter_data;
+    std::vector<std::pair<ValueIndex, size_t>> header_value_indices;
+  };
+  const FilterRuleLoadPlan& loadPlan(size_t rule_idx) const { return load_plans_[rule_idx]; }
 
   // Debug: dump all filter rules with their required filterdata
   std::string rulesAndFilterdataAsString() {
@@ -373,6 +389,8 @@ private:
   // filter-data rules you have to execute to fill that variable 
   std::map<ValueIndex, std::vector<std::shared_ptr<FilterDataWrapper>>> var_filterdata_;
   std::vector<std::shared_ptr<FilterRuleWrapper>> filter_rules_;
+  // load_plans_[i] belongs to filter_rules_[i]
+  std::vector<FilterRuleLoadPlan> load_plans_;
 };
 
 //---------- Filter Phase Wrapper ----------------------------------------
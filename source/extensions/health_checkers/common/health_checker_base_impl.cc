@@ -1,13 +1,21 @@
 #include "source/extensions/health_checkers/common/health_checker_base_impl.h"
 
+#include <algorithm>
+
 #include "envoy/config/core/v3/address.pb.h"
 #include "envoy/config/core/v3/health_check.pb.h"
 #include "envoy/data/core/v3/health_check_event.pb.h"
 #include "envoy/stats/scope.h"
 
+#include "source/common/common/lock_guard.h"
+#include "source/common/common/macros.h"
+#include "source/common/common/thread.h"
 #include "source/common/network/utility.h"
+#include "source/common/protobuf/utility.h"
 #include "source/common/router/router.h"
 
+#include "absl/container/flat_hash_map.h"
+
 namespace Envoy {
 namespace Upstream {
 
@@ -42,7 +50,60 @@ HealthCheckerImplBase::HealthCheckerImplBase(const Cluster& cluster,
       member_update_cb_{cluster_.prioritySet().addMemberUpdateCb(
           [this](const HostVector& hosts_added, const HostVector& hosts_removed) -> void {
             onClusterMemberUpdate(hosts_added, hosts_removed);
-          })} {}
+          })},
+      shared_probes_(runtime.snapshot().getBoolean("health_check.shared_probes", false)),
+      config_hash_(MessageUtil::hash(config)) {}
+
+// An endpoint that is health checked by several health checkers with the same configuration,
+// typically because it is a member of several clusters. The first session in sessions_ sends the
+// probes, the results are applied to all sessions. When the probing session goes away the next
+// one takes over.
+struct HealthCheckerImplBase::SharedTarget {
+  explicit SharedTarget(std::string key) : key_(std::move(key)) {}
+  ~SharedTarget();
+
+  const std::string key_;
+  std::vector<ActiveHealthCheckSession*> sessions_;
+};
+
+// Health checkers run on the main thread, but there may be several servers in one process (e.g.
+// in tests). The targets are therefore keyed by dispatcher as well and the registry is locked.
+struct HealthCheckerImplBase::SharedTargetRegistry {
+  Thread::MutexBasicLockable mutex_;
+  absl::flat_hash_map<std::string, std::weak_ptr<SharedTarget>> targets_ ABSL_GUARDED_BY(mutex_);
+};
+
+HealthCheckerImplBase::SharedTarget::~SharedTarget() {
+  SharedTargetRegistry& registry = sharedTargetRegistry();
+  Thread::LockGuard lock(registry.mutex_);
+  auto it = registry.targets_.find(key_);
+  // The entry may already point to a new target for the same key.
+  if (it != registry.targets_.end() && it->second.expired()) {
+    registry.targets_.erase(it);
+  }
+}
+
+HealthCheckerImplBase::SharedTargetRegistry& HealthCheckerImplBase::sharedTargetRegistry() {
+  MUTABLE_CONSTRUCT_ON_FIRST_USE(SharedTargetRegistry);
+}
+
+HealthCheckerImplBase::SharedTargetSharedPtr
+HealthCheckerImplBase::sharedTarget(const Host& host) const {
+  // The configuration hash covers the check type, intervals, thresholds and the request, the
+  // hostname is part of the key because it is used as default host header by the HTTP checker.
+  std::string key = fmt::format("{}|{}|{}|{}", static_cast<const void*>(&dispatcher_),
+                                config_hash_, host.healthCheckAddress()->asString(),
+                                host.hostname());
+  SharedTargetRegistry& registry = sharedTargetRegistry();
+  Thread::LockGuard lock(registry.mutex_);
+  std::weak_ptr<SharedTarget>& entry = registry.targets_[key];
+  SharedTargetSharedPtr target = entry.lock();
+  if (target == nullptr) {
+    target = std::make_shared<SharedTarget>(std::move(key));
+    entry = target;
+  }
+  return target;
+}
 
 std::shared_ptr<const Network::TransportSocketOptionsImpl>
 HealthCheckerImplBase::initTransportSocketOptions(
@@ -257,11 +318,52 @@ HealthCheckerImplBase::ActiveHealthCheckSession::~ActiveHealthCheckSession() {
   ASSERT(interval_timer_ == nullptr && timeout_timer_ == nullptr);
 }
 
+void HealthCheckerImplBase::ActiveHealthCheckSession::start() {
+  if (parent_.shared_probes_) {
+    shared_target_ = parent_.sharedTarget(*host_);
+    shared_target_->sessions_.push_back(this);
+    if (shared_target_->sessions_.front() != this) {
+      // Another health checker already probes this target and fans its results out to us. Have
+      // it probe now: this session gets a first result without waiting for the probing
+      // session's interval, and the next interval is computed with this session's one.
+      ENVOY_LOG(debug, "health check of {} shared with another cluster",
+                host_->healthCheckAddress()->asString());
+      shared_target_->sessions_.front()->probeNow();
+      return;
+    }
+  }
+  onInitialInterval();
+}
+
+void HealthCheckerImplBase::ActiveHealthCheckSession::probeNow() {
+  // A probe in flight fans its result out to all sessions of the target when it completes.
+  if (!timeout_timer_->enabled()) {
+    interval_timer_->enableTimer(std::chrono::milliseconds(0));
+  }
+}
+
+void HealthCheckerImplBase::ActiveHealthCheckSession::leaveSharedTarget() {
+  auto& sessions = shared_target_->sessions_;
+  const bool was_probing = sessions.front() == this;
+  sessions.erase(std::remove(sessions.begin(), sessions.end(), this), sessions.end());
+  if (was_probing && !sessions.empty()) {
+    ActiveHealthCheckSession& next = *sessions.front();
+    next.interval_timer_->enableTimer(next.parent_.interval(
+        next.host_->healthFlagGet(Host::HealthFlag::FAILED_ACTIVE_HC) ? HealthState::Unhealthy
+                                                                        : HealthState::Healthy,
+        HealthTransition::Unchanged));
+  }
+  shared_target_.reset();
+}
+
 void HealthCheckerImplBase::ActiveHealthCheckSession::onDeferredDeleteBase() {
   // The session is about to be deferred deleted. Make sure all timers are gone and any
   // implementation specific state is destroyed.
   interval_timer_.reset();
   timeout_timer_.reset();
+  if (shared_target_ != nullptr) {
+    leaveSharedTarget();
+  }
   if (!host_->healthFlagGet(Host::HealthFlag::FAILED_ACTIVE_HC)) {
     parent_.decHealthy();
   }
@@ -277,6 +379,14 @@ void HealthCheckerImplBase::ActiveHealthCheckSession::onDeferredDeleteBase() {
 }
 
 void HealthCheckerImplBase::ActiveHealthCheckSession::handleSuccess(bool degraded) {
+  const HealthTransition changed_state = setHealthy(degraded);
+
+  timeout_timer_->disableTimer();
+  interval_timer_->enableTimer(nextInterval(HealthState::Healthy, changed_state));
+  fanOutResult(shared_target_, true, degraded, envoy::data::core::v3::ACTIVE, false);
+}
+
+HealthTransition HealthCheckerImplBase::ActiveHealthCheckSession::setHealthy(bool degraded) {
   // If we are healthy, reset the # of unhealthy to zero.
   num_unhealthy_ = 0;
 
@@ -332,9 +442,7 @@ void HealthCheckerImplBase::ActiveHealthCheckSession::handleSuccess(bool degrade
   parent_.stats_.success_.inc();
   first_check_ = false;
   parent_.runCallbacks(host_, changed_state);
-
-  timeout_timer_->disableTimer();
-  interval_timer_->enableTimer(parent_.interval(HealthState::Healthy, changed_state));
+  return changed_state;
 }
 
 namespace {
@@ -395,6 +503,9 @@ HealthTransition HealthCheckerImplBase::ActiveHealthCheckSession::setUnhealthy(
 
 void HealthCheckerImplBase::ActiveHealthCheckSession::handleFailure(
     envoy::data::core::v3::HealthCheckFailureType type, bool retriable) {
+  // The callbacks run by setUnhealthy() may remove the host and with it this session, which
+  // then leaves its shared target. The other sessions still get the result.
+  const SharedTargetSharedPtr target = shared_target_;
   HealthTransition changed_state = setUnhealthy(type, retriable);
   // It's possible that the previous call caused this session to be deferred deleted.
   if (timeout_timer_ != nullptr) {
@@ -402,8 +513,47 @@ void HealthCheckerImplBase::ActiveHealthCheckSession::handleFailure(
   }
 
   if (interval_timer_ != nullptr) {
-    interval_timer_->enableTimer(parent_.interval(HealthState::Unhealthy, changed_state));
+    interval_timer_->enableTimer(nextInterval(HealthState::Unhealthy, changed_state));
+  }
+  fanOutResult(target, false, false, type, retriable);
+}
+
+void HealthCheckerImplBase::ActiveHealthCheckSession::fanOutResult(
+    const SharedTargetSharedPtr& target, bool success, bool degraded,
+    envoy::data::core::v3::HealthCheckFailureType type, bool retriable) {
+  if (target == nullptr || target->sessions_.empty()) {
+    return;
+  }
+  // The host status callbacks of a subscriber may remove hosts and with them sessions of this
+  // target, so iterate over a copy and skip the sessions that have left in the meantime.
+  const std::vector<ActiveHealthCheckSession*> sessions = target->sessions_;
+  for (ActiveHealthCheckSession* session : sessions) {
+    if (session == this || std::find(target->sessions_.begin(), target->sessions_.end(),
+                                     session) == target->sessions_.end()) {
+      continue;
+    }
+    session->parent_.stats_.shared_result_.inc();
+    if (success) {
+      session->setHealthy(degraded);
+    } else {
+      session->setUnhealthy(type, retriable);
+    }
+  }
+}
+
+std::chrono::milliseconds
+HealthCheckerImplBase::ActiveHealthCheckSession::nextInterval(HealthState state,
+                                                              HealthTransition changed_state) const {
+  std::chrono::milliseconds next = parent_.interval(state, changed_state);
+  if (shared_target_ != nullptr) {
+    // Probe at the pace of the most demanding subscriber, e.g. one whose cluster has traffic.
+    for (const ActiveHealthCheckSession* session : shared_target_->sessions_) {
+      if (session != this) {
+        next = std::min(next, session->parent_.interval(state, changed_state));
+      }
+    }
   }
+  return next;
 }
 
 HealthTransition
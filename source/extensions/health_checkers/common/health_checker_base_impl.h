@@ -26,6 +26,7 @@ namespace Upstream {
   COUNTER(failure)                                                                                 \
   COUNTER(network_failure)                                                                         \
   COUNTER(passive_failure)                                                                         \
+  COUNTER(shared_result)                                                                           \
   COUNTER(success)                                                                                 \
   COUNTER(verify_cluster)                                                                          \
   GAUGE(degraded, Accumulate)                                                                      \
@@ -56,13 +57,16 @@ public:
   }
 
 protected:
+  struct SharedTarget;
+  using SharedTargetSharedPtr = std::shared_ptr<SharedTarget>;
+
   class ActiveHealthCheckSession : public Event::DeferredDeletable {
   public:
     ~ActiveHealthCheckSession() override;
     HealthTransition setUnhealthy(envoy::data::core::v3::HealthCheckFailureType type,
                                   bool retriable);
     void onDeferredDeleteBase();
-    void start() { onInitialInterval(); }
+    void start();
 
   protected:
     ActiveHealthCheckSession(HealthCheckerImplBase& parent, HostSharedPtr host);
@@ -77,6 +81,16 @@ protected:
     // been health checked.
     // Returns the changed state to use following the flag update.
     HealthTransition clearPendingFlag(HealthTransition changed_state);
+    HealthTransition setHealthy(bool degraded);
+    // Applies the result of a probe sent by this session to the other sessions of the shared
+    // target (this session may have left it while handling the result).
+    void fanOutResult(const SharedTargetSharedPtr& target, bool success, bool degraded,
+                      envoy::data::core::v3::HealthCheckFailureType type, bool retriable);
+    // Sends the next probe right away unless one is in flight.
+    void probeNow();
+    void leaveSharedTarget();
+    std::chrono::milliseconds nextInterval(HealthState state,
+                                           HealthTransition changed_state) const;
     virtual void onInterval() PURE;
     void onIntervalBase();
     virtual void onTimeout() PURE;
@@ -91,6 +105,9 @@ protected:
     uint32_t num_healthy_{};
     bool first_check_{true};
     TimeSource& time_source_;
+    // Set if health_check.shared_probes is enabled. Only the first session of the target sends
+    // probes, the other sessions receive its results.
+    SharedTargetSharedPtr shared_target_;
   };
 
   using ActiveHealthCheckSessionPtr = std::unique_ptr<ActiveHealthCheckSession>;
@@ -116,6 +133,8 @@ protected:
   HealthCheckEventLoggerPtr event_logger_;
 
 private:
+  struct SharedTargetRegistry;
+
   struct HealthCheckHostMonitorImpl : public HealthCheckHostMonitor {
     HealthCheckHostMonitorImpl(const std::shared_ptr<HealthCheckerImplBase>& health_checker,
                                const HostSharedPtr& host)
@@ -141,6 +160,8 @@ private:
   void runCallbacks(HostSharedPtr host, HealthTransition changed_state);
   void setUnhealthyCrossThread(const HostSharedPtr& host,
                                HealthCheckHostMonitor::UnhealthyType type);
+  SharedTargetSharedPtr sharedTarget(const Host& host) const;
+  static SharedTargetRegistry& sharedTargetRegistry();
   static std::shared_ptr<const Network::TransportSocketOptionsImpl>
   initTransportSocketOptions(const envoy::config::core::v3::HealthCheck& config);
   static MetadataConstSharedPtr
@@ -160,6 +181,10 @@ private:
   const std::shared_ptr<const Network::TransportSocketOptionsImpl> transport_socket_options_;
   const MetadataConstSharedPtr transport_socket_match_metadata_;
   const Common::CallbackHandlePtr member_update_cb_;
+  // Health checkers with the same configuration share the sessions for the same health check
+  // address, see SharedTarget.
+  const bool shared_probes_;
+  const std::size_t config_hash_;
 };
 
 } // namespace Upstream
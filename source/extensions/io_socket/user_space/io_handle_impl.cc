@@ -251,6 +251,16 @@ Api::IoCallUint64Result IoHandleImpl::recv(void* buffer, size_t length, int flag
   return {max_bytes_to_read, Api::IoError::none()};
 }
 
+Api::IoCallUint64Result IoHandleImpl::send(const Buffer::RawSlice* slices, uint64_t num_slice,
+                                           int) {
+  // The peer takes a copy of the data, so there are no send flags to honor.
+  return writev(slices, num_slice);
+}
+
+Api::IoCallUint64Result IoHandleImpl::recvZeroCopyCompletion(ZeroCopyCompletion&) {
+  return {0, Network::IoSocketError::create(SOCKET_ERROR_NOT_SUP)};
+}
+
 bool IoHandleImpl::supportsMmsg() const { return false; }
 
 bool IoHandleImpl::supportsUdpGro() const { return false; }
@@ -63,6 +63,9 @@ public:
   Api::IoCallUint64Result recvmmsg(RawSliceArrays& slices, uint32_t self_port,
                                    RecvMsgOutput& output) override;
   Api::IoCallUint64Result recv(void* buffer, size_t length, int flags) override;
+  Api::IoCallUint64Result send(const Buffer::RawSlice* slices, uint64_t num_slice,
+                               int flags) override;
+  Api::IoCallUint64Result recvZeroCopyCompletion(ZeroCopyCompletion& completion) override;
   bool supportsMmsg() const override;
   bool supportsUdpGro() const override;
   Api::SysCallIntResult bind(Network::Address::InstanceConstSharedPtr address) override;
@@ -6,23 +6,37 @@
 #include "envoy/extensions/transport_sockets/raw_buffer/v3/raw_buffer.pb.validate.h"
 
 #include "source/common/network/raw_buffer_socket.h"
+#include "source/common/protobuf/utility.h"
 
 namespace Envoy {
 namespace Extensions {
 namespace TransportSockets {
 namespace RawBuffer {
 
+namespace {
+
+uint32_t zeroCopySendThreshold(const Protobuf::Message& message,
+                               Server::Configuration::TransportSocketFactoryContext& context) {
+  const auto& config = MessageUtil::downcastAndValidate<
+      const envoy::extensions::transport_sockets::raw_buffer::v3::RawBuffer&>(
+      message, context.messageValidationVisitor());
+  return PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, zero_copy_send_threshold, 0);
+}
+
+} // namespace
+
 Network::UpstreamTransportSocketFactoryPtr
 UpstreamRawBufferSocketFactory::createTransportSocketFactory(
-    const Protobuf::Message&, Server::Configuration::TransportSocketFactoryContext&) {
-  return std::make_unique<Network::RawBufferSocketFactory>();
+    const Protobuf::Message& message,
+    Server::Configuration::TransportSocketFactoryContext& context) {
+  return std::make_unique<Network::RawBufferSocketFactory>(zeroCopySendThreshold(message, context));
 }
 
 Network::DownstreamTransportSocketFactoryPtr
 DownstreamRawBufferSocketFactory::createTransportSocketFactory(
-    const Protobuf::Message&, Server::Configuration::TransportSocketFactoryContext&,
+    const Protobuf::Message& message, Server::Configuration::TransportSocketFactoryContext& context,
     const std::vector<std::string>&) {
-  return std::make_unique<Network::RawBufferSocketFactory>();
+  return std::make_unique<Network::RawBufferSocketFactory>(zeroCopySendThreshold(message, context));
 }
 
 ProtobufTypes::MessagePtr RawBufferSocketFactory::createEmptyConfigProto() {
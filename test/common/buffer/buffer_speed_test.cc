@@ -123,6 +123,31 @@ static void bufferCreate(benchmark::State& state) {
 }
 BENCHMARK(bufferCreate)->Arg(1)->Arg(4096)->Arg(16384)->Arg(65536);
 
+// Allocate and free slices of varying sizes, which exercises the slice storage pool for slices of
+// the default size. state.range(1) slices are alive at the same time.
+static void bufferSliceAllocFree(benchmark::State& state) {
+  const uint64_t size = state.range(0);
+  std::vector<Buffer::Slice> slices;
+  slices.reserve(state.range(1));
+  uint64_t capacity = 0;
+  for (auto _ : state) {
+    UNREFERENCED_PARAMETER(_);
+    for (int64_t i = 0; i < state.range(1); ++i) {
+      slices.emplace_back(size, nullptr);
+      capacity += slices.back().reservableSize();
+    }
+    slices.clear();
+  }
+  benchmark::DoNotOptimize(capacity);
+}
+BENCHMARK(bufferSliceAllocFree)
+    ->Args({4096, 1})
+    ->Args({4096, 32})
+    ->Args({16384, 1})
+    ->Args({16384, 32})
+    ->Args({65536, 1})
+    ->Args({65536, 32});
+
 // Grow an OwnedImpl in very small amounts.
 static void bufferAddSmallIncrement(benchmark::State& state) {
   const std::string data("a");
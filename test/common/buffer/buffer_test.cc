@@ -291,6 +291,41 @@ TEST_F(OwnedSliceTest, Drain) {
   EXPECT_EQ(original_size, slice.reservableSize());
 }
 
+TEST_F(OwnedSliceTest, StorageReusedFromPool) {
+  SliceStoragePool* pool = SliceStoragePool::threadLocal();
+  ASSERT_NE(nullptr, pool);
+
+  const uint8_t* storage;
+  {
+    Slice slice{Slice::default_slice_size_, nullptr};
+    storage = slice.data();
+  }
+  const size_t pooled = pool->size();
+  EXPECT_LE(1, pooled);
+
+  // The storage of the destroyed slice is handed out to the next slice of the default size.
+  Slice slice{Slice::default_slice_size_ - 100, nullptr};
+  EXPECT_EQ(storage, slice.data());
+  EXPECT_EQ(pooled - 1, pool->size());
+
+  // Slices of other sizes do not use the pool.
+  { Slice large_slice{2 * Slice::default_slice_size_, nullptr}; }
+  EXPECT_EQ(pooled - 1, pool->size());
+}
+
+TEST(SliceStoragePoolTest, TrimToLowWatermark) {
+  SliceStoragePool pool;
+  for (uint32_t i = 0; i < SliceStoragePool::HighWatermark; ++i) {
+    pool.put(SliceStoragePool::StoragePtr{new uint8_t[SliceStoragePool::StorageSize]});
+  }
+  EXPECT_EQ(SliceStoragePool::HighWatermark, pool.size());
+  pool.put(pool.get());
+  EXPECT_EQ(SliceStoragePool::HighWatermark, pool.size());
+
+  pool.put(SliceStoragePool::StoragePtr{new uint8_t[SliceStoragePool::StorageSize]});
+  EXPECT_EQ(SliceStoragePool::LowWatermark, pool.size());
+}
+
 TEST(UnownedSliceTest, CreateDelete) {
   constexpr char input[] = "hello world";
   bool release_callback_called = false;
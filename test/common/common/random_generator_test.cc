@@ -56,6 +56,23 @@ TEST(UUID, CheckLengthOfUUID) {
   EXPECT_EQ(expected_length, result.length());
 }
 
+TEST(UUID, Format) {
+  Random::RandomGeneratorImpl random;
+
+  for (size_t i = 0; i < 1000; ++i) {
+    const std::string result = random.uuid();
+    for (size_t pos = 0; pos < result.length(); ++pos) {
+      if (pos == 8 || pos == 13 || pos == 18 || pos == 23) {
+        EXPECT_EQ('-', result[pos]);
+      } else {
+        EXPECT_NE(std::string::npos, std::string("0123456789abcdef").find(result[pos]));
+      }
+    }
+    EXPECT_EQ('4', result[14]);
+    EXPECT_NE(std::string::npos, std::string("89ab").find(result[19]));
+  }
+}
+
 TEST(UUID, SanityCheckOfUniqueness) {
   std::set<std::string> uuids;
   const size_t num_of_uuids = 100000;
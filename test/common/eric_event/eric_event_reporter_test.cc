@@ -0,0 +1,117 @@
+#include <chrono>
+
+#include "source/common/eric_event/eric_event.h"
+#include "source/common/eric_event/eric_event_reporter.h"
+
+#include "test/test_common/utility.h"
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace HttpFilters {
+namespace EricProxy {
+namespace {
+
+using EricEvent::EventType;
+
+MonotonicTime at(std::chrono::milliseconds ms) { return MonotonicTime(ms); }
+
+// At most the configured number of events per type and second are allowed,
+// the rest are counted as suppressed
+TEST(EventRateLimiterTest, LimitPerType) {
+  EventRateLimiter limiter(3);
+  const auto now = at(std::chrono::milliseconds(10500));
+  for (int i = 0; i < 3; i++) {
+    EXPECT_TRUE(limiter.allowEvent(EventType::HTTP_SYNTAX_ERROR, now));
+  }
+  EXPECT_FALSE(limiter.allowEvent(EventType::HTTP_SYNTAX_ERROR, now));
+  EXPECT_FALSE(limiter.allowEvent(EventType::HTTP_SYNTAX_ERROR, now));
+  EXPECT_EQ(2, limiter.suppressedEvents(EventType::HTTP_SYNTAX_ERROR));
+
+  // Other event types have their own limit
+  EXPECT_TRUE(limiter.allowEvent(EventType::BARRED_HTTP1, now));
+  EXPECT_EQ(0, limiter.suppressedEvents(EventType::BARRED_HTTP1));
+}
+
+// A new second starts a new window: the count and the suppressed events are reset
+TEST(EventRateLimiterTest, WindowReset) {
+  EventRateLimiter limiter(2);
+  constexpr auto type = EventType::HTTP_BODY_TOO_LONG;
+  EXPECT_TRUE(limiter.allowEvent(type, at(std::chrono::milliseconds(1000))));
+  EXPECT_TRUE(limiter.allowEvent(type, at(std::chrono::milliseconds(1200))));
+  EXPECT_FALSE(limiter.allowEvent(type, at(std::chrono::milliseconds(1999))));
+  EXPECT_EQ(1, limiter.suppressedEvents(type));
+
+  EXPECT_TRUE(limiter.allowEvent(type, at(std::chrono::milliseconds(2000))));
+  EXPECT_EQ(0, limiter.suppressedEvents(type));
+  EXPECT_TRUE(limiter.allowEvent(type, at(std::chrono::milliseconds(2500))));
+  EXPECT_FALSE(limiter.allowEvent(type, at(std::chrono::milliseconds(2600))));
+
+  // Skipping seconds also starts a new window
+  EXPECT_TRUE(limiter.allowEvent(type, at(std::chrono::seconds(60))));
+}
+
+// The first second of the monotonic clock is a valid window
+TEST(EventRateLimiterTest, FirstSecond) {
+  EventRateLimiter limiter(1);
+  EXPECT_TRUE(limiter.allowEvent(EventType::USER_DEFINED_EVENT, at(std::chrono::milliseconds(0))));
+  EXPECT_FALSE(limiter.allowEvent(EventType::USER_DEFINED_EVENT, at(std::chrono::milliseconds(1))));
+}
+
+TEST(EventRateLimiterTest, Unlimited) {
+  EventRateLimiter limiter(0);
+  for (int i = 0; i < 1000; i++) {
+    EXPECT_TRUE(limiter.allowEvent(EventType::HTTP_SYNTAX_ERROR, at(std::chrono::seconds(5))));
+  }
+  EXPECT_EQ(0, limiter.suppressedEvents(EventType::HTTP_SYNTAX_ERROR));
+}
+
+// Values of ERIC_EVENT_MAX_RATE_PER_TYPE
+TEST(EventRateLimiterTest, MaxRateFromEnvValue) {
+  EXPECT_EQ(0, EventRateLimiter::maxRateFromEnvValue(nullptr));
+  EXPECT_EQ(0, EventRateLimiter::maxRateFromEnvValue(""));
+  EXPECT_EQ(0, EventRateLimiter::maxRateFromEnvValue("0"));
+  EXPECT_EQ(0, EventRateLimiter::maxRateFromEnvValue("ten"));
+  EXPECT_EQ(0, EventRateLimiter::maxRateFromEnvValue("-5"));
+  EXPECT_EQ(0, EventRateLimiter::maxRateFromEnvValue("12x"));
+  EXPECT_EQ(0, EventRateLimiter::maxRateFromEnvValue("99999999999"));
+  EXPECT_EQ(100, EventRateLimiter::maxRateFromEnvValue("100"));
+  EXPECT_EQ(100, EventRateLimiter::maxRateFromEnvValue(" 100 "));
+}
+
+// Event fields are resolved by their tag in the access log format
+TEST(EricEventTest, FieldFromName) {
+  using Field = EricEvent::EventT::Field;
+  EXPECT_EQ(Field::TYPE, EricEvent::EventT::fieldFromName("TYPE"));
+  EXPECT_EQ(Field::RESP_CODE, EricEvent::EventT::fieldFromName("RESP_CODE"));
+  EXPECT_EQ(Field::SUB_SPEC, EricEvent::EventT::fieldFromName("SUB_SPEC"));
+  EXPECT_EQ(Field::UNKNOWN, EricEvent::EventT::fieldFromName("type"));
+  EXPECT_EQ(Field::UNKNOWN, EricEvent::EventT::fieldFromName("INDEX"));
+
+  const EricEvent::EventT event(EventType::HTTP_HEADER_TOO_LONG,
+                                EricEvent::EventCategory::SECURITY,
+                                EricEvent::EventSeverity::WARNING, "header too long",
+                                EricEvent::EventAction::REJECTED, "rp_A", "sepp.own.com", "SEPP",
+                                "ulid-1", absl::nullopt, "413", "too long");
+  EXPECT_EQ("ERIC_EVENT_SC_HTTP_HEADER_TOO_LONG", event.getEventField(Field::TYPE));
+  EXPECT_EQ("ERIC_EVENT_SC_HTTP_HEADER_TOO_LONG", event.getEventField("TYPE"));
+  EXPECT_EQ("warning", event.getEventField("SEVERITY"));
+  EXPECT_EQ("rejected", event.getEventField("ACTION"));
+  EXPECT_EQ("rp_A", event.getEventField(Field::RP));
+  EXPECT_EQ("413", event.getEventField("RESP_CODE"));
+  EXPECT_EQ("", event.getEventField("NO_SUCH_FIELD"));
+  EXPECT_THAT(event.getEventFieldValue(Field::MSG, 6),
+              ProtoEq(ValueUtil::stringValue("header")));
+  EXPECT_THAT(event.getEventFieldValue(Field::SUB_SPEC, absl::nullopt),
+              ProtoEq(ValueUtil::nullValue()));
+  EXPECT_THAT(event.getEventFieldValue(Field::UNKNOWN, absl::nullopt),
+              ProtoEq(ValueUtil::nullValue()));
+}
+
+} // namespace
+} // namespace EricProxy
+} // namespace HttpFilters
+} // namespace Extensions
+} // namespace Envoy
@@ -17,6 +17,7 @@
 #include "source/common/network/address_impl.h"
 #include "source/common/protobuf/utility.h"
 #include "source/common/router/string_accessor_impl.h"
+#include "source/common/stream_info/eric_event_state.h"
 #include "source/common/stream_info/stream_id_provider_impl.h"
 
 #include "test/common/formatter/command_extension.h"
@@ -2002,6 +2003,68 @@ TEST(SubstitutionFormatterTest, DynamicMetadataFieldExtractor) {
   }
 }
 
+// %EVENT(<field>)% is resolved by field name, %EVENT(INDEX)% is the position
+// of the current event in the list of events of the request
+TEST(SubstitutionFormatterTest, EventFormatter) {
+  StreamInfo::MockStreamInfo stream_info;
+  EXPECT_CALL(Const(stream_info), filterState()).Times(testing::AtLeast(1));
+
+  // No events
+  {
+    EventFormatter formatter("TYPE", absl::optional<size_t>());
+    EXPECT_EQ(absl::nullopt, formatter.format(stream_info));
+    EXPECT_THAT(formatter.formatValue(stream_info), ProtoEq(ValueUtil::nullValue()));
+  }
+
+  auto events = std::make_unique<StreamInfo::EricEventState>();
+  events->addEvent(EricEvent::EventT(
+      EricEvent::EventType::HTTP_HEADER_TOO_MANY, EricEvent::EventCategory::SECURITY,
+      EricEvent::EventSeverity::WARNING, "too many headers", EricEvent::EventAction::REJECTED,
+      "rp_A", "sepp.own.com", "SEPP", "ulid-1"));
+  events->addEvent(EricEvent::EventT(
+      EricEvent::EventType::BARRED_HTTP1, EricEvent::EventCategory::SECURITY,
+      EricEvent::EventSeverity::INFO, "http1", EricEvent::EventAction::DROPPED, "rp_B",
+      "sepp.own.com", "SEPP", "ulid-2"));
+  const auto* event_state = events.get();
+  stream_info.filter_state_->setData(StreamInfo::EricEventState::key(), std::move(events),
+                                     StreamInfo::FilterState::StateType::Mutable);
+
+  {
+    EventFormatter formatter("TYPE", absl::optional<size_t>());
+    EXPECT_EQ("ERIC_EVENT_SC_HTTP_HEADER_TOO_MANY", formatter.format(stream_info));
+    EXPECT_THAT(formatter.formatValue(stream_info),
+                ProtoEq(ValueUtil::stringValue("ERIC_EVENT_SC_HTTP_HEADER_TOO_MANY")));
+  }
+  {
+    EventFormatter formatter("MSG", absl::optional<size_t>(3));
+    EXPECT_EQ("too", formatter.format(stream_info));
+    EXPECT_THAT(formatter.formatValue(stream_info), ProtoEq(ValueUtil::stringValue("too")));
+  }
+  {
+    EventFormatter formatter("INDEX", absl::optional<size_t>());
+    EXPECT_EQ("0", formatter.format(stream_info));
+    EXPECT_THAT(formatter.formatValue(stream_info), ProtoEq(ValueUtil::numberValue(0)));
+  }
+  // Unknown fields are logged as empty
+  {
+    EventFormatter formatter("NO_SUCH_FIELD", absl::optional<size_t>());
+    EXPECT_EQ("", formatter.format(stream_info));
+    EXPECT_THAT(formatter.formatValue(stream_info), ProtoEq(ValueUtil::nullValue()));
+  }
+
+  // The access logger moves on to the next event
+  event_state->processNextEvent();
+  {
+    EventFormatter formatter("RP", absl::optional<size_t>());
+    EXPECT_EQ("rp_B", formatter.format(stream_info));
+  }
+  {
+    EventFormatter formatter("INDEX", absl::optional<size_t>());
+    EXPECT_EQ("1", formatter.format(stream_info));
+    EXPECT_THAT(formatter.formatValue(stream_info), ProtoEq(ValueUtil::numberValue(1)));
+  }
+}
+
 TEST(SubstitutionFormatterTest, FilterStateFormatter) {
   StreamInfo::MockStreamInfo stream_info;
 
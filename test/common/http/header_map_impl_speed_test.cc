@@ -1,6 +1,7 @@
 #include "source/common/http/header_map_impl.h"
 #include "source/common/http/headers.h"
 
+#include "absl/strings/str_cat.h"
 #include "benchmark/benchmark.h"
 
 namespace Envoy {
@@ -208,6 +209,31 @@ static void headerMapImplPopulate(benchmark::State& state) {
 }
 BENCHMARK(headerMapImplPopulate);
 
+/**
+ * Measure the speed of creating a RequestHeaderMapImpl and populating it with the pseudo headers
+ * and a varying number of other headers, the size of 5G SBI requests with 20 to 40 headers. Most
+ * of the time is spent allocating the storage of the headers.
+ */
+static void headerMapImplPopulateRequest(benchmark::State& state) {
+  std::vector<std::pair<LowerCaseString, std::string>> headers_to_add;
+  for (int64_t i = 0; i < state.range(0); i++) {
+    headers_to_add.emplace_back(LowerCaseString(absl::StrCat("3gpp-sbi-header-", i)),
+                                "urn:3gpp:api:nnrf-disc:v1");
+  }
+  for (auto _ : state) { // NOLINT
+    auto headers = Http::RequestHeaderMapImpl::create();
+    headers->setReferenceMethod(Headers::get().MethodValues.Post);
+    headers->setReferenceScheme(Headers::get().SchemeValues.Http);
+    headers->setReferenceHost("nrf.5gc.mnc012.mcc345.3gppnetwork.org");
+    headers->setReferencePath("/nnrf-disc/v1/nf-instances");
+    for (const auto& key_value : headers_to_add) {
+      headers->addReference(key_value.first, key_value.second);
+    }
+    benchmark::DoNotOptimize(headers->size());
+  }
+}
+BENCHMARK(headerMapImplPopulateRequest)->Arg(0)->Arg(10)->Arg(20)->Arg(40);
+
 /**
  * Measure the speed of encoding headers as part of upgraded requests (HTTP/1 to HTTP/2)
  * @note The measured time for each iteration includes the time needed to add
@@ -11,6 +11,8 @@
 #include "test/test_common/test_runtime.h"
 #include "test/test_common/utility.h"
 
+#include "absl/strings/match.h"
+#include "absl/strings/str_cat.h"
 #include "gtest/gtest.h"
 
 using ::testing::ElementsAre;
@@ -990,6 +992,80 @@ TEST(HeaderMapImplTest, ClearHeaderMap) {
   EXPECT_TRUE(headers.empty());
 }
 
+// The entries keep their address while headers are added and removed, the nodes of removed
+// headers are reused for new ones.
+TEST(HeaderMapImplTest, EntriesStableAcrossNodeReuse) {
+  TestRequestHeaderMapImpl headers;
+  headers.setPath("/");
+  const HeaderEntry* path = headers.Path();
+  for (int round = 0; round < 3; round++) {
+    for (int i = 0; i < 100; i++) {
+      headers.addCopy(LowerCaseString(absl::StrCat("x-header-", i)), absl::StrCat(i));
+    }
+    EXPECT_EQ(101UL, headers.size());
+    EXPECT_EQ(path, headers.Path());
+    EXPECT_EQ("99", headers.get_("x-header-99"));
+    headers.remove(LowerCaseString("x-header-0"));
+    headers.removeIf([](const HeaderEntry& entry) {
+      return absl::StartsWith(entry.key().getStringView(), "x-header-");
+    });
+    EXPECT_EQ(1UL, headers.size());
+  }
+  headers.setMethod("GET");
+  headers.addCopy(LowerCaseString("x-last"), "last");
+  std::vector<absl::string_view> keys;
+  headers.iterate([&keys](const HeaderEntry& header) -> HeaderMap::Iterate {
+    keys.push_back(header.key().getStringView());
+    return HeaderMap::Iterate::Continue;
+  });
+  EXPECT_THAT(keys, ElementsAre(":path", ":method", "x-last"));
+  EXPECT_EQ(path, headers.Path());
+}
+
+TEST(HeaderMapImplTest, ApplyMutations) {
+  TestRequestHeaderMapImpl headers{{":path", "/"},
+                                   {"x-single", "a"},
+                                   {"x-multi", "b"},
+                                   {"x-multi", "c"},
+                                   {"x-remove", "d"},
+                                   {"x-last", "e"}};
+  const HeaderEntry* single = headers.get(LowerCaseString("x-single"))[0];
+  const LowerCaseString x_single("x-single");
+  const LowerCaseString x_multi("x-multi");
+  const LowerCaseString x_remove("x-remove");
+  const LowerCaseString x_new("x-new");
+  const LowerCaseString x_last("x-last");
+  const LowerCaseString& host = Headers::get().Host;
+  headers.applyMutations({{HeaderMutation::Type::Set, x_single, "single"},
+                          {HeaderMutation::Type::Set, x_multi, "multi-1"},
+                          {HeaderMutation::Type::Add, x_multi, "multi-2"},
+                          {HeaderMutation::Type::Remove, x_remove},
+                          {HeaderMutation::Type::Append, x_last, "f"},
+                          {HeaderMutation::Type::Add, x_new, "new", true},
+                          {HeaderMutation::Type::Set, host, "example.com"}});
+
+  // A header which exists once keeps its entry and position, others move to the end.
+  EXPECT_EQ(single, headers.get(x_single)[0]);
+  EXPECT_EQ("example.com", headers.getHostValue());
+  EXPECT_EQ((TestRequestHeaderMapImpl{{":path", "/"},
+                                      {":authority", "example.com"},
+                                      {"x-single", "single"},
+                                      {"x-last", "e,f"},
+                                      {"x-multi", "multi-1"},
+                                      {"x-multi", "multi-2"},
+                                      {"x-new", "new"}}),
+            headers);
+  EXPECT_TRUE(headers.get(x_new)[0]->key().isReference());
+
+  // Setting an inline header which exists replaces its value.
+  headers.applyMutations({{HeaderMutation::Type::Set, host, "example.org"},
+                          {HeaderMutation::Type::Remove, x_multi},
+                          {HeaderMutation::Type::Remove, x_multi}});
+  EXPECT_EQ("example.org", headers.getHostValue());
+  EXPECT_TRUE(headers.get(x_multi).empty());
+  EXPECT_EQ(5UL, headers.size());
+}
+
 // Validates byte size is properly accounted for in different inline header setting scenarios.
 TEST(HeaderMapImplTest, InlineHeaderByteSize) {
   {
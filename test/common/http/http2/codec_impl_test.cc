@@ -620,6 +620,100 @@ TEST_P(Http2CodecImplTest, ShutdownNotice) {
   driveToCompletion();
 }
 
+// With write coalescing the frames of all streams encoding in a dispatcher iteration are written to
+// the connection together at the end of it.
+TEST_P(Http2CodecImplTest, CoalescedWrites) {
+  scoped_runtime_.mergeValues({{"envoy.reloadable_features.http2_coalesce_writes", "true"}});
+  auto* send_pending_frames_callback =
+      new NiceMock<Event::MockSchedulableCallback>(&client_connection_.dispatcher_);
+  new NiceMock<Event::MockSchedulableCallback>(&server_connection_.dispatcher_);
+  initialize();
+
+  const uint64_t writes = client_stats_store_.counter("http2.coalesced_writes").value();
+  const uint64_t frames = client_stats_store_.counter("http2.coalesced_frames").value();
+  TestRequestHeaderMapImpl request_headers;
+  HttpTestUtility::addDefaultHeaders(request_headers);
+  MockResponseDecoder response_decoder2;
+  RequestEncoder* request_encoder2 = &client_->newStream(response_decoder2);
+  EXPECT_TRUE(request_encoder_->encodeHeaders(request_headers, true).ok());
+  EXPECT_TRUE(request_encoder2->encodeHeaders(request_headers, true).ok());
+  EXPECT_TRUE(send_pending_frames_callback->enabled_);
+  EXPECT_EQ(0, server_wrapper_->buffer_.length());
+
+  send_pending_frames_callback->invokeCallback();
+  EXPECT_EQ(writes + 1, client_stats_store_.counter("http2.coalesced_writes").value());
+  EXPECT_LT(frames, client_stats_store_.counter("http2.coalesced_frames").value());
+
+  EXPECT_CALL(request_decoder_, decodeHeaders_(_, true)).Times(2);
+  driveToCompletion();
+}
+
+// With write coalescing the flush timer of a stream that ends with a body is only armed if the body
+// is still pending after the deferred send.
+TEST_P(Http2CodecImplTest, CoalescedWritesDataEndStream) {
+  scoped_runtime_.mergeValues({{"envoy.reloadable_features.http2_coalesce_writes", "true"}});
+  auto* client_send_pending_frames_callback =
+      new NiceMock<Event::MockSchedulableCallback>(&client_connection_.dispatcher_);
+  auto* server_send_pending_frames_callback =
+      new NiceMock<Event::MockSchedulableCallback>(&server_connection_.dispatcher_);
+  initialize();
+
+  TestRequestHeaderMapImpl request_headers;
+  HttpTestUtility::addDefaultHeaders(request_headers);
+  EXPECT_CALL(request_decoder_, decodeHeaders_(_, true));
+  EXPECT_TRUE(request_encoder_->encodeHeaders(request_headers, true).ok());
+  client_send_pending_frames_callback->invokeCallback();
+  driveToCompletion();
+
+  TestResponseHeaderMapImpl response_headers{{":status", "200"}};
+  response_encoder_->encodeHeaders(response_headers, false);
+  // The body fits into the window, so no flush timer is needed once it is sent.
+  EXPECT_CALL(server_connection_.dispatcher_, createTimer_(_)).Times(0);
+  Buffer::OwnedImpl body("hello");
+  response_encoder_->encodeData(body, true);
+  EXPECT_TRUE(server_send_pending_frames_callback->enabled_);
+  server_send_pending_frames_callback->invokeCallback();
+
+  EXPECT_CALL(response_decoder_, decodeHeaders_(_, false));
+  EXPECT_CALL(response_decoder_, decodeData(_, true));
+  driveToCompletion();
+  EXPECT_EQ(0, server_stats_store_.counter("http2.tx_flush_timeout").value());
+}
+
+// With write coalescing a body that only waits for the deferred send is sent before the trailers,
+// so that the trailers do not have to be saved until the body is sent.
+TEST_P(Http2CodecImplTest, CoalescedWritesTrailers) {
+  scoped_runtime_.mergeValues({{"envoy.reloadable_features.http2_coalesce_writes", "true"}});
+  auto* client_send_pending_frames_callback =
+      new NiceMock<Event::MockSchedulableCallback>(&client_connection_.dispatcher_);
+  auto* server_send_pending_frames_callback =
+      new NiceMock<Event::MockSchedulableCallback>(&server_connection_.dispatcher_);
+  initialize();
+
+  TestRequestHeaderMapImpl request_headers;
+  HttpTestUtility::addDefaultHeaders(request_headers);
+  EXPECT_CALL(request_decoder_, decodeHeaders_(_, true));
+  EXPECT_TRUE(request_encoder_->encodeHeaders(request_headers, true).ok());
+  client_send_pending_frames_callback->invokeCallback();
+  driveToCompletion();
+
+  TestResponseHeaderMapImpl response_headers{{":status", "200"}};
+  response_encoder_->encodeHeaders(response_headers, false);
+  Buffer::OwnedImpl body("hello");
+  response_encoder_->encodeData(body, false);
+  EXPECT_EQ(0, client_wrapper_->buffer_.length());
+  // Saved trailers would arm the flush timer.
+  EXPECT_CALL(server_connection_.dispatcher_, createTimer_(_)).Times(0);
+  response_encoder_->encodeTrailers(TestResponseTrailerMapImpl{{"trailing", "header"}});
+  EXPECT_NE(0, client_wrapper_->buffer_.length());
+  server_send_pending_frames_callback->invokeCallback();
+
+  EXPECT_CALL(response_decoder_, decodeHeaders_(_, false));
+  EXPECT_CALL(response_decoder_, decodeData(_, false));
+  EXPECT_CALL(response_decoder_, decodeTrailers_(_));
+  driveToCompletion();
+}
+
 TEST_P(Http2CodecImplTest, ProtocolErrorForTest) {
   initialize();
   EXPECT_EQ(absl::nullopt, request_encoder_->http1StreamEncoderOptions());
@@ -0,0 +1,41 @@
+// Note: this should be run with --compilation_mode=opt, and would benefit from a
+// quiescent system with disabled cstate power management.
+
+#include <string>
+
+#include "source/common/common/macros.h"
+#include "source/common/common/random_generator.h"
+#include "source/common/http/header_map_impl.h"
+#include "source/extensions/request_id/uuid/config.h"
+
+#include "benchmark/benchmark.h"
+
+// Generation of the UUID used as x-request-id.
+// NOLINTNEXTLINE(readability-identifier-naming)
+static void BM_RandomUuid(benchmark::State& state) {
+  Envoy::Random::RandomGeneratorImpl random;
+
+  for (auto _ : state) {
+    UNREFERENCED_PARAMETER(_);
+    std::string uuid = random.uuid();
+    benchmark::DoNotOptimize(uuid);
+  }
+}
+BENCHMARK(BM_RandomUuid);
+
+// Setting the x-request-id of a request as the connection manager does for every request
+// that does not have one (or must not keep its own).
+// NOLINTNEXTLINE(readability-identifier-naming)
+static void BM_UuidRequestIdSet(benchmark::State& state) {
+  Envoy::Random::RandomGeneratorImpl random;
+  Envoy::Extensions::RequestId::UUIDRequestIDExtension extension(
+      envoy::extensions::request_id::uuid::v3::UuidRequestIdConfig(), random);
+  auto headers = Envoy::Http::RequestHeaderMapImpl::create();
+
+  for (auto _ : state) {
+    UNREFERENCED_PARAMETER(_);
+    extension.set(*headers, true);
+    benchmark::DoNotOptimize(headers->getRequestIdValue());
+  }
+}
+BENCHMARK(BM_UuidRequestIdSet);
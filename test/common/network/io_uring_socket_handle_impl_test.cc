@@ -0,0 +1,212 @@
+#include "source/common/buffer/buffer_impl.h"
+#include "source/common/network/io_uring_socket_handle_impl.h"
+
+#include "test/mocks/api/mocks.h"
+#include "test/mocks/event/mocks.h"
+#include "test/mocks/io/mocks.h"
+#include "test/test_common/threadsafe_singleton_injector.h"
+#include "test/test_common/utility.h"
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+using testing::_;
+using testing::DoAll;
+using testing::Return;
+using testing::ReturnRef;
+using testing::SaveArg;
+
+namespace Envoy {
+namespace Network {
+namespace {
+
+class IoUringSocketHandleImplTest : public testing::Test {
+public:
+  IoUringSocketHandleImplTest() {
+    ON_CALL(factory_, getIoUringWorker()).WillByDefault(Return(OptRef<Io::IoUringWorker>(worker_)));
+    ON_CALL(worker_, dispatcher()).WillByDefault(ReturnRef(dispatcher_));
+    ON_CALL(socket_, getIoUringWorker()).WillByDefault(ReturnRef(worker_));
+    ON_CALL(socket_, getReadParam()).WillByDefault(ReturnRef(read_param_));
+    ON_CALL(socket_, getWriteParam()).WillByDefault(ReturnRef(write_param_));
+  }
+
+  testing::NiceMock<Io::MockIoUringWorkerFactory> factory_;
+  testing::NiceMock<Io::MockIoUringWorker> worker_;
+  testing::NiceMock<Io::MockIoUringSocket> socket_;
+  testing::NiceMock<Event::MockDispatcher> dispatcher_;
+  OptRef<Io::ReadParam> read_param_;
+  OptRef<Io::WriteParam> write_param_;
+  Event::FileReadyCb io_uring_cb_;
+};
+
+TEST_F(IoUringSocketHandleImplTest, AcceptedSocket) {
+  IoUringSocketHandleImpl handle(factory_, 10, false, absl::nullopt, true);
+
+  uint32_t delivered_events = 0;
+  EXPECT_CALL(worker_, addServerSocket(10, _, false))
+      .WillOnce(DoAll(SaveArg<1>(&io_uring_cb_), ReturnRef(socket_)));
+  EXPECT_CALL(socket_, enableRead());
+  EXPECT_CALL(socket_, enableCloseEvent(false));
+  handle.initializeFileEvent(
+      dispatcher_, [&delivered_events](uint32_t events) { delivered_events = events; },
+      Event::FileTriggerType::Edge, Event::FileReadyType::Read | Event::FileReadyType::Write);
+
+  // Reads move the data of the read event, the next read returns EAGAIN.
+  Buffer::OwnedImpl read_data("hello world");
+  Io::ReadParam read_param{read_data, static_cast<int32_t>(read_data.length())};
+  read_param_ = read_param;
+  Buffer::OwnedImpl buffer;
+  io_uring_cb_(Event::FileReadyType::Read);
+  EXPECT_EQ(Event::FileReadyType::Read, delivered_events);
+  Api::IoCallUint64Result result = handle.read(buffer, 5);
+  EXPECT_EQ(5, result.return_value_);
+  result = handle.read(buffer, absl::nullopt);
+  EXPECT_EQ(6, result.return_value_);
+  EXPECT_EQ("hello world", buffer.toString());
+  result = handle.read(buffer, absl::nullopt);
+  EXPECT_EQ(Api::IoError::IoErrorCode::Again, result.err_->getErrorCode());
+
+  // Remote close.
+  Io::ReadParam close_param{read_data, 0};
+  read_param_ = close_param;
+  result = handle.read(buffer, absl::nullopt);
+  EXPECT_TRUE(result.ok());
+  EXPECT_EQ(0, result.return_value_);
+  read_param_.reset();
+
+  // Writes are handed to the io_uring socket in full.
+  Buffer::OwnedImpl write_data("response");
+  EXPECT_CALL(socket_, write(testing::Matcher<Buffer::Instance&>(_)))
+      .WillOnce([](Buffer::Instance& data) { data.drain(data.length()); });
+  result = handle.write(write_data);
+  EXPECT_EQ(8, result.return_value_);
+  EXPECT_EQ(0, write_data.length());
+
+  EXPECT_CALL(socket_, disableRead());
+  EXPECT_CALL(socket_, enableCloseEvent(true));
+  handle.enableFileEvents(Event::FileReadyType::Closed);
+
+  EXPECT_CALL(socket_, injectCompletion(Io::Request::RequestType::Write));
+  handle.activateFileEvents(Event::FileReadyType::Write);
+
+  EXPECT_CALL(socket_, close(false, _));
+  handle.close();
+  EXPECT_FALSE(handle.isOpen());
+}
+
+TEST_F(IoUringSocketHandleImplTest, ClientSocket) {
+  IoUringSocketHandleImpl handle(factory_, 10);
+
+  EXPECT_CALL(worker_, addClientSocket(10, _, false))
+      .WillOnce(DoAll(SaveArg<1>(&io_uring_cb_), ReturnRef(socket_)));
+  // The file events are only applied once the connect is done.
+  EXPECT_CALL(socket_, enableRead()).Times(0);
+  uint32_t delivered_events = 0;
+  handle.initializeFileEvent(
+      dispatcher_, [&delivered_events](uint32_t events) { delivered_events = events; },
+      Event::FileTriggerType::Edge, Event::FileReadyType::Read | Event::FileReadyType::Write);
+  handle.enableFileEvents(Event::FileReadyType::Write);
+
+  auto address = std::make_shared<Address::Ipv4Instance>("127.0.0.1", 80);
+  EXPECT_CALL(socket_, connect(_));
+  Api::SysCallIntResult connect_result = handle.connect(address);
+  EXPECT_EQ(-1, connect_result.return_value_);
+  EXPECT_EQ(SOCKET_ERROR_IN_PROGRESS, connect_result.errno_);
+
+  // The connect result is reported through SO_ERROR while the write event is delivered.
+  Io::WriteParam write_param{-ECONNREFUSED};
+  write_param_ = write_param;
+  EXPECT_CALL(socket_, disableRead()).Times(0);
+  io_uring_cb_(Event::FileReadyType::Write);
+  EXPECT_EQ(Event::FileReadyType::Write, delivered_events);
+  int error = 0;
+  socklen_t error_size = sizeof(error);
+  EXPECT_EQ(0, handle.getOption(SOL_SOCKET, SO_ERROR, &error, &error_size).return_value_);
+  EXPECT_EQ(ECONNREFUSED, error);
+  write_param_.reset();
+
+  EXPECT_CALL(socket_, close(false, _));
+}
+
+TEST_F(IoUringSocketHandleImplTest, ConnectedClientSocketAppliesFileEvents) {
+  IoUringSocketHandleImpl handle(factory_, 10);
+
+  EXPECT_CALL(worker_, addClientSocket(10, _, false))
+      .WillOnce(DoAll(SaveArg<1>(&io_uring_cb_), ReturnRef(socket_)));
+  handle.initializeFileEvent(
+      dispatcher_, [](uint32_t) {}, Event::FileTriggerType::Edge,
+      Event::FileReadyType::Read | Event::FileReadyType::Write);
+  handle.enableFileEvents(Event::FileReadyType::Write | Event::FileReadyType::Closed);
+  handle.connect(std::make_shared<Address::Ipv4Instance>("127.0.0.1", 80));
+
+  Io::WriteParam write_param{0};
+  write_param_ = write_param;
+  EXPECT_CALL(socket_, disableRead());
+  EXPECT_CALL(socket_, enableCloseEvent(true));
+  io_uring_cb_(Event::FileReadyType::Write);
+  write_param_.reset();
+
+  EXPECT_CALL(socket_, close(false, _));
+}
+
+#ifdef SO_ZEROCOPY
+// Zero copy sends would bypass the write buffer of the io_uring socket.
+TEST_F(IoUringSocketHandleImplTest, ZeroCopyRefused) {
+  IoUringSocketHandleImpl handle(factory_, 10, false, absl::nullopt, true);
+
+  EXPECT_CALL(worker_, addServerSocket(10, _, false)).WillOnce(ReturnRef(socket_));
+  handle.initializeFileEvent(
+      dispatcher_, [](uint32_t) {}, Event::FileTriggerType::Edge, Event::FileReadyType::Read);
+  const int enable = 1;
+  Api::SysCallIntResult result = handle.setOption(SOL_SOCKET, SO_ZEROCOPY, &enable, sizeof(enable));
+  EXPECT_EQ(-1, result.return_value_);
+  EXPECT_EQ(SOCKET_ERROR_NOT_SUP, result.errno_);
+
+  EXPECT_CALL(socket_, close(false, _));
+}
+#endif
+
+// Without an io_uring worker on the thread the handle behaves like an IoSocketHandleImpl.
+TEST_F(IoUringSocketHandleImplTest, NoWorker) {
+  Api::MockOsSysCalls os_sys_calls;
+  TestThreadsafeSingletonInjector<Api::OsSysCallsImpl> os_calls(&os_sys_calls);
+  IoUringSocketHandleImpl handle(factory_, 10);
+
+  EXPECT_CALL(factory_, getIoUringWorker()).WillOnce(Return(OptRef<Io::IoUringWorker>()));
+  EXPECT_CALL(worker_, addClientSocket(_, _, _)).Times(0);
+  EXPECT_CALL(dispatcher_, createFileEvent_(10, _, _, _));
+  handle.initializeFileEvent(
+      dispatcher_, [](uint32_t) {}, Event::FileTriggerType::Edge, Event::FileReadyType::Read);
+
+  EXPECT_CALL(os_sys_calls, close(10)).WillOnce(Return(Api::SysCallIntResult{0, 0}));
+  handle.close();
+}
+
+// Listening sockets accept through readiness events, the accepted sockets use io_uring.
+TEST_F(IoUringSocketHandleImplTest, ListenerSocket) {
+  Api::MockOsSysCalls os_sys_calls;
+  TestThreadsafeSingletonInjector<Api::OsSysCallsImpl> os_calls(&os_sys_calls);
+  IoUringSocketHandleImpl handle(factory_, 10);
+
+  EXPECT_CALL(os_sys_calls, listen(10, 128)).WillOnce(Return(Api::SysCallIntResult{0, 0}));
+  handle.listen(128);
+  EXPECT_CALL(worker_, addClientSocket(_, _, _)).Times(0);
+  EXPECT_CALL(dispatcher_, createFileEvent_(10, _, _, _));
+  handle.initializeFileEvent(
+      dispatcher_, [](uint32_t) {}, Event::FileTriggerType::Edge, Event::FileReadyType::Read);
+
+  EXPECT_CALL(os_sys_calls, accept(10, _, _)).WillOnce(Return(Api::SysCallSocketResult{11, 0}));
+  IoHandlePtr accepted = handle.accept(nullptr, nullptr);
+  EXPECT_CALL(worker_, addServerSocket(11, _, false)).WillOnce(ReturnRef(socket_));
+  accepted->initializeFileEvent(
+      dispatcher_, [](uint32_t) {}, Event::FileTriggerType::Edge, Event::FileReadyType::Read);
+  EXPECT_CALL(socket_, close(false, _));
+  accepted->close();
+
+  EXPECT_CALL(os_sys_calls, close(10)).WillOnce(Return(Api::SysCallIntResult{0, 0}));
+  handle.close();
+}
+
+} // namespace
+} // namespace Network
+} // namespace Envoy
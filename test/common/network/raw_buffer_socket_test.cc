@@ -1,10 +1,23 @@
+#include "source/common/buffer/buffer_impl.h"
+#include "source/common/network/io_socket_handle_impl.h"
 #include "source/common/network/raw_buffer_socket.h"
 #include "source/common/network/transport_socket_options_impl.h"
 
+#include "test/mocks/api/mocks.h"
+#include "test/mocks/network/mocks.h"
 #include "test/test_common/network_utility.h"
+#include "test/test_common/threadsafe_singleton_injector.h"
 
 #include "gtest/gtest.h"
 
+#ifdef __linux__
+#include <linux/errqueue.h>
+#endif
+
+using testing::_;
+using testing::Return;
+using testing::ReturnRef;
+
 namespace Envoy {
 namespace Network {
 
@@ -19,5 +32,155 @@ TEST(RawBufferSocketFactory, RawBufferSocketFactory) {
   EXPECT_GT(keys.size(), 0);
 }
 
+#if defined(__linux__) && defined(MSG_ZEROCOPY) && defined(SO_ZEROCOPY) &&                        \
+    defined(SO_EE_ORIGIN_ZEROCOPY)
+class RawBufferSocketZeroCopyTest : public testing::Test {
+public:
+  RawBufferSocketZeroCopyTest() : socket_(4096) {
+    ON_CALL(callbacks_, ioHandle()).WillByDefault(ReturnRef(io_handle_));
+    socket_.setTransportSocketCallbacks(callbacks_);
+  }
+
+  ~RawBufferSocketZeroCopyTest() override {
+    EXPECT_CALL(os_sys_calls_, close(10)).WillOnce(Return(Api::SysCallIntResult{0, 0}));
+    io_handle_.close();
+  }
+
+  // Complete the zero copy sends with ids [first, last].
+  static Api::SysCallSizeResult completeZeroCopySends(msghdr* message, uint32_t first,
+                                                      uint32_t last, uint8_t code = 0) {
+    cmsghdr* cmsg = CMSG_FIRSTHDR(message);
+    cmsg->cmsg_level = SOL_IP;
+    cmsg->cmsg_type = IP_RECVERR;
+    cmsg->cmsg_len = CMSG_LEN(sizeof(sock_extended_err));
+    sock_extended_err error{};
+    error.ee_origin = SO_EE_ORIGIN_ZEROCOPY;
+    error.ee_code = code;
+    error.ee_info = first;
+    error.ee_data = last;
+    memcpy(CMSG_DATA(cmsg), &error, sizeof(error));
+    message->msg_controllen = CMSG_SPACE(sizeof(sock_extended_err));
+    return {0, 0};
+  }
+
+  testing::NiceMock<Api::MockOsSysCalls> os_sys_calls_;
+  TestThreadsafeSingletonInjector<Api::OsSysCallsImpl> os_calls_{&os_sys_calls_};
+  IoSocketHandleImpl io_handle_{10};
+  testing::NiceMock<MockTransportSocketCallbacks> callbacks_;
+  RawBufferSocket socket_;
+};
+
+// Sent bytes stay in the write buffer until the kernel reports that the zero copy send completed.
+TEST_F(RawBufferSocketZeroCopyTest, BytesReleasedOnCompletion) {
+  Buffer::OwnedImpl buffer(std::string(8192, 'a'));
+
+  EXPECT_CALL(os_sys_calls_, setsockopt_(10, SOL_SOCKET, SO_ZEROCOPY, _, _)).WillOnce(Return(0));
+  EXPECT_CALL(os_sys_calls_, sendmsg(10, _, MSG_ZEROCOPY))
+      .WillOnce(Return(Api::SysCallSizeResult{8192, 0}));
+  IoResult result = socket_.doWrite(buffer, false);
+  EXPECT_EQ(8192, result.bytes_processed_);
+  EXPECT_EQ(8192, buffer.length());
+
+  // Bytes added behind the in flight ones are sent after them, without zero copy as there are too
+  // few of them.
+  buffer.add("hello");
+  EXPECT_CALL(os_sys_calls_, recvmsg(10, _, MSG_ERRQUEUE))
+      .WillOnce(Return(Api::SysCallSizeResult{-1, EAGAIN}));
+  EXPECT_CALL(os_sys_calls_, sendmsg(10, _, 0))
+      .WillOnce([](os_fd_t, const msghdr* message, int) -> Api::SysCallSizeResult {
+        EXPECT_EQ(1U, message->msg_iovlen);
+        EXPECT_EQ("hello", absl::string_view(static_cast<char*>(message->msg_iov[0].iov_base),
+                                             message->msg_iov[0].iov_len));
+        return {5, 0};
+      });
+  result = socket_.doWrite(buffer, false);
+  EXPECT_EQ(5, result.bytes_processed_);
+  EXPECT_EQ(8197, buffer.length());
+
+  // The copied send is released together with the zero copy send before it.
+  EXPECT_CALL(os_sys_calls_, recvmsg(10, _, MSG_ERRQUEUE))
+      .WillOnce([](os_fd_t, msghdr* message, int) { return completeZeroCopySends(message, 0, 0); })
+      .WillOnce(Return(Api::SysCallSizeResult{-1, EAGAIN}));
+  EXPECT_CALL(os_sys_calls_, sendmsg(_, _, _)).Times(0);
+  result = socket_.doWrite(buffer, false);
+  EXPECT_EQ(0, result.bytes_processed_);
+  EXPECT_EQ(0, buffer.length());
+}
+
+// The FIN is only sent once all bytes are queued in the kernel.
+TEST_F(RawBufferSocketZeroCopyTest, ShutdownAfterInFlightSends) {
+  Buffer::OwnedImpl buffer(std::string(4096, 'a'));
+
+  EXPECT_CALL(os_sys_calls_, sendmsg(10, _, MSG_ZEROCOPY))
+      .WillOnce(Return(Api::SysCallSizeResult{4096, 0}));
+  EXPECT_CALL(os_sys_calls_, shutdown(10, ENVOY_SHUT_WR));
+  socket_.doWrite(buffer, true);
+  EXPECT_EQ(4096, buffer.length());
+
+  EXPECT_CALL(os_sys_calls_, recvmsg(10, _, MSG_ERRQUEUE))
+      .WillOnce([](os_fd_t, msghdr* message, int) { return completeZeroCopySends(message, 0, 0); })
+      .WillOnce(Return(Api::SysCallSizeResult{-1, EAGAIN}));
+  socket_.doWrite(buffer, true);
+  EXPECT_EQ(0, buffer.length());
+}
+
+// Zero copy is turned off once the kernel reports that it copied the data anyway.
+TEST_F(RawBufferSocketZeroCopyTest, DisabledWhenCopied) {
+  Buffer::OwnedImpl buffer(std::string(4096, 'a'));
+
+  EXPECT_CALL(os_sys_calls_, sendmsg(10, _, MSG_ZEROCOPY))
+      .WillOnce(Return(Api::SysCallSizeResult{4096, 0}));
+  socket_.doWrite(buffer, false);
+
+  buffer.add(std::string(4096, 'b'));
+  EXPECT_CALL(os_sys_calls_, recvmsg(10, _, MSG_ERRQUEUE))
+      .WillOnce([](os_fd_t, msghdr* message, int) {
+        return completeZeroCopySends(message, 0, 0, SO_EE_CODE_ZEROCOPY_COPIED);
+      })
+      .WillOnce(Return(Api::SysCallSizeResult{-1, EAGAIN}));
+  EXPECT_CALL(os_sys_calls_, send(10, _, 4096, 0))
+      .WillOnce(Return(Api::SysCallSizeResult{4096, 0}));
+  socket_.doWrite(buffer, false);
+  EXPECT_EQ(0, buffer.length());
+}
+
+// Closing with zero copy sends in flight resets the connection, so that the kernel drops their
+// bytes before the connection frees the write buffer.
+TEST_F(RawBufferSocketZeroCopyTest, ResetOnCloseWithSendsInFlight) {
+  Buffer::OwnedImpl buffer(std::string(4096, 'a'));
+
+  EXPECT_CALL(os_sys_calls_, sendmsg(10, _, MSG_ZEROCOPY))
+      .WillOnce(Return(Api::SysCallSizeResult{4096, 0}));
+  socket_.doWrite(buffer, false);
+  EXPECT_EQ(4096, buffer.length());
+
+  EXPECT_CALL(os_sys_calls_, recvmsg(10, _, MSG_ERRQUEUE))
+      .WillOnce(Return(Api::SysCallSizeResult{-1, EAGAIN}));
+  EXPECT_CALL(os_sys_calls_, setsockopt_(10, SOL_SOCKET, SO_LINGER, _, sizeof(linger)))
+      .WillOnce([](os_fd_t, int, int, const void* optval, socklen_t) {
+        const auto* value = static_cast<const linger*>(optval);
+        EXPECT_EQ(1, value->l_onoff);
+        EXPECT_EQ(0, value->l_linger);
+        return 0;
+      });
+  socket_.closeSocket(ConnectionEvent::LocalClose);
+}
+
+// Sends that completed by the time of the close leave the close graceful.
+TEST_F(RawBufferSocketZeroCopyTest, NoResetOnCloseWithCompletedSends) {
+  Buffer::OwnedImpl buffer(std::string(4096, 'a'));
+
+  EXPECT_CALL(os_sys_calls_, sendmsg(10, _, MSG_ZEROCOPY))
+      .WillOnce(Return(Api::SysCallSizeResult{4096, 0}));
+  socket_.doWrite(buffer, false);
+
+  EXPECT_CALL(os_sys_calls_, recvmsg(10, _, MSG_ERRQUEUE))
+      .WillOnce([](os_fd_t, msghdr* message, int) { return completeZeroCopySends(message, 0, 0); })
+      .WillOnce(Return(Api::SysCallSizeResult{-1, EAGAIN}));
+  EXPECT_CALL(os_sys_calls_, setsockopt_(_, SOL_SOCKET, SO_LINGER, _, _)).Times(0);
+  socket_.closeSocket(ConnectionEvent::RemoteClose);
+}
+#endif
+
 } // namespace Network
 } // namespace Envoy
@@ -0,0 +1,112 @@
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "source/common/buffer/buffer_impl.h"
+#include "source/common/network/io_socket_handle_impl.h"
+#include "source/common/network/raw_buffer_socket.h"
+
+#include "test/mocks/network/mocks.h"
+
+#include "benchmark/benchmark.h"
+
+namespace Envoy {
+namespace Network {
+
+// Returns a connected pair of non-blocking TCP sockets on the loopback interface. SO_ZEROCOPY
+// needs TCP, a socketpair would refuse it.
+static std::pair<int, int> connectedTcpPair() {
+  int listener = ::socket(AF_INET, SOCK_STREAM, 0);
+  RELEASE_ASSERT(listener >= 0, "socket");
+  sockaddr_in addr{};
+  addr.sin_family = AF_INET;
+  addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  addr.sin_port = 0;
+  RELEASE_ASSERT(::bind(listener, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) == 0, "bind");
+  RELEASE_ASSERT(::listen(listener, 1) == 0, "listen");
+  socklen_t addr_len = sizeof(addr);
+  RELEASE_ASSERT(::getsockname(listener, reinterpret_cast<sockaddr*>(&addr), &addr_len) == 0,
+                 "getsockname");
+
+  int client = ::socket(AF_INET, SOCK_STREAM, 0);
+  RELEASE_ASSERT(client >= 0, "socket");
+  RELEASE_ASSERT(::connect(client, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) == 0,
+                 "connect");
+  int server = ::accept(listener, nullptr, nullptr);
+  RELEASE_ASSERT(server >= 0, "accept");
+  ::close(listener);
+
+  for (int fd : {client, server}) {
+    RELEASE_ASSERT(::fcntl(fd, F_SETFL, ::fcntl(fd, F_GETFL, 0) | O_NONBLOCK) == 0, "fcntl");
+  }
+  return {client, server};
+}
+
+// Append full-sized slices like socket reads or the HTTP codecs moving body data would.
+static void addFullSlices(Buffer::Instance& buffer, uint64_t length) {
+  while (buffer.length() < length) {
+    Buffer::Reservation reservation = buffer.reserveForRead();
+    const uint64_t slice_length =
+        std::min<uint64_t>(reservation.slices()[0].len_, length - buffer.length());
+    memset(reservation.slices()[0].mem_, 'a', slice_length);
+    reservation.commit(slice_length);
+  }
+}
+
+// Writes through RawBufferSocket::doWrite() with and without zero copy sends. The peer is
+// drained between the writes, like a fast reader on the other side of a connection would.
+// Loopback has no NIC to DMA from, the kernel copies the data of zero copy sends and the socket
+// falls back to copied sends after the first completion. The numbers for zero copy sends
+// therefore show the cost of the send path and the completion handling, not the saved copy.
+static void testRawBufferThroughput(benchmark::State& state) {
+  const uint64_t write_size = state.range(0);
+  const uint32_t zero_copy_send_threshold = state.range(1);
+
+  auto [client, server] = connectedTcpPair();
+  IoSocketHandleImpl io_handle(client);
+  testing::NiceMock<MockTransportSocketCallbacks> callbacks;
+  ON_CALL(callbacks, ioHandle()).WillByDefault(testing::ReturnRef(io_handle));
+  RawBufferSocket socket(zero_copy_send_threshold);
+  socket.setTransportSocketCallbacks(callbacks);
+
+  static uint8_t read_buf[1024 * 1024];
+
+  uint64_t bytes_written = 0;
+  for (auto _ : state) {
+    UNREFERENCED_PARAMETER(_);
+    state.PauseTiming();
+    Buffer::OwnedImpl write_buf;
+    addFullSlices(write_buf, write_size);
+    bytes_written += write_buf.length();
+    state.ResumeTiming();
+
+    uint32_t num_writes = 0;
+    while (write_buf.length() > 0) {
+      IoResult result = socket.doWrite(write_buf, false);
+      RELEASE_ASSERT(result.action_ == PostIoAction::KeepOpen, "doWrite failed");
+      num_writes++;
+      while (::read(server, read_buf, sizeof(read_buf)) > 0) {
+      }
+    }
+    state.counters["writes_per_iteration"] = num_writes;
+  }
+  state.counters["throughput"] = benchmark::Counter(bytes_written, benchmark::Counter::kIsRate);
+
+  socket.closeSocket(ConnectionEvent::LocalClose);
+  io_handle.close();
+  ::close(server);
+}
+
+static void testParams(benchmark::internal::Benchmark* b) {
+  for (int64_t zero_copy_send_threshold : {0, 16384}) {
+    for (int64_t write_size : {16384, 256 * 1024, 1024 * 1024, 8 * 1024 * 1024}) {
+      b->Args({write_size, zero_copy_send_threshold});
+    }
+  }
+}
+
+BENCHMARK(testRawBufferThroughput)->Unit(::benchmark::kMicrosecond)->Apply(testParams);
+
+} // namespace Network
+} // namespace Envoy
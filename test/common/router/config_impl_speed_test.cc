@@ -59,7 +59,7 @@ static RouteConfiguration genRouteConfig(benchmark::State& state,
       break;
     }
     case RouteMatch::PathSpecifierCase::kPath: {
-      match->set_prefix(absl::StrCat("/shelves/shelf_", i, "/route_", i));
+      match->set_path(absl::StrCat("/shelves/shelf_", i, "/route_", i));
       break;
     }
     case RouteMatch::PathSpecifierCase::kSafeRegex: {
@@ -78,7 +78,8 @@ static RouteConfiguration genRouteConfig(benchmark::State& state,
 
 /**
  * Measure the speed of doing a route match against a route table of varying sizes.
- * Why? Currently, route matching is linear in first-to-win ordering.
+ * Why? Route matching is linear in first-to-win ordering, unless the routes can be indexed on
+ * their exact paths, prefixes or an exact header value.
  *
  * We construct the first `n - 1` items in the route table so they are not
  * matched by the incoming request. Only the last route will be matched.
@@ -104,6 +105,41 @@ static void bmRouteTableSize(benchmark::State& state, RouteMatch::PathSpecifierC
   }
 }
 
+/**
+ * Benchmark a route table with routes that only differ by an exact match on a header, like the
+ * routes selecting a pool by the header set by a filter before it clears the route cache:
+ * - prefix: /, x-pool: pool_1
+ * - prefix: /, x-pool: pool_2
+ * - etc.
+ */
+static void bmRouteTableSizeWithHeaderExactMatch(benchmark::State& state) {
+  Api::ApiPtr api = Api::createApiForTest();
+  NiceMock<Server::Configuration::MockServerFactoryContext> factory_context;
+  NiceMock<Envoy::StreamInfo::MockStreamInfo> stream_info;
+  ON_CALL(factory_context, api()).WillByDefault(ReturnRef(*api));
+
+  RouteConfiguration route_config;
+  VirtualHost* v_host = route_config.add_virtual_hosts();
+  v_host->set_name("default");
+  v_host->add_domains("*");
+  for (int i = 0; i < state.range(0); ++i) {
+    Route* route = v_host->add_routes();
+    route->mutable_direct_response()->set_status(200);
+    route->mutable_match()->set_prefix("/");
+    envoy::config::route::v3::HeaderMatcher* header = route->mutable_match()->add_headers();
+    header->set_name("x-pool");
+    header->mutable_string_match()->set_exact(absl::StrCat("pool_", i));
+  }
+  ConfigImpl config(route_config, factory_context, ProtobufMessage::getNullValidationVisitor(),
+                    true);
+
+  Http::TestRequestHeaderMapImpl headers = genRequestHeaders(0);
+  headers.addCopy("x-pool", absl::StrCat("pool_", state.range(0) - 1));
+  for (auto _ : state) { // NOLINT
+    config.route(headers, stream_info, 0);
+  }
+}
+
 /**
  * Benchmark a route table with path prefix matchers in the form of:
  * - /shelves/shelf_1/...
@@ -139,6 +175,10 @@ static void bmRouteTableSizeWithRegexMatch(benchmark::State& state) {
 BENCHMARK(bmRouteTableSizeWithPathPrefixMatch)->RangeMultiplier(2)->Ranges({{1, 2 << 13}});
 BENCHMARK(bmRouteTableSizeWithExactPathMatch)->RangeMultiplier(2)->Ranges({{1, 2 << 13}});
 BENCHMARK(bmRouteTableSizeWithRegexMatch)->RangeMultiplier(2)->Ranges({{1, 2 << 13}});
+BENCHMARK(bmRouteTableSizeWithHeaderExactMatch)->RangeMultiplier(2)->Ranges({{1, 2 << 13}});
+BENCHMARK(bmRouteTableSizeWithPathPrefixMatch)->Arg(10000);
+BENCHMARK(bmRouteTableSizeWithExactPathMatch)->Arg(10000);
+BENCHMARK(bmRouteTableSizeWithHeaderExactMatch)->Arg(10000);
 
 } // namespace
 } // namespace Router
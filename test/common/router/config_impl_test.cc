@@ -2574,6 +2574,242 @@ virtual_hosts:
   }
 }
 
+// Routes indexed on the header most of them match exactly are still selected first match first.
+TEST_F(RouteMatcherTest, IndexedHeaderMatchedRouting) {
+  std::string yaml = R"EOF(
+virtual_hosts:
+- name: local_service
+  domains: ["*"]
+  routes:
+)EOF";
+  std::vector<std::string> clusters;
+  for (uint32_t i = 0; i < RouteIndex::MinIndexedRoutes; i++) {
+    if (i == 5) {
+      // Not indexed, and before the routes for the later pools.
+      absl::StrAppend(&yaml, R"EOF(
+  - match: { prefix: "/special" }
+    route: { cluster: special }
+)EOF");
+    }
+    absl::StrAppend(&yaml, fmt::format(R"EOF(
+  - match:
+      prefix: "/"
+      headers:
+      - name: x-pool
+        string_match: {{ exact: pool_{0} }}
+    route: {{ cluster: pool_{0} }}
+)EOF",
+                                       i));
+    clusters.push_back(absl::StrCat("pool_", i));
+  }
+  absl::StrAppend(&yaml, R"EOF(
+  - match:
+      prefix: "/"
+      headers:
+      - name: x-pool
+        string_match: { exact: pool_1 }
+        invert_match: true
+    route: { cluster: not_pool_1 }
+  - match: { prefix: "/" }
+    route: { cluster: default }
+)EOF");
+  clusters.insert(clusters.end(), {"special", "not_pool_1", "default"});
+
+  factory_context_.cluster_manager_.initializeClusters(clusters, {});
+  TestConfigImpl config(parseRouteConfigurationFromYaml(yaml), factory_context_, true);
+
+  {
+    Http::TestRequestHeaderMapImpl headers = genHeaders("www.lyft.com", "/", "GET");
+    headers.addCopy("x-pool", "pool_10");
+    EXPECT_EQ("pool_10", config.route(headers, 0)->routeEntry()->clusterName());
+  }
+  {
+    Http::TestRequestHeaderMapImpl headers = genHeaders("www.lyft.com", "/special", "GET");
+    headers.addCopy("x-pool", "pool_10");
+    EXPECT_EQ("special", config.route(headers, 0)->routeEntry()->clusterName());
+  }
+  {
+    Http::TestRequestHeaderMapImpl headers = genHeaders("www.lyft.com", "/special", "GET");
+    headers.addCopy("x-pool", "pool_1");
+    EXPECT_EQ("pool_1", config.route(headers, 0)->routeEntry()->clusterName());
+  }
+  {
+    Http::TestRequestHeaderMapImpl headers = genHeaders("www.lyft.com", "/", "GET");
+    headers.addCopy("x-pool", "pool_100");
+    EXPECT_EQ("not_pool_1", config.route(headers, 0)->routeEntry()->clusterName());
+  }
+  {
+    // Several values are matched joined with a comma.
+    Http::TestRequestHeaderMapImpl headers = genHeaders("www.lyft.com", "/", "GET");
+    headers.addCopy("x-pool", "pool_2");
+    headers.addCopy("x-pool", "pool_3");
+    EXPECT_EQ("not_pool_1", config.route(headers, 0)->routeEntry()->clusterName());
+  }
+  {
+    Http::TestRequestHeaderMapImpl headers = genHeaders("www.lyft.com", "/", "GET");
+    EXPECT_EQ("default", config.route(headers, 0)->routeEntry()->clusterName());
+  }
+}
+
+// Routes indexed on their exact paths and prefixes are still selected first match first.
+TEST_F(RouteMatcherTest, IndexedPathMatchedRouting) {
+  std::string yaml = R"EOF(
+virtual_hosts:
+- name: local_service
+  domains: ["*"]
+  routes:
+  - match: { prefix: "/shelves/shelf_1/" }
+    route: { cluster: shelf_1 }
+  - match: { prefix: "/SHELVES/", case_sensitive: false }
+    route: { cluster: any_case }
+)EOF";
+  std::vector<std::string> clusters{"shelf_1", "any_case"};
+  for (uint32_t i = 0; i < RouteIndex::MinIndexedRoutes; i++) {
+    absl::StrAppend(&yaml, fmt::format(R"EOF(
+  - match: {{ path: "/shelves/shelf_{0}/route_{0}" }}
+    route: {{ cluster: route_{0} }}
+  - match: {{ prefix: "/shelves/shelf_{0}/" }}
+    route: {{ cluster: shelf_{0} }}
+)EOF",
+                                       i));
+    clusters.push_back(absl::StrCat("route_", i));
+    clusters.push_back(absl::StrCat("shelf_", i));
+  }
+  absl::StrAppend(&yaml, R"EOF(
+  - match: { prefix: "/" }
+    route: { cluster: default }
+)EOF");
+  clusters.push_back("default");
+
+  factory_context_.cluster_manager_.initializeClusters(clusters, {});
+  TestConfigImpl config(parseRouteConfigurationFromYaml(yaml), factory_context_, true);
+
+  EXPECT_EQ("shelf_1",
+            config.route(genHeaders("www.lyft.com", "/shelves/shelf_1/route_1", "GET"), 0)
+                ->routeEntry()
+                ->clusterName());
+  EXPECT_EQ("any_case",
+            config.route(genHeaders("www.lyft.com", "/shelves/shelf_12/route_1", "GET"), 0)
+                ->routeEntry()
+                ->clusterName());
+  EXPECT_EQ("any_case", config.route(genHeaders("www.lyft.com", "/Shelves/shelf_1/route_1", "GET"), 0)
+                            ->routeEntry()
+                            ->clusterName());
+  EXPECT_EQ("default", config.route(genHeaders("www.lyft.com", "/shelves", "GET"), 0)
+                           ->routeEntry()
+                           ->clusterName());
+}
+
+// Same as above with the case insensitive route removed, so the exact paths are reached.
+TEST_F(RouteMatcherTest, IndexedExactPathMatchedRouting) {
+  std::string yaml = R"EOF(
+virtual_hosts:
+- name: local_service
+  domains: ["*"]
+  routes:
+)EOF";
+  std::vector<std::string> clusters;
+  for (uint32_t i = 0; i < RouteIndex::MinIndexedRoutes; i++) {
+    absl::StrAppend(&yaml, fmt::format(R"EOF(
+  - match: {{ path: "/shelves/shelf_{0}/route_{0}" }}
+    route: {{ cluster: route_{0} }}
+  - match: {{ prefix: "/shelves/shelf_{0}" }}
+    route: {{ cluster: shelf_{0} }}
+)EOF",
+                                       i));
+    clusters.push_back(absl::StrCat("route_", i));
+    clusters.push_back(absl::StrCat("shelf_", i));
+  }
+  absl::StrAppend(&yaml, R"EOF(
+  - match: { prefix: "/" }
+    route: { cluster: default }
+)EOF");
+  clusters.push_back("default");
+
+  factory_context_.cluster_manager_.initializeClusters(clusters, {});
+  TestConfigImpl config(parseRouteConfigurationFromYaml(yaml), factory_context_, true);
+
+  // The query is not part of the matched path.
+  EXPECT_EQ("route_2",
+            config.route(genHeaders("www.lyft.com", "/shelves/shelf_2/route_2?a=b", "GET"), 0)
+                ->routeEntry()
+                ->clusterName());
+  // The shorter prefix of an earlier route wins over the longer one.
+  EXPECT_EQ("shelf_1",
+            config.route(genHeaders("www.lyft.com", "/shelves/shelf_12/route_1", "GET"), 0)
+                ->routeEntry()
+                ->clusterName());
+  EXPECT_EQ("default", config.route(genHeaders("www.lyft.com", "/Shelves/shelf_1/route_1", "GET"), 0)
+                           ->routeEntry()
+                           ->clusterName());
+}
+
+// The virtual hosts and routes which did not change are reused by the next version of a config.
+TEST_F(RouteMatcherTest, ReuseUnchangedVirtualHostsAndRoutes) {
+  const std::string yaml = R"EOF(
+virtual_hosts:
+- name: a
+  domains: [a.com]
+  routes:
+  - match: {{ prefix: "/foo" }}
+    route: {{ cluster: {} }}
+  - match: {{ prefix: "/" }}
+    route: {{ cluster: default }}
+- name: b
+  domains: [b.com]
+  routes:
+  - match: {{ prefix: "/" }}
+    route: {{ cluster: default }}
+)EOF";
+  factory_context_.cluster_manager_.initializeClusters({"foo", "bar", "default"}, {});
+  NiceMock<Envoy::StreamInfo::MockStreamInfo> stream_info;
+  const auto route = [&stream_info](const ConfigImpl& config, const std::string& host,
+                                    const std::string& path) {
+    return config.route(genHeaders(host, path, "GET"), stream_info, 0).get();
+  };
+
+  ConfigImpl config1(parseRouteConfigurationFromYaml(fmt::format(yaml, "foo")), factory_context_,
+                     ProtobufMessage::getNullValidationVisitor(), false, nullptr, true);
+  EXPECT_EQ(2, config1.buildInfo().virtual_hosts_built_);
+  EXPECT_EQ(3, config1.buildInfo().routes_built_);
+  EXPECT_EQ(0, config1.buildInfo().routes_reused_);
+
+  ConfigImpl config2(parseRouteConfigurationFromYaml(fmt::format(yaml, "bar")), factory_context_,
+                     ProtobufMessage::getNullValidationVisitor(), false, &config1);
+  EXPECT_EQ(1, config2.buildInfo().virtual_hosts_built_);
+  EXPECT_EQ(1, config2.buildInfo().virtual_hosts_reused_);
+  EXPECT_EQ(1, config2.buildInfo().routes_built_);
+  EXPECT_EQ(2, config2.buildInfo().routes_reused_);
+  EXPECT_EQ("bar", route(config2, "a.com", "/foo")->routeEntry()->clusterName());
+  EXPECT_NE(route(config1, "a.com", "/foo"), route(config2, "a.com", "/foo"));
+  EXPECT_EQ(route(config1, "a.com", "/"), route(config2, "a.com", "/"));
+  EXPECT_EQ(route(config1, "b.com", "/"), route(config2, "b.com", "/"));
+
+  // The virtual hosts keep the configuration outside of them, it has to be the same.
+  envoy::config::route::v3::RouteConfiguration changed_common =
+      parseRouteConfigurationFromYaml(fmt::format(yaml, "bar"));
+  changed_common.add_response_headers_to_remove("x-foo");
+  ConfigImpl config3(changed_common, factory_context_, ProtobufMessage::getNullValidationVisitor(),
+                     false, &config2);
+  EXPECT_EQ(2, config3.buildInfo().virtual_hosts_built_);
+  EXPECT_EQ(0, config3.buildInfo().routes_reused_);
+  EXPECT_NE(route(config2, "b.com", "/"), route(config3, "b.com", "/"));
+
+  // Reused routes would not be validated against the current clusters.
+  ConfigImpl config4(parseRouteConfigurationFromYaml(fmt::format(yaml, "bar")), factory_context_,
+                     ProtobufMessage::getNullValidationVisitor(), true, &config2);
+  EXPECT_EQ(2, config4.buildInfo().virtual_hosts_built_);
+  EXPECT_EQ(0, config4.buildInfo().routes_reused_);
+
+  // Configs which are not reusable are not hashed, nothing is reused from them.
+  ConfigImpl config5(parseRouteConfigurationFromYaml(fmt::format(yaml, "bar")), factory_context_,
+                     ProtobufMessage::getNullValidationVisitor(), false);
+  ConfigImpl config6(parseRouteConfigurationFromYaml(fmt::format(yaml, "bar")), factory_context_,
+                     ProtobufMessage::getNullValidationVisitor(), false, &config5);
+  EXPECT_EQ(2, config6.buildInfo().virtual_hosts_built_);
+  EXPECT_EQ(0, config6.buildInfo().routes_reused_);
+}
+
 // Verify the fixes for https://github.com/envoyproxy/envoy/issues/2406
 TEST_F(RouteMatcherTest, InvalidHeaderMatchedRoutingConfig) {
   std::string value_with_regex_chars = R"EOF(
@@ -880,6 +880,58 @@ response_headers_to_add:
   }
 }
 
+// Overwriting a header which exists once keeps its position, other overwritten headers move to the
+// end.
+TEST(HeaderParserTest, EvaluateHeadersOverwriteKeepsOrder) {
+  const std::string yaml = R"EOF(
+match: { prefix: "/new_endpoint" }
+route:
+  cluster: www2
+response_headers_to_add:
+  - header:
+      key: "x-single"
+      value: "single"
+    append_action: OVERWRITE_IF_EXISTS_OR_ADD
+  - header:
+      key: "x-multi"
+      value: "multi"
+    append_action: OVERWRITE_IF_EXISTS
+  - header:
+      key: "x-added"
+      value: "added"
+    append_action: APPEND_IF_EXISTS_OR_ADD
+)EOF";
+
+  const auto route = parseRouteFromV3Yaml(yaml);
+  HeaderParserPtr resp_header_parser = HeaderParser::configure(route.response_headers_to_add());
+  NiceMock<Envoy::StreamInfo::MockStreamInfo> stream_info;
+
+  {
+    Http::TestResponseHeaderMapImpl header_map{
+        {"x-single", "a"}, {"x-multi", "b"}, {"x-multi", "c"}, {"x-last", "d"}};
+    resp_header_parser->evaluateHeaders(header_map, stream_info);
+    EXPECT_EQ((Http::TestResponseHeaderMapImpl{{"x-single", "single"},
+                                               {"x-last", "d"},
+                                               {"x-multi", "multi"},
+                                               {"x-added", "added"}}),
+              header_map);
+  }
+
+  {
+    TestScopedRuntime scoped_runtime;
+    scoped_runtime.mergeValues(
+        {{"envoy.reloadable_features.header_parser_replace_in_place", "false"}});
+    Http::TestResponseHeaderMapImpl header_map{
+        {"x-single", "a"}, {"x-multi", "b"}, {"x-multi", "c"}, {"x-last", "d"}};
+    resp_header_parser->evaluateHeaders(header_map, stream_info);
+    EXPECT_EQ((Http::TestResponseHeaderMapImpl{{"x-last", "d"},
+                                               {"x-single", "single"},
+                                               {"x-multi", "multi"},
+                                               {"x-added", "added"}}),
+              header_map);
+  }
+}
+
 TEST(HeaderParserTest, DEPRECATED_FEATURE_TEST(EvaluateRequestHeadersAddWithDeprecatedAppend)) {
   const std::string yaml = R"EOF(
 match: { prefix: "/new_endpoint" }
@@ -6396,7 +6396,8 @@ TEST_F(ClusterManagerImplTest, LocalInterfaceNameForUpstreamConnectionThrowsInWi
 
 class PreconnectTest : public ClusterManagerImplTest {
 public:
-  void initialize(float ratio) {
+  // cluster_options: additional fields of the cluster
+  void initialize(float ratio, const std::string& cluster_options = "") {
     const std::string yaml = R"EOF(
   static_resources:
     clusters:
@@ -6404,7 +6405,7 @@ public:
       connect_timeout: 0.250s
       lb_policy: ROUND_ROBIN
       type: STATIC
-  )EOF";
+  )EOF" + cluster_options;
 
     ReadyWatcher initialized;
     EXPECT_CALL(initialized, ready());
@@ -6494,6 +6495,50 @@ TEST_F(PreconnectTest, PreconnectOn) {
   tcp_handle.value().newConnection(tcp_callbacks_);
 }
 
+TEST_F(PreconnectTest, PrewarmAddedHosts) {
+  // With upstream.prewarm_connection_ratio set, the HTTP pool of every added host is created and
+  // preconnected when the hosts are added.
+  ON_CALL(runtime_.snapshot_, getDouble("upstream.prewarm_connection_ratio", 0))
+      .WillByDefault(Return(1.5));
+  EXPECT_CALL(factory_, allocateConnPool_(_, _, _, _, _))
+      .Times(4)
+      .WillRepeatedly(InvokeWithoutArgs([]() -> Http::ConnectionPool::Instance* {
+        auto* pool = new NiceMock<Http::ConnectionPool::MockInstance>();
+        EXPECT_CALL(*pool, maybePreconnect(1.5));
+        return pool;
+      }));
+  initialize(0);
+}
+
+TEST_F(PreconnectTest, NoPrewarmWithDownstreamProtocol) {
+  // Requests of HTTP/2 downstreams would not use the prewarmed HTTP/1.1 pool.
+  ON_CALL(runtime_.snapshot_, getDouble("upstream.prewarm_connection_ratio", 0))
+      .WillByDefault(Return(1));
+  EXPECT_CALL(factory_, allocateConnPool_(_, _, _, _, _)).Times(0);
+  initialize(0, R"EOF(
+      typed_extension_protocol_options:
+        envoy.extensions.upstreams.http.v3.HttpProtocolOptions:
+          "@type": type.googleapis.com/envoy.extensions.upstreams.http.v3.HttpProtocolOptions
+          use_downstream_protocol_config: {}
+  )EOF");
+}
+
+TEST_F(PreconnectTest, NoPrewarmWithAutoSni) {
+  // Requests carry the SNI in their transport socket options and use another pool.
+  ON_CALL(runtime_.snapshot_, getDouble("upstream.prewarm_connection_ratio", 0))
+      .WillByDefault(Return(1));
+  EXPECT_CALL(factory_, allocateConnPool_(_, _, _, _, _)).Times(0);
+  initialize(0, R"EOF(
+      typed_extension_protocol_options:
+        envoy.extensions.upstreams.http.v3.HttpProtocolOptions:
+          "@type": type.googleapis.com/envoy.extensions.upstreams.http.v3.HttpProtocolOptions
+          upstream_http_protocol_options:
+            auto_sni: true
+          explicit_http_config:
+            http_protocol_options: {}
+  )EOF");
+}
+
 TEST_F(PreconnectTest, PreconnectOnWithOverrideHost) {
   // With preconnect set to 1.1, maybePreconnect will kick off
   // preconnecting, so create the pool for both the current connection and the
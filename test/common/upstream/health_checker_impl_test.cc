@@ -4678,6 +4678,262 @@ TEST_F(TcpHealthCheckerImplTest, ConnectionLocalFailure) {
   EXPECT_EQ(0UL, cluster_->info_->stats_store_.counter("health_check.passive_failure").value());
 }
 
+// Tests that with health_check.shared_probes an endpoint of two clusters with the same health
+// check configuration is only probed by the first health checker and that the result is applied
+// to the hosts of both clusters.
+TEST_F(TcpHealthCheckerImplTest, SharedProbes) {
+  ON_CALL(runtime_.snapshot_, getBoolean("health_check.shared_probes", false))
+      .WillByDefault(Return(true));
+  const std::string yaml = R"EOF(
+    timeout: 1s
+    interval: 1s
+    unhealthy_threshold: 2
+    healthy_threshold: 2
+    tcp_health_check:
+      send:
+        text: "01"
+      receive:
+      - text: "02"
+    )EOF";
+
+  allocHealthChecker(yaml);
+  cluster_->prioritySet().getMockHostSet(0)->hosts_ = {
+      makeTestHost(cluster_->info_, "tcp://127.0.0.1:80", simTime())};
+  cluster_->prioritySet().getMockHostSet(0)->hosts_[0]->healthFlagSet(
+      Host::HealthFlag::FAILED_ACTIVE_HC);
+  expectSessionCreate();
+  expectClientCreate();
+  EXPECT_CALL(*connection_, write(_, _));
+  EXPECT_CALL(*timeout_timer_, enableTimer(_, _));
+  health_checker_->start();
+
+  std::shared_ptr<MockClusterMockPrioritySet> cluster2{
+      std::make_shared<NiceMock<MockClusterMockPrioritySet>>()};
+  cluster2->prioritySet().getMockHostSet(0)->hosts_ = {
+      makeTestHost(cluster2->info_, "tcp://127.0.0.1:80", simTime())};
+  cluster2->prioritySet().getMockHostSet(0)->hosts_[0]->healthFlagSet(
+      Host::HealthFlag::FAILED_ACTIVE_HC);
+  auto health_checker2 = std::make_shared<TcpHealthCheckerImpl>(
+      *cluster2, parseHealthCheckFromV3Yaml(yaml), dispatcher_, runtime_, random_, nullptr);
+  Event::MockTimer* interval_timer2 = new Event::MockTimer(&dispatcher_);
+  Event::MockTimer* timeout_timer2 = new Event::MockTimer(&dispatcher_);
+  EXPECT_CALL(*interval_timer2, enableTimer(_, _)).Times(0);
+  EXPECT_CALL(*timeout_timer2, enableTimer(_, _)).Times(0);
+  health_checker2->start();
+
+  connection_->raiseEvent(Network::ConnectionEvent::Connected);
+
+  EXPECT_CALL(event_logger_, logAddHealthy(_, _, true));
+  EXPECT_CALL(*timeout_timer_, disableTimer());
+  EXPECT_CALL(*interval_timer_, enableTimer(_, _));
+  Buffer::OwnedImpl response;
+  addUint8(response, 2);
+  read_filter_->onData(response, false);
+
+  EXPECT_EQ(Host::Health::Healthy,
+            cluster_->prioritySet().getMockHostSet(0)->hosts_[0]->coarseHealth());
+  EXPECT_EQ(Host::Health::Healthy,
+            cluster2->prioritySet().getMockHostSet(0)->hosts_[0]->coarseHealth());
+  EXPECT_EQ(1UL, cluster_->info_->stats_store_.counter("health_check.attempt").value());
+  EXPECT_EQ(0UL, cluster_->info_->stats_store_.counter("health_check.shared_result").value());
+  EXPECT_EQ(0UL, cluster2->info_->stats_store_.counter("health_check.attempt").value());
+  EXPECT_EQ(1UL, cluster2->info_->stats_store_.counter("health_check.success").value());
+  EXPECT_EQ(1UL, cluster2->info_->stats_store_.counter("health_check.shared_result").value());
+}
+
+// Tests that a cluster joining a shared target after the first check has the probing session
+// probe right away instead of waiting for its interval, and gets that result.
+TEST_F(TcpHealthCheckerImplTest, SharedProbesJoinAfterFirstCheck) {
+  const std::string yaml = R"EOF(
+    timeout: 1s
+    interval: 1s
+    no_traffic_interval: 5s
+    unhealthy_threshold: 2
+    healthy_threshold: 2
+    tcp_health_check:
+      send:
+        text: "01"
+      receive:
+      - text: "02"
+    )EOF";
+  ON_CALL(runtime_.snapshot_, getBoolean("health_check.shared_probes", false))
+      .WillByDefault(Return(true));
+  allocHealthChecker(yaml);
+  cluster_->prioritySet().getMockHostSet(0)->hosts_ = {
+      makeTestHost(cluster_->info_, "tcp://127.0.0.1:80", simTime())};
+  cluster_->prioritySet().getMockHostSet(0)->hosts_[0]->healthFlagSet(
+      Host::HealthFlag::FAILED_ACTIVE_HC);
+  expectSessionCreate();
+  expectClientCreate();
+  EXPECT_CALL(*connection_, write(_, _));
+  EXPECT_CALL(*timeout_timer_, enableTimer(_, _));
+  health_checker_->start();
+  connection_->raiseEvent(Network::ConnectionEvent::Connected);
+
+  std::shared_ptr<MockClusterMockPrioritySet> cluster2{
+      std::make_shared<NiceMock<MockClusterMockPrioritySet>>()};
+  cluster2->prioritySet().getMockHostSet(0)->hosts_ = {
+      makeTestHost(cluster2->info_, "tcp://127.0.0.1:80", simTime())};
+  cluster2->prioritySet().getMockHostSet(0)->hosts_[0]->healthFlagSet(
+      Host::HealthFlag::FAILED_ACTIVE_HC);
+  auto health_checker2 = std::make_shared<TcpHealthCheckerImpl>(
+      *cluster2, parseHealthCheckFromV3Yaml(yaml), dispatcher_, runtime_, random_, nullptr);
+
+  EXPECT_CALL(event_logger_, logAddHealthy(_, _, true));
+  EXPECT_CALL(*timeout_timer_, disableTimer());
+  EXPECT_CALL(*interval_timer_, enableTimer(std::chrono::milliseconds(5000), _));
+  Buffer::OwnedImpl response;
+  addUint8(response, 2);
+  read_filter_->onData(response, false);
+
+  // No probe in flight when the second cluster joins
+  Event::MockTimer* interval_timer2 = new Event::MockTimer(&dispatcher_);
+  Event::MockTimer* timeout_timer2 = new Event::MockTimer(&dispatcher_);
+  EXPECT_CALL(*interval_timer2, enableTimer(_, _)).Times(0);
+  EXPECT_CALL(*timeout_timer2, enableTimer(_, _)).Times(0);
+  EXPECT_CALL(*interval_timer_, enableTimer(std::chrono::milliseconds(0), _));
+  health_checker2->start();
+  EXPECT_EQ(Host::Health::Unhealthy,
+            cluster2->prioritySet().getMockHostSet(0)->hosts_[0]->coarseHealth());
+
+  EXPECT_CALL(*connection_, write(_, _));
+  EXPECT_CALL(*timeout_timer_, enableTimer(_, _));
+  interval_timer_->invokeCallback();
+  EXPECT_CALL(*timeout_timer_, disableTimer());
+  EXPECT_CALL(*interval_timer_, enableTimer(std::chrono::milliseconds(5000), _));
+  Buffer::OwnedImpl response2;
+  addUint8(response2, 2);
+  read_filter_->onData(response2, false);
+
+  EXPECT_EQ(Host::Health::Healthy,
+            cluster2->prioritySet().getMockHostSet(0)->hosts_[0]->coarseHealth());
+  EXPECT_EQ(2UL, cluster_->info_->stats_store_.counter("health_check.attempt").value());
+  EXPECT_EQ(0UL, cluster2->info_->stats_store_.counter("health_check.attempt").value());
+  EXPECT_EQ(1UL, cluster2->info_->stats_store_.counter("health_check.shared_result").value());
+}
+
+// Tests that the next session of a shared target takes over the probing when the host of the
+// probing session is removed.
+TEST_F(TcpHealthCheckerImplTest, SharedProbesHandover) {
+  const std::string yaml = R"EOF(
+    timeout: 1s
+    interval: 1s
+    no_traffic_interval: 5s
+    unhealthy_threshold: 2
+    healthy_threshold: 2
+    tcp_health_check:
+      send:
+        text: "01"
+      receive:
+      - text: "02"
+    )EOF";
+  ON_CALL(runtime_.snapshot_, getBoolean("health_check.shared_probes", false))
+      .WillByDefault(Return(true));
+  allocHealthChecker(yaml);
+  cluster_->prioritySet().getMockHostSet(0)->hosts_ = {
+      makeTestHost(cluster_->info_, "tcp://127.0.0.1:80", simTime())};
+  cluster_->prioritySet().getMockHostSet(0)->hosts_[0]->healthFlagSet(
+      Host::HealthFlag::FAILED_ACTIVE_HC);
+  expectSessionCreate();
+  expectClientCreate();
+  EXPECT_CALL(*connection_, write(_, _));
+  EXPECT_CALL(*timeout_timer_, enableTimer(_, _));
+  health_checker_->start();
+  connection_->raiseEvent(Network::ConnectionEvent::Connected);
+
+  std::shared_ptr<MockClusterMockPrioritySet> cluster2{
+      std::make_shared<NiceMock<MockClusterMockPrioritySet>>()};
+  cluster2->prioritySet().getMockHostSet(0)->hosts_ = {
+      makeTestHost(cluster2->info_, "tcp://127.0.0.1:80", simTime())};
+  cluster2->prioritySet().getMockHostSet(0)->hosts_[0]->healthFlagSet(
+      Host::HealthFlag::FAILED_ACTIVE_HC);
+  auto health_checker2 = std::make_shared<TcpHealthCheckerImpl>(
+      *cluster2, parseHealthCheckFromV3Yaml(yaml), dispatcher_, runtime_, random_, nullptr);
+  Event::MockTimer* interval_timer2 = new Event::MockTimer(&dispatcher_);
+  Event::MockTimer* timeout_timer2 = new Event::MockTimer(&dispatcher_);
+  EXPECT_CALL(*interval_timer2, enableTimer(_, _)).Times(0);
+  EXPECT_CALL(*timeout_timer2, enableTimer(_, _)).Times(0);
+  health_checker2->start();
+
+  // The host of the probing cluster goes away while its probe is in flight
+  EXPECT_CALL(*interval_timer2, enableTimer(std::chrono::milliseconds(5000), _));
+  HostVector old_hosts = std::move(cluster_->prioritySet().getMockHostSet(0)->hosts_);
+  cluster_->prioritySet().getMockHostSet(0)->runCallbacks({}, old_hosts);
+
+  // The second cluster probes itself now
+  expectClientCreate();
+  EXPECT_CALL(*connection_, write(_, _));
+  EXPECT_CALL(*timeout_timer2, enableTimer(_, _));
+  interval_timer2->invokeCallback();
+  connection_->raiseEvent(Network::ConnectionEvent::Connected);
+  EXPECT_CALL(*timeout_timer2, disableTimer());
+  EXPECT_CALL(*interval_timer2, enableTimer(std::chrono::milliseconds(5000), _));
+  Buffer::OwnedImpl response;
+  addUint8(response, 2);
+  read_filter_->onData(response, false);
+
+  EXPECT_EQ(Host::Health::Healthy,
+            cluster2->prioritySet().getMockHostSet(0)->hosts_[0]->coarseHealth());
+  EXPECT_EQ(1UL, cluster2->info_->stats_store_.counter("health_check.attempt").value());
+  EXPECT_EQ(0UL, cluster2->info_->stats_store_.counter("health_check.shared_result").value());
+}
+
+// Tests that a shared target is probed at the shortest interval of its subscribers: the second
+// cluster has traffic and uses the 1s interval, the probing one would use the 5s no traffic
+// interval on its own.
+TEST_F(TcpHealthCheckerImplTest, SharedProbesShortestInterval) {
+  const std::string yaml = R"EOF(
+    timeout: 1s
+    interval: 1s
+    no_traffic_interval: 5s
+    unhealthy_threshold: 2
+    healthy_threshold: 2
+    tcp_health_check:
+      send:
+        text: "01"
+      receive:
+      - text: "02"
+    )EOF";
+  ON_CALL(runtime_.snapshot_, getBoolean("health_check.shared_probes", false))
+      .WillByDefault(Return(true));
+  allocHealthChecker(yaml);
+  cluster_->prioritySet().getMockHostSet(0)->hosts_ = {
+      makeTestHost(cluster_->info_, "tcp://127.0.0.1:80", simTime())};
+  cluster_->prioritySet().getMockHostSet(0)->hosts_[0]->healthFlagSet(
+      Host::HealthFlag::FAILED_ACTIVE_HC);
+  expectSessionCreate();
+  expectClientCreate();
+  EXPECT_CALL(*connection_, write(_, _));
+  EXPECT_CALL(*timeout_timer_, enableTimer(_, _));
+  health_checker_->start();
+  connection_->raiseEvent(Network::ConnectionEvent::Connected);
+
+  std::shared_ptr<MockClusterMockPrioritySet> cluster2{
+      std::make_shared<NiceMock<MockClusterMockPrioritySet>>()};
+  cluster2->prioritySet().getMockHostSet(0)->hosts_ = {
+      makeTestHost(cluster2->info_, "tcp://127.0.0.1:80", simTime())};
+  cluster2->prioritySet().getMockHostSet(0)->hosts_[0]->healthFlagSet(
+      Host::HealthFlag::FAILED_ACTIVE_HC);
+  auto health_checker2 = std::make_shared<TcpHealthCheckerImpl>(
+      *cluster2, parseHealthCheckFromV3Yaml(yaml), dispatcher_, runtime_, random_, nullptr);
+  Event::MockTimer* interval_timer2 = new Event::MockTimer(&dispatcher_);
+  Event::MockTimer* timeout_timer2 = new Event::MockTimer(&dispatcher_);
+  cluster2->info_->trafficStats()->upstream_cx_total_.inc();
+  EXPECT_CALL(*interval_timer2, enableTimer(_, _)).Times(0);
+  EXPECT_CALL(*timeout_timer2, enableTimer(_, _)).Times(0);
+  health_checker2->start();
+
+  EXPECT_CALL(event_logger_, logAddHealthy(_, _, true));
+  EXPECT_CALL(*timeout_timer_, disableTimer());
+  EXPECT_CALL(*interval_timer_, enableTimer(std::chrono::milliseconds(1000), _));
+  Buffer::OwnedImpl response;
+  addUint8(response, 2);
+  read_filter_->onData(response, false);
+
+  EXPECT_EQ(Host::Health::Healthy,
+            cluster2->prioritySet().getMockHostSet(0)->hosts_[0]->coarseHealth());
+}
+
 class TestGrpcHealthCheckerImpl : public GrpcHealthCheckerImpl {
 public:
   using GrpcHealthCheckerImpl::GrpcHealthCheckerImpl;
@@ -1,5 +1,6 @@
 // Usage: bazel run //test/common/upstream:load_balancer_benchmark
 
+#include <algorithm>
 #include <memory>
 
 #include "envoy/config/cluster/v3/cluster.pb.h"
@@ -7,6 +8,7 @@
 #include "source/common/common/random_generator.h"
 #include "source/common/memory/stats.h"
 #include "source/common/upstream/upstream_impl.h"
+#include "source/common/upstream/worker_active_requests.h"
 #include "source/extensions/load_balancing_policies/maglev/maglev_lb.h"
 #include "source/extensions/load_balancing_policies/ring_hash/ring_hash_lb.h"
 
@@ -96,7 +98,12 @@ public:
 
 class LeastRequestTester : public BaseTester {
 public:
-  LeastRequestTester(uint64_t num_hosts, uint32_t choice_count) : BaseTester(num_hosts) {
+  LeastRequestTester(uint64_t num_hosts, uint32_t choice_count,
+                     bool worker_active_requests = false)
+      : BaseTester(num_hosts) {
+    ON_CALL(runtime_.snapshot_,
+            getBoolean("upstream.least_request.worker_active_requests", false))
+        .WillByDefault(testing::Return(worker_active_requests));
     envoy::config::cluster::v3::Cluster::LeastRequestLbConfig lr_lb_config;
     lr_lb_config.mutable_choice_count()->set_value(choice_count);
     lb_ = std::make_unique<LeastRequestLoadBalancer>(priority_set_, &local_priority_set_, stats_,
@@ -154,6 +161,55 @@ BENCHMARK(benchmarkRoundRobinLoadBalancerBuild)
     ->Args({50000, 100, 50})
     ->Unit(::benchmark::kMillisecond);
 
+// Health flaps of churn_percent of the hosts of a weighted cluster, the hosts are split into
+// num_localities localities of consecutive hosts. The flapping hosts are consecutive too, so
+// only one or two localities change per update and the schedulers of the others are kept.
+// Measures the host set update including the refresh of the load balancer schedulers.
+void benchmarkRoundRobinLoadBalancerHealthChurn(::benchmark::State& state) {
+  const uint64_t num_hosts = state.range(0);
+  const uint64_t num_localities = state.range(1);
+  const uint64_t churn_percent = state.range(2);
+
+  RoundRobinTester tester(num_hosts, 50, 50);
+  tester.initialize();
+  const HostVector& hosts = tester.priority_set_.hostSetsPerPriority()[0]->hosts();
+  std::vector<HostVector> locality_hosts(num_localities);
+  for (uint64_t i = 0; i < hosts.size(); i++) {
+    locality_hosts[i * num_localities / hosts.size()].push_back(hosts[i]);
+  }
+  HostVectorConstSharedPtr all_hosts = std::make_shared<HostVector>(hosts);
+  HostsPerLocalityConstSharedPtr hosts_per_locality =
+      makeHostsPerLocality(std::move(locality_hosts));
+  tester.priority_set_.updateHosts(
+      0, HostSetImpl::partitionHosts(all_hosts, hosts_per_locality), {}, {}, {}, absl::nullopt);
+
+  const uint64_t num_flapping = std::max<uint64_t>(1, num_hosts * churn_percent / 100);
+  uint64_t first_flapping = 0;
+  for (auto _ : state) { // NOLINT: Silences warning about dead store
+    state.PauseTiming();
+    // The previous hosts recover and the next ones fail
+    for (uint64_t i = 0; i < num_flapping; i++) {
+      (*all_hosts)[(first_flapping + i) % num_hosts]->healthFlagClear(
+          Host::HealthFlag::FAILED_ACTIVE_HC);
+    }
+    first_flapping = (first_flapping + num_flapping) % num_hosts;
+    for (uint64_t i = 0; i < num_flapping; i++) {
+      (*all_hosts)[(first_flapping + i) % num_hosts]->healthFlagSet(
+          Host::HealthFlag::FAILED_ACTIVE_HC);
+    }
+    state.ResumeTiming();
+
+    tester.priority_set_.updateHosts(
+        0, HostSetImpl::partitionHosts(all_hosts, hosts_per_locality), {}, {}, {}, absl::nullopt);
+  }
+}
+BENCHMARK(benchmarkRoundRobinLoadBalancerHealthChurn)
+    ->Args({10000, 1, 1})
+    ->Args({10000, 100, 1})
+    ->Args({10000, 1000, 1})
+    ->Args({10000, 1000, 10})
+    ->Unit(::benchmark::kMillisecond);
+
 class RingHashTester : public BaseTester {
 public:
   RingHashTester(uint64_t num_hosts, uint64_t min_ring_size) : BaseTester(num_hosts) {
@@ -315,6 +371,40 @@ BENCHMARK(benchmarkLeastRequestLoadBalancerChooseHost)
     ->Args({100, 100, 1000000})
     ->Unit(::benchmark::kMillisecond);
 
+void benchmarkLeastRequestLoadBalancerPickRate(::benchmark::State& state) {
+  const uint64_t num_hosts = state.range(0);
+  const uint64_t choice_count = state.range(1);
+  const bool worker_active_requests = state.range(2);
+
+  LeastRequestTester tester(num_hosts, choice_count, worker_active_requests);
+  // Spread the active requests so that the sampled hosts actually compete.
+  const HostVector& hosts = tester.priority_set_.hostSetsPerPriority()[0]->hosts();
+  for (uint64_t i = 0; i < hosts.size(); ++i) {
+    hosts[i]->stats().rq_active_.set(i % 7);
+    for (uint64_t rq = 0; rq < i % 7; ++rq) {
+      WorkerActiveRequests::onStreamAttached(*hosts[i]);
+    }
+  }
+  TestLoadBalancerContext context;
+
+  uint64_t picks = 0;
+  for (auto _ : state) { // NOLINT: Silences warning about dead store
+    benchmark::DoNotOptimize(tester.lb_->chooseHost(&context));
+    ++picks;
+  }
+  state.counters["picks_per_second"] =
+      ::benchmark::Counter(static_cast<double>(picks), ::benchmark::Counter::kIsRate);
+}
+BENCHMARK(benchmarkLeastRequestLoadBalancerPickRate)
+    ->Args({1000, 2, false})
+    ->Args({1000, 10, false})
+    ->Args({10000, 2, false})
+    ->Args({10000, 10, false})
+    ->Args({1000, 2, true})
+    ->Args({1000, 10, true})
+    ->Args({10000, 2, true})
+    ->Args({10000, 10, true});
+
 void benchmarkRingHashLoadBalancerChooseHost(::benchmark::State& state) {
   for (auto _ : state) { // NOLINT: Silences warning about dead store
     // Do not time the creation of the ring.
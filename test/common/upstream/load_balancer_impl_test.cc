@@ -14,6 +14,7 @@
 #include "source/common/network/utility.h"
 #include "source/common/upstream/load_balancer_impl.h"
 #include "source/common/upstream/upstream_impl.h"
+#include "source/common/upstream/worker_active_requests.h"
 
 #include "test/common/upstream/utility.h"
 #include "test/mocks/common.h"
@@ -990,6 +991,25 @@ TEST_P(RoundRobinLoadBalancerTest, Normal) {
   peekThenPick({2, 3});
 }
 
+// Hosts with a pending outlier ejection are skipped while there are other hosts to choose from.
+TEST_P(RoundRobinLoadBalancerTest, SkipHostWithPendingEjection) {
+  hostSet().healthy_hosts_ = {makeTestHost(info_, "tcp://127.0.0.1:80", simTime()),
+                              makeTestHost(info_, "tcp://127.0.0.1:81", simTime())};
+  hostSet().hosts_ = hostSet().healthy_hosts_;
+  auto* monitor = new NiceMock<Outlier::MockDetectorHostMonitor>();
+  ON_CALL(*monitor, ejectionPending()).WillByDefault(Return(true));
+  hostSet().healthy_hosts_[0]->setOutlierDetector(Outlier::DetectorHostMonitorPtr{monitor});
+  init(false);
+
+  EXPECT_EQ(hostSet().healthy_hosts_[1], lb_->chooseHost(nullptr));
+  EXPECT_EQ(hostSet().healthy_hosts_[1], lb_->chooseHost(nullptr));
+
+  // Once the ejection has been processed the host is selected again.
+  ON_CALL(*monitor, ejectionPending()).WillByDefault(Return(false));
+  EXPECT_EQ(hostSet().healthy_hosts_[0], lb_->chooseHost(nullptr));
+  EXPECT_EQ(hostSet().healthy_hosts_[1], lb_->chooseHost(nullptr));
+}
+
 // Validate that the RNG seed influences pick order.
 TEST_P(RoundRobinLoadBalancerTest, Seed) {
   hostSet().healthy_hosts_ = {
@@ -1156,6 +1176,47 @@ TEST_P(RoundRobinLoadBalancerTest, WeightedSeed) {
   EXPECT_EQ(hostSet().healthy_hosts_[1], lb_->chooseHost(nullptr));
 }
 
+// A refresh keeps the schedulers of localities whose hosts did not change: picks
+// continue where they were. A locality with changed health or weights starts over.
+TEST_P(RoundRobinLoadBalancerTest, WeightedLocalitySchedulersKeptOnRefresh) {
+  HostVector hosts = {makeTestHost(info_, "tcp://127.0.0.1:80", simTime(), 1),
+                      makeTestHost(info_, "tcp://127.0.0.1:81", simTime(), 2),
+                      makeTestHost(info_, "tcp://127.0.0.1:82", simTime(), 1),
+                      makeTestHost(info_, "tcp://127.0.0.1:83", simTime(), 2),
+                      makeTestHost(info_, "tcp://127.0.0.1:84", simTime(), 3)};
+  hostSet().hosts_ = hosts;
+  hostSet().healthy_hosts_ = hosts;
+  hostSet().hosts_per_locality_ =
+      makeHostsPerLocality({{hosts[0], hosts[1]}, {hosts[2], hosts[3], hosts[4]}});
+  hostSet().healthy_hosts_per_locality_ = hostSet().hosts_per_locality_;
+  init(false, true);
+
+  EXPECT_CALL(hostSet(), chooseHealthyLocality()).WillOnce(Return(0));
+  EXPECT_EQ(hosts[1], lb_->chooseHost(nullptr));
+  EXPECT_CALL(hostSet(), chooseHealthyLocality()).Times(2).WillRepeatedly(Return(1));
+  EXPECT_EQ(hosts[4], lb_->chooseHost(nullptr));
+  EXPECT_EQ(hosts[3], lb_->chooseHost(nullptr));
+
+  // hosts[4] fails, only locality 1 changes
+  hostSet().healthy_hosts_ = {hosts[0], hosts[1], hosts[2], hosts[3]};
+  hostSet().healthy_hosts_per_locality_ =
+      makeHostsPerLocality({{hosts[0], hosts[1]}, {hosts[2], hosts[3]}});
+  hostSet().runCallbacks({}, {});
+  // Locality 0 continues its schedule, a new one would start with hosts[1] again
+  EXPECT_CALL(hostSet(), chooseHealthyLocality()).WillOnce(Return(0));
+  EXPECT_EQ(hosts[0], lb_->chooseHost(nullptr));
+  // Locality 1 starts over, the old schedule would pick hosts[4] next
+  EXPECT_CALL(hostSet(), chooseHealthyLocality()).WillOnce(Return(1));
+  EXPECT_EQ(hosts[3], lb_->chooseHost(nullptr));
+
+  // A weight change in locality 0 rebuilds its schedule: hosts[0] now comes first,
+  // the old schedule would pick hosts[1] next
+  hosts[0]->weight(3);
+  hostSet().runCallbacks({}, {});
+  EXPECT_CALL(hostSet(), chooseHealthyLocality()).WillOnce(Return(0));
+  EXPECT_EQ(hosts[0], lb_->chooseHost(nullptr));
+}
+
 TEST_P(RoundRobinLoadBalancerTest, MaxUnhealthyPanic) {
   hostSet().healthy_hosts_ = {makeTestHost(info_, "tcp://127.0.0.1:80", simTime()),
                               makeTestHost(info_, "tcp://127.0.0.1:81", simTime())};
@@ -2832,6 +2893,48 @@ TEST_P(LeastRequestLoadBalancerTest, Normal) {
   EXPECT_EQ(hostSet().healthy_hosts_[1], lb_.chooseHost(nullptr));
 }
 
+// With upstream.least_request.worker_active_requests the hosts are compared by the requests the
+// pools of this worker have active, the hosts' gauges are not read.
+TEST_P(LeastRequestLoadBalancerTest, WorkerActiveRequests) {
+  hostSet().healthy_hosts_ = {makeTestHost(info_, "tcp://127.0.0.1:80", simTime()),
+                              makeTestHost(info_, "tcp://127.0.0.1:81", simTime())};
+  hostSet().hosts_ = hostSet().healthy_hosts_;
+  hostSet().runCallbacks({}, {}); // Trigger callbacks. The added/removed lists are not relevant.
+
+  ON_CALL(runtime_.snapshot_, getBoolean("upstream.least_request.worker_active_requests", false))
+      .WillByDefault(Return(true));
+  LeastRequestLoadBalancer lb{priority_set_, nullptr,        stats_,
+                              runtime_,      random_,        common_config_,
+                              least_request_lb_config_,      simTime()};
+  const HostSharedPtr host0 = hostSet().healthy_hosts_[0];
+  const HostSharedPtr host1 = hostSet().healthy_hosts_[1];
+
+  host0->stats().rq_active_.set(5);
+  WorkerActiveRequests::onStreamAttached(*host1);
+  EXPECT_CALL(random_, random()).WillOnce(Return(0)).WillOnce(Return(2)).WillOnce(Return(3));
+  EXPECT_EQ(host0, lb.chooseHost(nullptr));
+
+  WorkerActiveRequests::onStreamAttached(*host0);
+  WorkerActiveRequests::onStreamAttached(*host0);
+  EXPECT_CALL(random_, random()).WillOnce(Return(0)).WillOnce(Return(2)).WillOnce(Return(3));
+  EXPECT_EQ(host1, lb.chooseHost(nullptr));
+
+  // Hosts that stay in the host set keep their count when a host is added.
+  hostSet().healthy_hosts_.push_back(makeTestHost(info_, "tcp://127.0.0.1:82", simTime()));
+  hostSet().hosts_ = hostSet().healthy_hosts_;
+  hostSet().runCallbacks({hostSet().healthy_hosts_[2]}, {});
+  EXPECT_CALL(random_, random()).WillOnce(Return(0)).WillOnce(Return(3)).WillOnce(Return(1));
+  EXPECT_EQ(host1, lb.chooseHost(nullptr));
+
+  // Closing more streams than were counted leaves the count at 0.
+  WorkerActiveRequests::onStreamClosed(*host0);
+  WorkerActiveRequests::onStreamClosed(*host0);
+  WorkerActiveRequests::onStreamClosed(*host0);
+  WorkerActiveRequests::onStreamClosed(*host1);
+  EXPECT_CALL(random_, random()).WillOnce(Return(0)).WillOnce(Return(3)).WillOnce(Return(1));
+  EXPECT_EQ(host0, lb.chooseHost(nullptr));
+}
+
 TEST_P(LeastRequestLoadBalancerTest, PNC) {
   hostSet().healthy_hosts_ = {makeTestHost(info_, "tcp://127.0.0.1:80", simTime()),
                               makeTestHost(info_, "tcp://127.0.0.1:81", simTime()),
@@ -1813,6 +1813,41 @@ TEST_F(OutlierDetectorImplTest, CrossThreadRemoveRace) {
   EXPECT_EQ(0UL, outlier_detection_ejections_active_.value());
 }
 
+TEST_F(OutlierDetectorImplTest, WorkerFastEjection) {
+  ON_CALL(runtime_.snapshot_, getInteger(MaxEjectionPercentRuntime, _)).WillByDefault(Return(100));
+  ON_CALL(runtime_.snapshot_, getBoolean(WorkerFastEjectionRuntime, false))
+      .WillByDefault(Return(true));
+  EXPECT_CALL(cluster_.prioritySet(), addMemberUpdateCb(_));
+  addHosts({"tcp://127.0.0.1:80"});
+  EXPECT_CALL(*interval_timer_, enableTimer(std::chrono::milliseconds(10000), _));
+  std::shared_ptr<DetectorImpl> detector(DetectorImpl::create(cluster_, empty_outlier_detection_,
+                                                              dispatcher_, runtime_, time_system_,
+                                                              event_logger_, random_)
+                                             .value());
+  detector->addChangedStateCb([&](HostSharedPtr host) -> void { checker_.check(host); });
+
+  loadRq(hosts_[0], 4, 500);
+  EXPECT_FALSE(hosts_[0]->outlierDetector().ejectionPending());
+
+  Event::PostCb post_cb;
+  EXPECT_CALL(dispatcher_, post(_)).WillOnce([&post_cb](Event::PostCb cb) {
+    post_cb = std::move(cb);
+  });
+  loadRq(hosts_[0], 1, 500);
+
+  // The host is avoided before the main thread has processed the ejection.
+  EXPECT_TRUE(hosts_[0]->outlierDetector().ejectionPending());
+  EXPECT_FALSE(hosts_[0]->healthFlagGet(Host::HealthFlag::FAILED_OUTLIER_CHECK));
+
+  EXPECT_CALL(checker_, check(hosts_[0]));
+  EXPECT_CALL(*event_logger_, logEject(std::static_pointer_cast<const HostDescription>(hosts_[0]),
+                                       _, envoy::data::cluster::v3::CONSECUTIVE_5XX, true));
+  post_cb();
+  EXPECT_FALSE(hosts_[0]->outlierDetector().ejectionPending());
+  EXPECT_TRUE(hosts_[0]->healthFlagGet(Host::HealthFlag::FAILED_OUTLIER_CHECK));
+  EXPECT_EQ(1UL, outlier_detection_ejections_active_.value());
+}
+
 TEST_F(OutlierDetectorImplTest, CrossThreadDestroyRace) {
   EXPECT_CALL(cluster_.prioritySet(), addMemberUpdateCb(_));
   addHosts({"tcp://127.0.0.1:80"});
@@ -2712,6 +2747,16 @@ TEST(OutlierUtility, SRThreshold) {
   EXPECT_EQ(52.0, success_rate_nums.ejection_threshold_);   //  ejection threshold
 }
 
+TEST(OutlierUtility, SRThresholdPackedSuccessRates) {
+  std::vector<double> data = {50, 100, 100, 100, 100};
+  double sum = 450;
+
+  DetectorImpl::EjectionPair success_rate_nums =
+      DetectorImpl::successRateEjectionThreshold(sum, data, 1.9);
+  EXPECT_EQ(90.0, success_rate_nums.success_rate_average_);
+  EXPECT_EQ(52.0, success_rate_nums.ejection_threshold_);
+}
+
 } // namespace
 } // namespace Outlier
 } // namespace Upstream
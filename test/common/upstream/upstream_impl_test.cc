@@ -3684,6 +3684,46 @@ TEST(PrioritySet, MainPrioritySetTest) {
   EXPECT_EQ(nullptr, priority_set.mutableHostMapForTest().get());
 }
 
+// A copy of the host map shares its chunks with the original. Updating the copy must
+// not change the original.
+TEST(PrioritySet, CrossPriorityHostMapCopyOnWrite) {
+  std::shared_ptr<MockClusterInfo> info{new NiceMock<MockClusterInfo>()};
+  auto time_source = std::make_unique<NiceMock<MockTimeSystem>>();
+  HostVector hosts;
+  HostMap original;
+  for (int i = 0; i < 200; i++) {
+    hosts.push_back(makeTestHost(info, fmt::format("tcp://127.0.0.{}:80", i), *time_source));
+    original.insert(hosts.back()->address()->asString(), hosts.back());
+  }
+  EXPECT_EQ(200, original.size());
+
+  HostMap copy(original);
+  copy.erase(hosts[0]->address()->asString());
+  copy.erase(hosts[1]->address()->asString(), hosts[1]);
+  auto new_host = makeTestHost(info, "tcp://127.0.1.1:80", *time_source);
+  copy.insert(new_host->address()->asString(), new_host);
+
+  EXPECT_EQ(200, original.size());
+  EXPECT_NE(original.end(), original.find(hosts[0]->address()->asString()));
+  EXPECT_NE(original.end(), original.find(hosts[1]->address()->asString()));
+  EXPECT_EQ(original.end(), original.find(new_host->address()->asString()));
+
+  EXPECT_EQ(199, copy.size());
+  EXPECT_EQ(copy.end(), copy.find(hosts[0]->address()->asString()));
+  EXPECT_EQ(copy.end(), copy.find(hosts[1]->address()->asString()));
+  const auto it = copy.find(new_host->address()->asString());
+  ASSERT_NE(copy.end(), it);
+  EXPECT_EQ(new_host, it->second[0].first);
+
+  // Iteration visits every entry exactly once
+  size_t num_entries = 0;
+  for (const auto& entry : copy) {
+    EXPECT_FALSE(entry.second.empty());
+    num_entries++;
+  }
+  EXPECT_EQ(copy.size(), num_entries);
+}
+
 class ClusterInfoImplTest : public testing::Test {
 public:
   ClusterInfoImplTest() { ON_CALL(server_context_, api()).WillByDefault(ReturnRef(*api_)); }
@@ -0,0 +1,77 @@
+#include "source/extensions/filters/http/eric_proxy/body_buffer_budget.h"
+
+#include "test/common/stats/stat_test_utility.h"
+
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace HttpFilters {
+namespace EricProxy {
+
+class EricProxyBodyBufferBudgetTest : public ::testing::Test {
+protected:
+  Stats::TestUtil::TestStore stats_store_;
+  BodyBufferStats stats_{generateBodyBufferStats(*stats_store_.rootScope())};
+  BodyBufferBudget budget_;
+};
+
+// Bodies within the default limit are accounted, but never rejected
+TEST_F(EricProxyBodyBufferBudgetTest, DefaultSizedBodies) {
+  BodyBufferReservation first(budget_, BodyBufferBudget::DefaultWorkerBytes, stats_);
+  BodyBufferReservation second(budget_, BodyBufferBudget::DefaultWorkerBytes, stats_);
+
+  EXPECT_TRUE(first.update(1000));
+  EXPECT_TRUE(first.update(3000));
+  EXPECT_TRUE(second.update(BodyBufferBudget::DefaultMaxMessageBytes));
+  EXPECT_EQ(3000 + BodyBufferBudget::DefaultMaxMessageBytes, budget_.bytes());
+  EXPECT_EQ(3000 + BodyBufferBudget::DefaultMaxMessageBytes,
+            stats_store_.gauge("http.eric_proxy.body_buffer.bytes_all_workers",
+                               Stats::Gauge::ImportMode::Accumulate)
+                .value());
+
+  first.release();
+  EXPECT_EQ(BodyBufferBudget::DefaultMaxMessageBytes, budget_.bytes());
+  EXPECT_EQ(0, stats_store_.counter("http.eric_proxy.body_buffer.oversized_accepted").value());
+}
+
+// A large body is accepted while the worker's budget can hold it
+TEST_F(EricProxyBodyBufferBudgetTest, OversizedBodies) {
+  const uint64_t large = 2 * BodyBufferBudget::DefaultMaxMessageBytes;
+  {
+    BodyBufferReservation large_body(budget_, BodyBufferBudget::DefaultWorkerBytes, stats_);
+    EXPECT_TRUE(large_body.update(BodyBufferBudget::DefaultMaxMessageBytes + 1));
+    EXPECT_TRUE(large_body.update(large));
+    EXPECT_EQ(1, stats_store_.counter("http.eric_proxy.body_buffer.oversized_accepted").value());
+
+    // A second large body would exceed the budget
+    BodyBufferReservation other_body(budget_, BodyBufferBudget::DefaultWorkerBytes, stats_);
+    EXPECT_TRUE(other_body.update(BodyBufferBudget::DefaultMaxMessageBytes));
+    EXPECT_FALSE(other_body.update(large + 1));
+    EXPECT_EQ(1, stats_store_.counter("http.eric_proxy.body_buffer.oversized_rejected").value());
+    EXPECT_EQ(large + BodyBufferBudget::DefaultMaxMessageBytes, budget_.bytes());
+  }
+  // Released on destruction
+  EXPECT_EQ(0, budget_.bytes());
+
+  BodyBufferReservation large_body(budget_, BodyBufferBudget::DefaultWorkerBytes, stats_);
+  EXPECT_TRUE(large_body.update(large));
+  EXPECT_FALSE(large_body.update(BodyBufferBudget::DefaultWorkerBytes + 1));
+}
+
+// The size of the budget comes from the reservation, i.e. from the filter config
+TEST_F(EricProxyBodyBufferBudgetTest, ConfiguredWorkerBytes) {
+  const uint64_t large = BodyBufferBudget::DefaultMaxMessageBytes + 1;
+  BodyBufferReservation small_budget(budget_, large - 1, stats_);
+  EXPECT_FALSE(small_budget.update(large));
+  EXPECT_EQ(0, budget_.bytes());
+
+  BodyBufferReservation large_budget(budget_, 2 * BodyBufferBudget::DefaultWorkerBytes, stats_);
+  EXPECT_TRUE(large_budget.update(BodyBufferBudget::DefaultWorkerBytes + 1));
+  EXPECT_EQ(BodyBufferBudget::DefaultWorkerBytes + 1, budget_.bytes());
+}
+
+} // namespace EricProxy
+} // namespace HttpFilters
+} // namespace Extensions
+} // namespace Envoy
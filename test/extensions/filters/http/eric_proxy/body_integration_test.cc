@@ -5,6 +5,9 @@
 #include "test/integration/http_integration.h"
 #include "test/integration/utility.h"
 
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_replace.h"
+
 namespace Envoy {
 namespace Extensions {
 namespace HttpFilters {
@@ -124,6 +127,51 @@ typed_config:
 )EOF";
 
 
+  // No request filter case uses the request body. The response screening checks the
+  // request body.
+  const std::string config_response_screening = R"EOF(
+name: envoy.filters.http.eric_proxy
+typed_config:
+  "@type": type.googleapis.com/envoy.extensions.filters.http.eric_proxy.v3.EricProxyConfig
+  own_internal_port: 80
+  request_filter_cases:
+    routing:
+      own_nw:
+        name: own_network
+        start_fc_list:
+        - default_routing
+  response_filter_cases:
+    out_response_screening:
+      own_nw:
+        name: own_network
+        start_fc_list:
+        - response_screening
+  filter_cases:
+    - name: default_routing
+      filter_rules:
+      - name: csepp_to_rp_A
+        condition:
+          term_boolean: true
+        actions:
+        - action_route_to_roaming_partner:
+            roaming_partner_name: rp_A
+            routing_behaviour: ROUND_ROBIN
+    - name: response_screening
+      filter_rules:
+      - name: valid_body
+        condition:
+          op_isvalidjson: { request_body: true }
+        actions:
+        - action_add_header:
+            name: x-it-valid-body
+            value:
+              term_string: "true"
+  roaming_partners:
+    - name: rp_A
+      pool_name: sepp_rp_A
+)EOF";
+
+
 
 std::string ericProxyHttpProxyConfig() {
   return absl::StrCat(ConfigHelper::baseConfig(), fmt::format(R"EOF(
@@ -315,31 +363,98 @@ TEST_P(EricProxyFilterBodyIntegrationTest, TestWholeBodyExtraction) {
   codec_client_->close();
 }
 
-// Test too large body for the default max_message_bytes of 16000000
-TEST_P(EricProxyFilterBodyIntegrationTest, TestTooLargeRequestBody) {
-  initializeFilter(config_extract_whole_body);
+// The response screening only checks the response body, so the request body is streamed:
+// the request headers are forwarded before the body is sent.
+TEST_P(EricProxyFilterBodyIntegrationTest, TestRequestBodyStreamedWithResponseScreening) {
+  initializeFilter(absl::StrReplaceAll(config_response_screening,
+                                       {{"request_body: true", "response_body: true"}}));
+  const std::string body{R"({"subscriberIdentifier": "imsi-460001357924610"})"};
   Http::TestRequestHeaderMapImpl headers{
       {":method", "POST"},
       {":path", "/"},
       {":authority", "host"},
-      {"content-length", "16000001"}
+      {"content-type", "application/json"},
+      {"content-length", std::to_string(body.length())}
   };
 
-  FakeStreamPtr request_stream;
+  codec_client_ = makeHttpConnection(lookupPort("http"));
+  auto encoder_decoder = codec_client_->startRequest(headers);
+  auto response = std::move(encoder_decoder.second);
+  ASSERT_TRUE(fake_upstreams_[0]->waitForHttpConnection(*dispatcher_, fake_upstream_connection_));
+  ASSERT_TRUE(fake_upstream_connection_->waitForNewStream(*dispatcher_, upstream_request_));
+  ASSERT_TRUE(upstream_request_->waitForHeadersComplete());
+  EXPECT_THAT(upstream_request_->headers(), Http::HeaderValueOf("x-cluster", "sepp_rp_A"));
+
+  codec_client_->sendData(encoder_decoder.first, body, true);
+  ASSERT_TRUE(upstream_request_->waitForEndStream(*dispatcher_));
+  EXPECT_EQ(body, upstream_request_->body().toString());
+
+  upstream_request_->encodeHeaders(
+      Http::TestResponseHeaderMapImpl{{":status", "200"}, {"content-type", "application/json"}},
+      false);
+  upstream_request_->encodeData(body, true);
+  ASSERT_TRUE(response->waitForEndStream());
+  EXPECT_EQ("200", response->headers().getStatusValue());
+  EXPECT_THAT(response->headers(), Http::HeaderValueOf("x-it-valid-body", "true"));
+
+  codec_client_->close();
+}
+
+// The response screening checks the request body, so the request body is buffered
+// and still available when the response is processed
+TEST_P(EricProxyFilterBodyIntegrationTest, TestRequestBodyBufferedForResponseScreening) {
+  initializeFilter(config_response_screening);
+  const std::string body{R"({"subscriberIdentifier": "imsi-460001357924610"})"};
+  Http::TestRequestHeaderMapImpl headers{
+      {":method", "POST"},
+      {":path", "/"},
+      {":authority", "host"},
+      {"content-type", "application/json"},
+      {"content-length", std::to_string(body.length())}
+  };
 
   codec_client_ = makeHttpConnection(lookupPort("http"));
-  auto response = codec_client_->makeRequestWithBody(headers, 16000001);
+  auto response = codec_client_->makeRequestWithBody(headers, body);
+  ASSERT_TRUE(fake_upstreams_[0]->waitForHttpConnection(*dispatcher_, fake_upstream_connection_));
+  ASSERT_TRUE(fake_upstream_connection_->waitForNewStream(*dispatcher_, upstream_request_));
+  ASSERT_TRUE(upstream_request_->waitForEndStream(*dispatcher_));
+  EXPECT_EQ(body, upstream_request_->body().toString());
+
+  upstream_request_->encodeHeaders(Http::TestResponseHeaderMapImpl{{":status", "200"}}, true);
   ASSERT_TRUE(response->waitForEndStream());
-  // With HTTP/1 there's a possible race where if the connection backs up early,
-  // the 413-and-connection-close may be sent while the body is still being
-  // sent, resulting in a write error and the connection being closed before the
-  // response is read.
-  if (downstream_protocol_ >= Http::CodecType::HTTP2) {
-    ASSERT_TRUE(response->complete());
-  }
-  if (response->complete()) {
-    EXPECT_EQ(response->headers().getStatusValue(), "413");
-  }
+  EXPECT_EQ("200", response->headers().getStatusValue());
+  EXPECT_THAT(response->headers(), Http::HeaderValueOf("x-it-valid-body", "true"));
+
+  codec_client_->close();
+}
+
+// A body above the default max_message_bytes of 16000000 is accepted while the
+// worker's body buffer budget can hold it. Rejecting a large body when the budget
+// is used up is tested in filter_test.cc.
+TEST_P(EricProxyFilterBodyIntegrationTest, TestLargeRequestBodyAccepted) {
+  initializeFilter(config_one_fc);
+  const std::string body = absl::StrCat(R"({"subscriberIdentifier": "imsi-460001357924610", )",
+                                        R"("padding": ")", std::string(16000000, 'a'), R"("})");
+  Http::TestRequestHeaderMapImpl headers{
+      {":method", "POST"},
+      {":path", "/"},
+      {":authority", "host"},
+      {"content-type", "application/json"},
+      {"content-length", std::to_string(body.length())}
+  };
+
+  codec_client_ = makeHttpConnection(lookupPort("http"));
+  auto response = codec_client_->makeRequestWithBody(headers, body);
+  ASSERT_TRUE(fake_upstreams_[0]->waitForHttpConnection(*dispatcher_, fake_upstream_connection_));
+  ASSERT_TRUE(fake_upstream_connection_->waitForNewStream(*dispatcher_, upstream_request_));
+  ASSERT_TRUE(upstream_request_->waitForEndStream(*dispatcher_));
+  EXPECT_EQ(body.length(), upstream_request_->bodyLength());
+  EXPECT_THAT(upstream_request_->headers(),
+              Http::HeaderValueOf("x-it-header-name-added", "x-it-header-value-added"));
+
+  upstream_request_->encodeHeaders(Http::TestResponseHeaderMapImpl{{":status", "200"}}, true);
+  ASSERT_TRUE(response->waitForEndStream());
+  EXPECT_EQ("200", response->headers().getStatusValue());
 
   codec_client_->close();
 }
@@ -112,6 +112,73 @@ TEST(EricProxyFilterContextsTest, TestConstsHeadersVars) {
   EXPECT_EQ(c4, c1);
 }
 
+// Tests that the arena grows with additional blocks and keeps the alignment
+TEST(EricProxyFilterContextsTest, TestRunContextArena) {
+  RunContextArena arena(64);
+  EXPECT_EQ(arena.bytesReserved(), 0);
+  auto p1 = arena.allocate(3, 1);
+  auto p2 = arena.allocate(sizeof(uint64_t), alignof(uint64_t));
+  EXPECT_EQ(reinterpret_cast<uintptr_t>(p2) % alignof(uint64_t), 0);
+  EXPECT_GT(p2, p1);
+  EXPECT_EQ(arena.numOverflowBlocks(), 0);
+  arena.allocate(100, 8);
+  EXPECT_EQ(arena.numOverflowBlocks(), 1);
+  EXPECT_GE(arena.bytesReserved(), 64 + 100);
+  EXPECT_GE(arena.bytesUsed(), 3 + sizeof(uint64_t) + 100);
+}
+
+// Tests header values stored in the arena of the run-context and the usage statistics
+TEST(EricProxyFilterContextsTest, TestRunContextArenaHeaderValues) {
+  RootContext root_ctx;
+  auto idx = root_ctx.findOrInsertHeaderName("x-test");
+  {
+    RunContext run_ctx(&root_ctx);
+    EXPECT_FALSE(run_ctx.hasHeaderValue(idx, ReqOrResp::Request));
+    std::vector<absl::string_view> values{"a,b", "c"};
+    run_ctx.updateHeaderValueForTest(idx, values, 0);
+    EXPECT_TRUE(run_ctx.hasHeaderValue(idx, ReqOrResp::Request));
+    EXPECT_EQ(run_ctx.headerValue(idx, ReqOrResp::Request).size(), 3);
+    EXPECT_EQ(run_ctx.headerValue(idx, ReqOrResp::Request).get_allocator().arena(),
+              &run_ctx.arena());
+    run_ctx.removeHeader(idx, 0);
+    EXPECT_FALSE(run_ctx.hasHeaderValue(idx, ReqOrResp::Request));
+    // Unknown headers have a single empty value
+    EXPECT_EQ(run_ctx.headerValue(idx + 1, ReqOrResp::Request).size(), 1);
+    EXPECT_GT(run_ctx.arena().bytesUsed(), 0);
+  }
+  EXPECT_GT(root_ctx.arenaBytesEstimate(), 0);
+  EXPECT_GE(root_ctx.arenaSizeHint(), root_ctx.arenaBytesEstimate());
+}
+
+// Tests that the arena size estimate follows a larger usage at once and decays
+// back to the usage of smaller requests
+TEST(EricProxyFilterContextsTest, TestRunContextArenaEstimateDecays) {
+  RootContext root_ctx;
+  const size_t configured_size = root_ctx.arenaSizeHint();
+  RunContextArena large_arena(32 * 1024);
+  large_arena.allocate(32 * 1024, 1);
+  root_ctx.recordArenaUsage(large_arena);
+  EXPECT_EQ(root_ctx.arenaBytesEstimate(), 32 * 1024);
+  EXPECT_EQ(root_ctx.arenaSizeHint(), 32 * 1024);
+
+  RunContextArena small_arena(64);
+  small_arena.allocate(16, 1);
+  root_ctx.recordArenaUsage(small_arena);
+  EXPECT_LT(root_ctx.arenaBytesEstimate(), 32 * 1024);
+  EXPECT_GT(root_ctx.arenaBytesEstimate(), 30 * 1024);
+  for (size_t i = 0; i < 20 * RootContext::ArenaUsageDecay; i++) {
+    root_ctx.recordArenaUsage(small_arena);
+  }
+  EXPECT_LT(root_ctx.arenaBytesEstimate(), configured_size);
+  EXPECT_EQ(root_ctx.arenaSizeHint(), configured_size);
+
+  // Never more than the cap, however large a request was
+  RunContextArena huge_arena(1024 * 1024);
+  huge_arena.allocate(1024 * 1024, 1);
+  root_ctx.recordArenaUsage(huge_arena);
+  EXPECT_EQ(root_ctx.arenaSizeHint(), 64 * 1024);
+}
+
 } // namespace EricProxy
 } // namespace HttpFilters
 } // namespace Extensions
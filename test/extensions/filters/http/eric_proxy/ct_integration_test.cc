@@ -1352,6 +1352,44 @@ TEST_P(EricProxyFilterCtIntegrationTest, TestSuccessfulLookup_supi_egress_scr) {
                               exp_slf_req_headers);  // exp. headers slf req
 }
 
+// No filter case uses the request body, so it is streamed. The body is sent while
+// the request is paused for the SLF lookup, it is buffered until the lookup is done
+// and then forwarded with the request.
+TEST_P(EricProxyFilterCtIntegrationTest, TestSuccessfulLookupStreamedBody_supi) {
+  auto supi_test = std::regex_replace(config_basic, std::regex("<3gpp-id>*"),"supi");
+  initializeFilter(supi_test);
+  const std::string body{R"({"subscriberIdentifier": "imsi-460001357924610"})"};
+  Http::TestRequestHeaderMapImpl headers{
+      {":method", "POST"},
+      {":path", "/"},
+      {":authority", "host"},
+      {"x-test-supi", "12345"},
+      {"content-type", "application/json"},
+  };
+
+  codec_client_ = makeHttpConnection(lookupPort("http"));
+  auto encoder_decoder = codec_client_->startRequest(headers);
+  auto response = std::move(encoder_decoder.second);
+  codec_client_->sendData(encoder_decoder.first, body, true);
+
+  FakeStreamPtr slf_request_stream = noSlfResponse();
+  slf_request_stream->encodeHeaders(Http::TestResponseHeaderMapImpl{{":status", "200"}}, false);
+  slf_request_stream->encodeData(slfResponseResponseRegionA(), true);
+
+  ASSERT_TRUE(fake_upstreams_[0]->waitForHttpConnection(*dispatcher_, fake_upstream_connection_));
+  ASSERT_TRUE(fake_upstream_connection_->waitForNewStream(*dispatcher_, upstream_request_));
+  ASSERT_TRUE(upstream_request_->waitForEndStream(*dispatcher_));
+  EXPECT_THAT(upstream_request_->headers(), Http::HeaderValueOf("x-cluster", "region_A"));
+  EXPECT_EQ(body, upstream_request_->body().toString());
+  ASSERT_TRUE(fake_slf_connection_->close());
+
+  upstream_request_->encodeHeaders(Http::TestResponseHeaderMapImpl{{":status", "200"}}, true);
+  ASSERT_TRUE(response->waitForEndStream());
+  EXPECT_EQ("200", response->headers().getStatusValue());
+
+  codec_client_->close();
+}
+
 // x-cluster header is set to the region with the highest priority region_A
 // The value returned from the SLF is translated from a region name to the
 // cluster name with the help of a key-value table and action-modify-variable.
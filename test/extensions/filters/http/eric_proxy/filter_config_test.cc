@@ -162,6 +162,123 @@ roaming_partners:
   ASSERT_TRUE(root_cxt.hasVarName("chfsim"));
 }
 
+// Tests that the request body is only required if a filter case reachable in the
+// request direction reads or modifies it
+TEST(EricProxyFilterConfigTest, RequestBodyRequired) {
+  const std::string yaml = R"EOF(
+own_internal_port: 80
+request_filter_cases:
+  routing:
+    own_nw:
+      name: own_network
+      start_fc_list:
+      - default_routing
+filter_cases:
+  - name: default_routing
+    filter_data:
+    - name: apiRoot_data
+      header: 3gpp-Sbi-target-apiRoot
+      variable_name: apiroot
+    filter_rules:
+    - name: to_body_fc
+      condition:
+        op_exists: { arg1: { term_var: apiroot } }
+      actions:
+      - action_goto_filter_case: body_fc
+  - name: body_fc
+    filter_data:
+    - name: supi
+      body_json_pointer: "/subscriberIdentifier"
+      variable_name: supi
+  - name: unreachable_body_fc
+    filter_rules:
+    - name: modify_body
+      condition:
+        term_boolean: true
+      actions:
+      - action_create_body:
+          content: "{}"
+          content_type: application/json
+  )EOF";
+
+  EricProxyFilterProtoConfig proto_config;
+  TestUtility::loadFromYamlAndValidate(yaml, proto_config);
+  Upstream::MockClusterManager cluster_manager_;
+  EXPECT_TRUE(EricProxyFilterConfig(proto_config, cluster_manager_).isRequestBodyRequired());
+
+  // Without the goto the only filter case using the body is not reachable
+  proto_config.mutable_filter_cases(0)->mutable_filter_rules(0)->clear_actions();
+  EXPECT_FALSE(EricProxyFilterConfig(proto_config, cluster_manager_).isRequestBodyRequired());
+
+  // A SEPP always needs the body
+  proto_config.set_node_type(envoy::extensions::filters::http::eric_proxy::v3::SEPP);
+  EXPECT_TRUE(EricProxyFilterConfig(proto_config, cluster_manager_).isRequestBodyRequired());
+}
+
+// Tests that in the response direction the request body is only required if a filter case
+// reachable from the response screening start filter cases reads the request body.
+// body_json_pointer reads the response body there.
+TEST(EricProxyFilterConfigTest, RequestBodyRequiredByResponseScreening) {
+  const std::string yaml = R"EOF(
+own_internal_port: 80
+response_filter_cases:
+  out_response_screening:
+    own_nw:
+      name: own_network
+      start_fc_list:
+      - response_screening
+filter_cases:
+  - name: response_screening
+    filter_data:
+    - name: supi
+      body_json_pointer: "/subscriberIdentifier"
+      variable_name: supi
+    filter_rules:
+    - name: to_request_body_fc
+      condition:
+        op_exists: { arg1: { term_var: supi } }
+      actions:
+      - action_goto_filter_case: request_body_fc
+  - name: request_body_fc
+    filter_rules:
+    - name: valid_request
+      condition:
+        op_isvalidjson: { request_body: true }
+      actions:
+      - action_log:
+          max_log_message_length: 500
+          log_values:
+          - term_body: response
+          log_level: INFO
+  )EOF";
+
+  EricProxyFilterProtoConfig proto_config;
+  TestUtility::loadFromYamlAndValidate(yaml, proto_config);
+  Upstream::MockClusterManager cluster_manager_;
+  EXPECT_TRUE(EricProxyFilterConfig(proto_config, cluster_manager_).isRequestBodyRequired());
+
+  // Only the response body is used
+  proto_config.mutable_filter_cases(1)
+      ->mutable_filter_rules(0)
+      ->mutable_condition()
+      ->mutable_op_isvalidjson()
+      ->set_response_body(true);
+  EXPECT_FALSE(EricProxyFilterConfig(proto_config, cluster_manager_).isRequestBodyRequired());
+
+  // The request body is logged
+  proto_config.mutable_filter_cases(1)
+      ->mutable_filter_rules(0)
+      ->mutable_actions(0)
+      ->mutable_action_log()
+      ->mutable_log_values(0)
+      ->set_term_body("request");
+  EXPECT_TRUE(EricProxyFilterConfig(proto_config, cluster_manager_).isRequestBodyRequired());
+
+  // Without the goto the filter case using the request body is not reachable
+  proto_config.mutable_filter_cases(0)->mutable_filter_rules(0)->clear_actions();
+  EXPECT_FALSE(EricProxyFilterConfig(proto_config, cluster_manager_).isRequestBodyRequired());
+}
+
 }
 }
 }
@@ -1,10 +1,17 @@
 #include "source/extensions/filters/http/eric_proxy/filter.h"
 #include "source/extensions/filters/http/eric_proxy/tfqdn_codec.h"
+#include "test/common/stats/stat_test_utility.h"
+#include "test/test_common/logging.h"
 #include "test/test_common/utility.h"
+#include "test/mocks/access_log/mocks.h"
+#include "test/mocks/common.h"
 #include "test/mocks/http/mocks.h"
+#include "test/mocks/upstream/cluster_manager.h"
 #include "source/common/common/base64.h"
 #include "gtest/gtest.h"
 #include "gmock/gmock.h"
+#include "absl/strings/match.h"
+#include "absl/strings/str_cat.h"
 #include <array>
 #include <iostream>
 #include <tuple>
@@ -14,6 +21,14 @@ namespace Extensions {
 namespace HttpFilters {
 namespace EricProxy {
 
+using testing::_;
+using testing::ElementsAre;
+using testing::Invoke;
+using testing::NiceMock;
+using testing::Pair;
+using testing::ReturnPointee;
+using testing::SaveArg;
+
 std::string nrf_discovery_result{R"(
 {
     "validityPeriod": 60,
@@ -2277,6 +2292,88 @@ TEST(EricProxyFilterTest, TestSelectTarsForRemoteRouting_Preferred4) {
   }
 }
 
+// The decoded discovery result can be shared by nf-selection-on-priority and remote routing
+TEST(EricProxyFilterTest, TestSelectOnDecodedNfDiscoveryResult) {
+  const uint32_t num_reselections = 10;
+  Json json_body = Json::parse(nlf_lookup_result);
+  const auto discovery_result = EricProxyFilter::decodeNfDiscoveryResult(json_body, IPver::IPv4);
+  EXPECT_EQ(discovery_result.numInstances(), json_body.at("nfInstances").size());
+
+  const auto selected_nf = EricProxyFilter::selectNfOnPriority(discovery_result);
+  const auto selected_nf_json = EricProxyFilter::selectNfOnPriority(json_body, IPver::IPv4);
+  EXPECT_TRUE(selected_nf.ok());
+  EXPECT_TRUE(selected_nf_json.ok());
+  EXPECT_EQ(selected_nf.value().hostname, "FQDN_1_1.example.com:9091");
+  EXPECT_EQ(selected_nf.value().hostname, selected_nf_json.value().hostname);
+  EXPECT_EQ(selected_nf.value().set_id, selected_nf_json.value().set_id);
+
+  const auto result = EricProxyFilter::selectTarsForRemoteRouting(
+      discovery_result, num_reselections, selected_nf.value().set_id);
+  const auto result_json = EricProxyFilter::selectTarsForRemoteRouting(
+      json_body, num_reselections, IPver::IPv4, selected_nf.value().set_id);
+  EXPECT_TRUE(result.ok());
+  EXPECT_TRUE(result_json.ok());
+  EXPECT_EQ(result.value().size(), 2);
+  EXPECT_EQ(result.value(), result_json.value());
+}
+
+// A non-string api prefix is reported as malformed discovery result
+TEST(EricProxyFilterTest, TestSelectTarsForRemoteRoutingInvalidApiPrefix) {
+  Json json_body = Json::parse(nlf_lookup_result);
+  for (auto& nf_instance : json_body.at("nfInstances")) {
+    nf_instance.at("nfServices").at(0)["apiPrefix"] = 5;
+  }
+  const auto result = EricProxyFilter::selectTarsForRemoteRouting(json_body, 1, IPver::IPv4);
+  EXPECT_FALSE(result.ok());
+  EXPECT_EQ(result.status().code(), absl::StatusCode::kInvalidArgument);
+  EXPECT_EQ(result.status().message(), "Invalid api Prefix");
+}
+
+// Each malformed part of the decoded discovery result keeps the status of its cause
+TEST(EricProxyFilterTest, TestSelectOnDecodedNfDiscoveryResultInvalidCause) {
+  const auto expect_invalid = [](const Json& json_body, absl::string_view message) {
+    const auto selected_nf = EricProxyFilter::selectNfOnPriority(json_body, IPver::IPv4);
+    EXPECT_FALSE(selected_nf.ok());
+    EXPECT_EQ(selected_nf.status().code(), absl::StatusCode::kInvalidArgument);
+    EXPECT_EQ(selected_nf.status().message(), message);
+    const auto tars = EricProxyFilter::selectTarsForRemoteRouting(json_body, 1, IPver::IPv4);
+    EXPECT_FALSE(tars.ok());
+    EXPECT_EQ(tars.status().code(), absl::StatusCode::kInvalidArgument);
+    EXPECT_EQ(tars.status().message(), message);
+  };
+
+  {
+    Json json_body = Json::parse(nlf_lookup_result);
+    json_body.at("nfInstances").at(0)["nfServiceList"] = Json::array();
+    expect_invalid(json_body, "Invalid NF service list");
+  }
+  {
+    Json json_body = Json::parse(nlf_lookup_result);
+    json_body.at("nfInstances").at(0).at("nfServices") = Json::object();
+    expect_invalid(json_body, "Invalid NF services");
+  }
+  {
+    Json json_body = Json::parse(nlf_lookup_result);
+    json_body.at("nfInstances").at(0).at("nfServices").at(0).erase("scheme");
+    expect_invalid(json_body, "NF service does not contain scheme");
+  }
+  {
+    Json json_body = Json::parse(nlf_lookup_result);
+    json_body.at("nfInstances").at(0).at("nfServices").at(0)["ipEndPoints"] = Json::object();
+    expect_invalid(json_body, "Invalid IP endpoints");
+  }
+  {
+    Json json_body = Json::parse(nlf_lookup_result);
+    json_body.at("nfInstances").at(0).at("nfServices").at(0).at("priority") = "high";
+    expect_invalid(json_body, "Invalid priority in NF service");
+  }
+  {
+    Json json_body = Json::parse(nlf_lookup_result);
+    json_body.at("nfInstances").at(0).at("nfServices").at(0).at("capacity") = "high";
+    expect_invalid(json_body, "Invalid capacity in NF service");
+  }
+}
+
 //========================================================================
 // Scrambling/Mapping and Descrambling/Demapping
 //========================================================================
@@ -2951,6 +3048,324 @@ TEST(EricProxyFilterTest, TestDescramble9) {
   EXPECT_TRUE(result.empty());
 }
 
+//------------------------------------------------------------------------
+// Filter driven through its decoder callbacks with a request
+
+class EricProxyFilterRequestTest : public ::testing::Test {
+protected:
+  const std::string config_basic_ = R"EOF(
+own_internal_port: 80
+request_filter_cases:
+  routing:
+    own_nw:
+      name: own_network
+      start_fc_list:
+      - default_routing
+filter_cases:
+  - name: default_routing
+    filter_data:
+    - name: supi
+      body_json_pointer: "/subscriberIdentifier"
+      variable_name: supi
+)EOF";
+
+  void initializeFilter(const std::string& yaml) {
+    EricProxyConfig proto_config;
+    TestUtility::loadFromYamlAndValidate(yaml, proto_config);
+    config_ = std::make_shared<EricProxyFilterConfig>(proto_config, cluster_manager_);
+    stats_ = std::make_shared<EricProxyStats>(config_, *stats_store_.rootScope(), "");
+    filter_ = std::make_unique<EricProxyFilter>(
+        config_, std::chrono::system_clock::now(), random_, stats_,
+        std::make_shared<AlarmNotifier>("", access_log_manager_));
+    filter_->setDecoderFilterCallbacks(decoder_callbacks_);
+    filter_->setEncoderFilterCallbacks(encoder_callbacks_);
+
+    ON_CALL(decoder_callbacks_, addDecodedData(_, _))
+        .WillByDefault(Invoke([this](Buffer::Instance& data, bool) {
+          if (decoder_callbacks_.buffer_ == nullptr) {
+            decoder_callbacks_.buffer_ = std::make_unique<Buffer::OwnedImpl>();
+          }
+          decoder_callbacks_.buffer_->move(data);
+        }));
+    ON_CALL(decoder_callbacks_, decoderBufferLimit()).WillByDefault(ReturnPointee(&buffer_limit_));
+    ON_CALL(decoder_callbacks_, setDecoderBufferLimit(_))
+        .WillByDefault(SaveArg<0>(&buffer_limit_));
+  }
+
+  ~EricProxyFilterRequestTest() override {
+    if (filter_ != nullptr) {
+      filter_->onDestroy();
+    }
+  }
+
+  Stats::TestUtil::TestStore stats_store_;
+  NiceMock<Upstream::MockClusterManager> cluster_manager_;
+  NiceMock<Random::MockRandomGenerator> random_;
+  NiceMock<AccessLog::MockAccessLogManager> access_log_manager_;
+  NiceMock<Http::MockStreamDecoderFilterCallbacks> decoder_callbacks_;
+  NiceMock<Http::MockStreamEncoderFilterCallbacks> encoder_callbacks_;
+  EricProxyFilterConfigSharedPtr config_;
+  EricProxyStatsSharedPtr stats_;
+  std::unique_ptr<EricProxyFilter> filter_;
+  uint32_t buffer_limit_{0};
+  Http::TestRequestHeaderMapImpl request_headers_{{":method", "POST"},
+                                                  {":path", "/nudm-uecm/v1/registrations"},
+                                                  {":authority", "host"},
+                                                  {"content-type", "application/json"}};
+};
+
+//------------------------------------------------------------------------
+// Default body limit and the per-worker body buffer budget
+
+class EricProxyFilterBodyBufferBudgetTest : public EricProxyFilterRequestTest {};
+
+// A body above the default limit is buffered while the worker's budget can hold it
+TEST_F(EricProxyFilterBodyBufferBudgetTest, LargeRequestBodyAccepted) {
+  initializeFilter(config_basic_);
+  EXPECT_EQ(Http::FilterHeadersStatus::StopIteration,
+            filter_->decodeHeaders(request_headers_, false));
+  EXPECT_EQ(BodyBufferBudget::DefaultMaxMessageBytes, buffer_limit_);
+
+  EXPECT_CALL(encoder_callbacks_, sendLocalReply(_, _, _, _, _)).Times(0);
+  Buffer::OwnedImpl data(std::string(BodyBufferBudget::DefaultMaxMessageBytes + 1, 'a'));
+  EXPECT_EQ(Http::FilterDataStatus::StopIterationAndBuffer, filter_->decodeData(data, false));
+  EXPECT_EQ(BodyBufferBudget::DefaultMaxMessageBytes + 1, buffer_limit_);
+  EXPECT_EQ(BodyBufferBudget::DefaultMaxMessageBytes + 1,
+            BodyBufferBudget::forCurrentThread().bytes());
+  EXPECT_EQ(1, stats_store_.counter("http.eric_proxy.body_buffer.oversized_accepted").value());
+
+  filter_->onDestroy();
+  EXPECT_EQ(0, BodyBufferBudget::forCurrentThread().bytes());
+}
+
+// A body above the default limit is rejected with the default local reply if the
+// other bodies buffered on the worker leave too little of the budget
+TEST_F(EricProxyFilterBodyBufferBudgetTest, LargeRequestBodyRejectedWhenBudgetUsedUp) {
+  initializeFilter(config_basic_);
+  BodyBufferReservation other_body(BodyBufferBudget::forCurrentThread(),
+                                   BodyBufferBudget::DefaultWorkerBytes,
+                                   stats_->bodyBufferStats());
+  ASSERT_TRUE(other_body.update(BodyBufferBudget::DefaultWorkerBytes -
+                                BodyBufferBudget::DefaultMaxMessageBytes));
+
+  EXPECT_EQ(Http::FilterHeadersStatus::StopIteration,
+            filter_->decodeHeaders(request_headers_, false));
+  EXPECT_CALL(encoder_callbacks_, sendLocalReply(Http::Code::PayloadTooLarge, _, _, _, _));
+  Buffer::OwnedImpl data(std::string(BodyBufferBudget::DefaultMaxMessageBytes + 1, 'a'));
+  EXPECT_EQ(Http::FilterDataStatus::StopIterationNoBuffer, filter_->decodeData(data, false));
+  EXPECT_EQ(BodyBufferBudget::DefaultMaxMessageBytes, buffer_limit_);
+  EXPECT_EQ(1, stats_store_.counter("http.eric_proxy.body_buffer.oversized_rejected").value());
+}
+
+// A configured limit governs the body on its own, the body is not accounted in the
+// worker's budget
+TEST_F(EricProxyFilterBodyBufferBudgetTest, ConfiguredLimitNotAccounted) {
+  initializeFilter(absl::StrCat(config_basic_, R"EOF(
+request_validation:
+  check_message_bytes:
+    max_message_bytes: 20000000
+)EOF"));
+
+  EXPECT_EQ(Http::FilterHeadersStatus::StopIteration,
+            filter_->decodeHeaders(request_headers_, false));
+  EXPECT_EQ(20000000, buffer_limit_);
+
+  EXPECT_CALL(encoder_callbacks_, sendLocalReply(_, _, _, _, _)).Times(0);
+  Buffer::OwnedImpl data(std::string(BodyBufferBudget::DefaultMaxMessageBytes + 1, 'a'));
+  EXPECT_EQ(Http::FilterDataStatus::StopIterationAndBuffer, filter_->decodeData(data, false));
+  EXPECT_EQ(20000000, buffer_limit_);
+  EXPECT_EQ(0, BodyBufferBudget::forCurrentThread().bytes());
+  EXPECT_EQ(0, stats_store_
+                   .gauge("http.eric_proxy.body_buffer.bytes_all_workers",
+                          Stats::Gauge::ImportMode::Accumulate)
+                   .value());
+  EXPECT_EQ(0, stats_store_.counter("http.eric_proxy.body_buffer.oversized_accepted").value());
+  EXPECT_EQ(0, stats_store_.counter("http.eric_proxy.body_buffer.oversized_rejected").value());
+}
+
+// The worker's budget is taken from the filter config
+TEST_F(EricProxyFilterBodyBufferBudgetTest, ConfiguredWorkerBudget) {
+  initializeFilter(absl::StrCat(config_basic_, R"EOF(
+body_buffer_worker_max_bytes: 16000000
+)EOF"));
+  EXPECT_EQ(16000000, config_->bodyBufferWorkerMaxBytes());
+
+  EXPECT_EQ(Http::FilterHeadersStatus::StopIteration,
+            filter_->decodeHeaders(request_headers_, false));
+  EXPECT_CALL(encoder_callbacks_, sendLocalReply(Http::Code::PayloadTooLarge, _, _, _, _));
+  Buffer::OwnedImpl data(std::string(BodyBufferBudget::DefaultMaxMessageBytes + 1, 'a'));
+  EXPECT_EQ(Http::FilterDataStatus::StopIterationNoBuffer, filter_->decodeData(data, false));
+  EXPECT_EQ(1, stats_store_.counter("http.eric_proxy.body_buffer.oversized_rejected").value());
+}
+
+//------------------------------------------------------------------------
+// Filter-data and header values are loaded once per filter-case until an action runs
+
+class EricProxyFilterCaseLoadPlanTest : public EricProxyFilterRequestTest {
+protected:
+  // The second filter-rule needs the filter-data of the first one plus another one
+  std::string configWithFirstRuleActions(const std::string& first_rule_actions) {
+    return absl::StrCat(R"EOF(
+own_internal_port: 80
+request_filter_cases:
+  routing:
+    own_nw:
+      name: own_network
+      start_fc_list:
+      - default_routing
+filter_cases:
+  - name: default_routing
+    filter_data:
+    - name: mcc_data
+      header: x-mcc
+      variable_name: mcc
+    - name: mnc_data
+      header: x-mnc
+      variable_name: mnc
+    filter_rules:
+    - name: mcc_rule
+      condition:
+        op_equals: { typed_config1: {'@type': 'type.googleapis.com/envoy.extensions.filters.http.eric_proxy.v3.Value', term_var: mcc }, typed_config2: {'@type': 'type.googleapis.com/envoy.extensions.filters.http.eric_proxy.v3.Value', term_string: '262' }}
+      actions:
+)EOF",
+                        first_rule_actions, R"EOF(
+    - name: mcc_mnc_rule
+      condition:
+        op_equals: { typed_config1: {'@type': 'type.googleapis.com/envoy.extensions.filters.http.eric_proxy.v3.Value', term_var: mcc }, typed_config2: {'@type': 'type.googleapis.com/envoy.extensions.filters.http.eric_proxy.v3.Value', term_var: mnc }}
+      actions:
+      - action_add_header:
+          name: x-mcc-is-mnc
+          value:
+            term_string: "true"
+)EOF");
+  }
+
+  const std::string add_header_action_ = R"EOF(
+      - action_add_header:
+          name: x-mcc-matched
+          value:
+            term_string: "true"
+)EOF";
+};
+
+// The plan is computed at config time: values of earlier filter-rules are marked
+TEST_F(EricProxyFilterCaseLoadPlanTest, PlanComputedAtConfigTime) {
+  initializeFilter(configWithFirstRuleActions(add_header_action_));
+  std::string fc_name = "default_routing";
+  const auto filter_case = config_->filterCaseByName(fc_name);
+  ASSERT_NE(nullptr, filter_case);
+  ASSERT_EQ(2, filter_case->filterRules().size());
+
+  const auto& first_plan = filter_case->loadPlan(0);
+  ASSERT_EQ(1, first_plan.filter_data.size());
+  EXPECT_EQ("mcc_data", first_plan.filter_data[0].first->name());
+  EXPECT_EQ(FilterCaseWrapper::NoEarlierRule, first_plan.filter_data[0].second);
+
+  const auto& second_plan = filter_case->loadPlan(1);
+  ASSERT_EQ(2, second_plan.filter_data.size());
+  for (const auto& [filter_data, earlier_rule] : second_plan.filter_data) {
+    if (filter_data->name() == "mcc_data") {
+      EXPECT_EQ(0, earlier_rule);
+    } else {
+      EXPECT_EQ("mnc_data", filter_data->name());
+      EXPECT_EQ(FilterCaseWrapper::NoEarlierRule, earlier_rule);
+    }
+  }
+}
+
+// Filter-data loaded for the first filter-rule is not extracted again for the second one
+TEST_F(EricProxyFilterCaseLoadPlanTest, NoActionSkipsExtraction) {
+  initializeFilter(configWithFirstRuleActions(add_header_action_));
+  request_headers_.addCopy(Http::LowerCaseString("x-mcc"), "208");
+  request_headers_.addCopy(Http::LowerCaseString("x-mnc"), "01");
+
+  EXPECT_LOG_CONTAINS_N_TIMES("debug", "Processing filter data: mcc_data", 1,
+                              filter_->decodeHeaders(request_headers_, true));
+  EXPECT_TRUE(request_headers_.get(Http::LowerCaseString("x-mcc-matched")).empty());
+}
+
+// An action can change the headers, the filter-data is extracted again after it
+TEST_F(EricProxyFilterCaseLoadPlanTest, ActionResetsLoadedData) {
+  initializeFilter(configWithFirstRuleActions(add_header_action_));
+  request_headers_.addCopy(Http::LowerCaseString("x-mcc"), "262");
+  request_headers_.addCopy(Http::LowerCaseString("x-mnc"), "01");
+
+  EXPECT_LOG_CONTAINS_N_TIMES("debug", "Processing filter data: mcc_data", 2,
+                              filter_->decodeHeaders(request_headers_, true));
+  EXPECT_FALSE(request_headers_.get(Http::LowerCaseString("x-mcc-matched")).empty());
+}
+
+//------------------------------------------------------------------------
+// Header actions replace the header values in one batch of header mutations
+
+class EricProxyFilterReplaceHeaderTest : public EricProxyFilterRequestTest {
+protected:
+  const std::string config_replace_ = R"EOF(
+own_internal_port: 80
+request_filter_cases:
+  routing:
+    own_nw:
+      name: own_network
+      start_fc_list:
+      - default_routing
+filter_cases:
+  - name: default_routing
+    filter_rules:
+    - name: replace_rule
+      condition:
+        term_boolean: true
+      actions:
+      - action_add_header:
+          name: x-single
+          value:
+            term_string: new
+          if_exists: REPLACE
+      - action_modify_header:
+          name: x-multi
+          append_value:
+            term_string: ";m"
+)EOF";
+
+  // The x-* test headers in the order they are sent
+  std::vector<std::pair<std::string, std::string>> testHeaders() {
+    std::vector<std::pair<std::string, std::string>> test_headers;
+    request_headers_.iterate([&test_headers](const Http::HeaderEntry& header) {
+      if (absl::StartsWith(header.key().getStringView(), "x-")) {
+        test_headers.emplace_back(header.key().getStringView(), header.value().getStringView());
+      }
+      return Http::HeaderMap::Iterate::Continue;
+    });
+    return test_headers;
+  }
+};
+
+// A header which exists once keeps its position, a header with several values is replaced by
+// the modified values at the end
+TEST_F(EricProxyFilterReplaceHeaderTest, ReplaceKeepsSingleHeaderPosition) {
+  initializeFilter(config_replace_);
+  request_headers_.addCopy(Http::LowerCaseString("x-single"), "old");
+  request_headers_.addCopy(Http::LowerCaseString("x-multi"), "a");
+  request_headers_.addCopy(Http::LowerCaseString("x-multi"), "b");
+  request_headers_.addCopy(Http::LowerCaseString("x-last"), "c");
+  const Http::HeaderEntry* single = request_headers_.get(Http::LowerCaseString("x-single"))[0];
+
+  filter_->decodeHeaders(request_headers_, true);
+
+  EXPECT_EQ(single, request_headers_.get(Http::LowerCaseString("x-single"))[0]);
+  EXPECT_THAT(testHeaders(), ElementsAre(Pair("x-single", "new"), Pair("x-last", "c"),
+                                         Pair("x-multi", "a;m"), Pair("x-multi", "b;m")));
+}
+
+// A header which does not exist yet is added at the end
+TEST_F(EricProxyFilterReplaceHeaderTest, ReplaceAddsMissingHeader) {
+  initializeFilter(config_replace_);
+  request_headers_.addCopy(Http::LowerCaseString("x-last"), "c");
+
+  filter_->decodeHeaders(request_headers_, true);
+
+  EXPECT_THAT(testHeaders(), ElementsAre(Pair("x-last", "c"), Pair("x-single", "new")));
+}
+
 } // namespace EricProxy
 } // namespace HttpFilters
 } // namespace Extensions
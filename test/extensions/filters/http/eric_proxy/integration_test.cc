@@ -2047,6 +2047,36 @@ TEST_P(EricProxyFilterIntegrationTest, TestStrictRoutingMalformedTarWrongSyntax)
   codec_client_->close();
 }
 
+// STRICT BEHAVIOR
+// repeated TaR: the inline header holds both values comma separated,
+// which is not a valid URI
+// should return 400 error
+TEST_P(EricProxyFilterIntegrationTest, TestStrictRoutingRepeatedTar) {
+  BasicClusterConfigurator cluster_config = BasicClusterConfigurator(
+    ClusterDefinition({{"universal_pool", {"eric-chfsim-6-mnc-456-mcc-456:3777"}}})
+  );
+  initConfig(config_basic, cluster_config);
+  Http::TestRequestHeaderMapImpl headers{
+      {":method", "GET"},
+      {":path", "/"},
+      {":authority", "host"},
+      {"3gpp-Sbi-target-apiRoot", "http://eric-chfsim-6-mnc-456-mcc-456:3777"},
+      {"3gpp-Sbi-target-apiRoot", "http://eric-chfsim-7-mnc-456-mcc-456:3777"},
+      };
+
+  codec_client_ = makeHttpConnection(lookupPort("http"));
+  auto response = codec_client_->makeHeaderOnlyRequest(headers);
+  ASSERT_TRUE(response->waitForEndStream());
+
+  EXPECT_EQ("400", response->headers().getStatusValue());
+  EXPECT_EQ("application/problem+json", response->headers().getContentTypeValue());
+  EXPECT_EQ(
+      R"({"status": 400, "title": "Bad Request", "cause": "MANDATORY_IE_INCORRECT", "detail": "3gpp-sbi-target-apiroot_header_malformed"})",
+      response->body());
+
+  codec_client_->close();
+}
+
 // A BASIC TEST, STRICT BEHAVIOR, with a (dummy) screening filter before/after routing (DND-26598)
 TEST_P(EricProxyFilterIntegrationTest, TestStrictRoutingAfterScreening) {
   BasicClusterConfigurator cluster_config = BasicClusterConfigurator(
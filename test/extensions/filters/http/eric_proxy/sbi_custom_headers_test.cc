@@ -0,0 +1,76 @@
+#include "source/extensions/filters/http/eric_proxy/sbi_custom_headers.h"
+#include "test/test_common/utility.h"
+
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace HttpFilters {
+namespace EricProxy {
+
+// The SBI headers are found through the inline handles, regardless of the case they
+// were added with
+TEST(EricProxySbiCustomHeadersTest, InlineHeaders) {
+  Http::TestRequestHeaderMapImpl headers{
+      {"3gpp-Sbi-target-apiRoot", "https://nrf.5gc.mnc012.mcc345.3gppnetwork.org:443"},
+      {"3gpp-Sbi-Callback", "Nchf_ConvergedCharging_Notify"},
+      {"3gpp-Sbi-Routing-Binding", "bl=nfset; nfset=set1.chfset.5gc.mnc012.mcc345"}};
+  headers.addCopy(SbiHeaders::get().NfPeerInfo, "srcinst=1; dstinst=2");
+
+  EXPECT_EQ("https://nrf.5gc.mnc012.mcc345.3gppnetwork.org:443",
+            headers.getInlineValue(SbiCustomHeaders::targetApiRoot()));
+  EXPECT_EQ("Nchf_ConvergedCharging_Notify", headers.getInlineValue(SbiCustomHeaders::callback()));
+  EXPECT_EQ("bl=nfset; nfset=set1.chfset.5gc.mnc012.mcc345",
+            headers.getInlineValue(SbiCustomHeaders::routingBinding()));
+  EXPECT_EQ("srcinst=1; dstinst=2", headers.getInlineValue(SbiCustomHeaders::nfPeerInfo()));
+  EXPECT_EQ(headers.getInline(SbiCustomHeaders::targetApiRoot()),
+            headers.get(SbiHeaders::get().TargetApiRoot)[0]);
+
+  headers.removeInline(SbiCustomHeaders::targetApiRoot());
+  EXPECT_TRUE(headers.get(SbiHeaders::get().TargetApiRoot).empty());
+
+  Http::TestResponseHeaderMapImpl response_headers{{":status", "307"}};
+  response_headers.setCopy(SbiHeaders::get().TargetApiRoot, "https://scp.own_plmn.com");
+  EXPECT_EQ("https://scp.own_plmn.com",
+            response_headers.getInlineValue(SbiCustomHeaders::responseTargetApiRoot()));
+}
+
+// Repeated SBI headers are merged into the inline header, comma separated
+TEST(EricProxySbiCustomHeadersTest, RepeatedHeadersAreMerged) {
+  Http::TestRequestHeaderMapImpl headers{
+      {"3gpp-Sbi-target-apiRoot", "https://nrf1.5gc.mnc012.mcc345.3gppnetwork.org"},
+      {"3gpp-Sbi-target-apiRoot", "https://nrf2.5gc.mnc012.mcc345.3gppnetwork.org"},
+      {"3gpp-Sbi-NF-Peer-Info", "srcinst=1; dstinst=2"},
+      {"3gpp-Sbi-NF-Peer-Info", "srcinst=3; dstscp=SCP-scp.host.de"}};
+
+  ASSERT_EQ(1, headers.get(SbiHeaders::get().TargetApiRoot).size());
+  EXPECT_EQ("https://nrf1.5gc.mnc012.mcc345.3gppnetwork.org,"
+            "https://nrf2.5gc.mnc012.mcc345.3gppnetwork.org",
+            headers.getInlineValue(SbiCustomHeaders::targetApiRoot()));
+  ASSERT_EQ(1, headers.get(SbiHeaders::get().NfPeerInfo).size());
+  EXPECT_EQ("srcinst=1; dstinst=2,srcinst=3; dstscp=SCP-scp.host.de",
+            headers.getInlineValue(SbiCustomHeaders::nfPeerInfo()));
+}
+
+// Tests the detection of the 3gpp-Sbi-Discovery-* headers
+TEST(EricProxySbiCustomHeadersTest, DiscoveryHeaders) {
+  Http::TestRequestHeaderMapImpl headers{
+      {"3gpp-Sbi-Discovery-target-nf-type", "CHF"},
+      {"3gpp-sbi-discovery-service-names", "nchf-convergedcharging"},
+      {"3gpp-Sbi-Discovery", "no-parameter"},
+      {"x-discovery-target-nf-type", "CHF"}};
+  std::vector<absl::string_view> discovery_headers;
+  headers.iterate([&discovery_headers](const Http::HeaderEntry& header) {
+    if (SbiCustomHeaders::isDiscoveryHeader(header)) {
+      discovery_headers.push_back(header.key().getStringView());
+    }
+    return Http::HeaderMap::Iterate::Continue;
+  });
+  EXPECT_THAT(discovery_headers, testing::ElementsAre("3gpp-sbi-discovery-target-nf-type",
+                                                      "3gpp-sbi-discovery-service-names"));
+}
+
+} // namespace EricProxy
+} // namespace HttpFilters
+} // namespace Extensions
+} // namespace Envoy
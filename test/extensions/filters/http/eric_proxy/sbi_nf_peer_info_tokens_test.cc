@@ -0,0 +1,130 @@
+#include "source/extensions/filters/http/eric_proxy/eric_sbi_nf_peer_info/sbi_nf_peer_info.h"
+#include "source/extensions/filters/http/eric_proxy/eric_sbi_nf_peer_info/sbi_nf_peer_info_tokens.h"
+#include "test/test_common/utility.h"
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace HttpFilters {
+namespace EricProxy {
+
+using Key = SbiNfPeerInfoTokens::Key;
+
+class EricProxySbiNfPeerInfoTokensTest : public ::testing::Test {};
+
+TEST_F(EricProxySbiNfPeerInfoTokensTest, ParseKnownAndUnknownTokens) {
+  const SbiNfPeerInfoTokens tokens(
+      "srcinst=2ec8ac0b; srcservinst=123;dstscp=SCP-scp.host.de ;  foo=bar; dstinst=789");
+
+  EXPECT_EQ("2ec8ac0b", tokens.get(Key::SrcInst).value());
+  EXPECT_EQ("123", tokens.get(Key::SrcServInst).value());
+  EXPECT_EQ("SCP-scp.host.de", tokens.get(Key::DstScp).value());
+  EXPECT_EQ("789", tokens.get(Key::DstInst).value());
+  EXPECT_FALSE(tokens.has(Key::SrcScp));
+  EXPECT_FALSE(tokens.get(Key::DstSepp).has_value());
+  // tokens keep their order, unknown tokens stay where they are
+  EXPECT_EQ("srcinst=2ec8ac0b; srcservinst=123; dstscp=SCP-scp.host.de; foo=bar; dstinst=789",
+            tokens.toString());
+}
+
+TEST_F(EricProxySbiNfPeerInfoTokensTest, FirstOccurrenceWins) {
+  SbiNfPeerInfoTokens tokens("dstinst=1; dstinst=2");
+  EXPECT_EQ("1", tokens.get(Key::DstInst).value());
+  EXPECT_EQ("dstinst=1; dstinst=2", tokens.toString());
+  // all occurrences are replaced
+  tokens.set(Key::DstInst, "3");
+  EXPECT_EQ("dstinst=3", tokens.toString());
+}
+
+// Repeated headers are merged into one inline header with ",", the tokens are the same
+// as if the headers were joined with ";"
+TEST_F(EricProxySbiNfPeerInfoTokensTest, RepeatedHeaders) {
+  Http::TestRequestHeaderMapImpl headers{{"3gpp-Sbi-NF-Peer-Info", "srcinst=1; dstinst=2"},
+                                         {"3gpp-Sbi-NF-Peer-Info", "srcinst=3; dstscp=SCP-a"}};
+  const SbiNfPeerInfoTokens tokens = SbiNfPeerInfoTokens::fromHeaders(headers);
+
+  EXPECT_EQ("1", tokens.get(Key::SrcInst).value());
+  EXPECT_EQ("2", tokens.get(Key::DstInst).value());
+  EXPECT_EQ("SCP-a", tokens.get(Key::DstScp).value());
+  EXPECT_EQ("srcinst=1; dstinst=2; srcinst=3; dstscp=SCP-a", tokens.toString());
+}
+
+// Setting a token moves it to the end and appends it with ";", removing a token
+// separates all remaining ones with "; " (as editing the header string token by token did)
+TEST_F(EricProxySbiNfPeerInfoTokensTest, TokenOrder) {
+  SbiNfPeerInfoTokens tokens("srcinst=1;foo;dstinst=2; dstservinst=3");
+  tokens.set(Key::SrcInst, "4");
+  EXPECT_EQ("foo; dstinst=2; dstservinst=3;srcinst=4", tokens.toString());
+  tokens.set(Key::SrcScp, "SCP-a");
+  EXPECT_EQ("foo; dstinst=2; dstservinst=3; srcinst=4;srcscp=SCP-a", tokens.toString());
+  tokens.remove(Key::DstServInst);
+  EXPECT_EQ("foo; dstinst=2; srcinst=4; srcscp=SCP-a", tokens.toString());
+  tokens.remove(Key::DstSepp);
+  EXPECT_EQ("foo; dstinst=2; srcinst=4; srcscp=SCP-a", tokens.toString());
+}
+
+// The request header as built in the router from an empty header
+TEST_F(EricProxySbiNfPeerInfoTokensTest, RequestHeaderFromScratch) {
+  SbiNfPeerInfoTokens tokens;
+  SbiNfPeerInfo::setSrcScp(tokens, "scp.own_plmn.com");
+  SbiNfPeerInfo::setDstScp(tokens, "cluster_0_host_0");
+  tokens.set(Key::DstInst, "100");
+  tokens.set(Key::SrcInst, "307");
+  tokens.set(Key::SrcServInst, "308");
+  EXPECT_EQ("srcscp=SCP-scp.own_plmn.com; dstscp=SCP-cluster_0_host_0; dstinst=100; srcinst=307;"
+            "srcservinst=308",
+            tokens.toString());
+  tokens.remove(Key::DstServInst);
+  EXPECT_EQ("srcscp=SCP-scp.own_plmn.com; dstscp=SCP-cluster_0_host_0; dstinst=100; srcinst=307; "
+            "srcservinst=308",
+            tokens.toString());
+}
+
+// A header that was not modified is left as it is
+TEST_F(EricProxySbiNfPeerInfoTokensTest, UnmodifiedHeaderIsNotRewritten) {
+  Http::TestResponseHeaderMapImpl headers{{"3gpp-Sbi-NF-Peer-Info", "srcinst=1;dstinst=2"}};
+  auto tokens = SbiNfPeerInfoTokens::fromHeaders(headers);
+  tokens.writeTo(headers);
+  EXPECT_EQ("srcinst=1;dstinst=2", headers.get_("3gpp-sbi-nf-peer-info"));
+
+  tokens.set(Key::DstInst, "2");
+  tokens.writeTo(headers);
+  EXPECT_EQ("srcinst=1;dstinst=2", headers.get_("3gpp-sbi-nf-peer-info"));
+  tokens.set(Key::SrcInst, "1");
+  tokens.writeTo(headers);
+  EXPECT_EQ("dstinst=2;srcinst=1", headers.get_("3gpp-sbi-nf-peer-info"));
+}
+
+TEST_F(EricProxySbiNfPeerInfoTokensTest, SetRemoveAndWriteHeader) {
+  Http::TestRequestHeaderMapImpl headers{{"3gpp-Sbi-NF-Peer-Info", "srcinst=1; dstsepp=SEPP-a"},
+                                         {"3gpp-Sbi-NF-Peer-Info", "dstinst=2"}};
+  auto tokens = SbiNfPeerInfoTokens::fromHeaders(headers);
+  EXPECT_EQ("2", tokens.get(Key::DstInst).value());
+
+  SbiNfPeerInfo::setSrcScp(tokens, "own.fqdn.com");
+  SbiNfPeerInfo::setDstScp(tokens, "scp-Next.Hop:8080");
+  SbiNfPeerInfo::setDstSepp(tokens, "10.0.0.1:80"); // ip address is ignored
+  tokens.remove(Key::SrcInst);
+  tokens.writeTo(headers);
+
+  ASSERT_EQ(1, headers.get(Http::LowerCaseString("3gpp-Sbi-NF-Peer-Info")).size());
+  EXPECT_EQ("dstsepp=SEPP-a; dstinst=2; srcscp=SCP-own.fqdn.com; dstscp=scp-Next.Hop",
+            headers.get_("3gpp-sbi-nf-peer-info"));
+
+  tokens.clear();
+  EXPECT_TRUE(tokens.empty());
+  tokens.writeTo(headers);
+  EXPECT_FALSE(headers.has("3gpp-sbi-nf-peer-info"));
+}
+
+TEST_F(EricProxySbiNfPeerInfoTokensTest, SrcScpAndSrcSeppAreExclusive) {
+  SbiNfPeerInfoTokens tokens("srcscp=SCP-scp1");
+  SbiNfPeerInfo::setSrcSepp(tokens, "SEPP-sepp1");
+  EXPECT_FALSE(tokens.has(Key::SrcScp));
+  EXPECT_EQ("SEPP-sepp1", tokens.get(Key::SrcSepp).value());
+}
+
+} // namespace EricProxy
+} // namespace HttpFilters
+} // namespace Extensions
+} // namespace Envoy
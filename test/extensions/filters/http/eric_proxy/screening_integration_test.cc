@@ -4,6 +4,8 @@
 
 #include "source/extensions/filters/http/eric_proxy/filter.h"
 #include "test/integration/http_integration.h"
+
+#include "absl/strings/str_replace.h"
 #include <string>
 
 namespace Envoy {
@@ -2169,6 +2171,42 @@ TEST_P(EricProxyFilterScreeningIntegrationTest, modifyMultipleHeaders) {
   codec_client->close();
 }
 
+// Modify a repeated SBI header in ingress screening
+// The SBI headers are inline headers, the two 3gpp-Sbi-Callback headers are merged
+// into one (comma separated). Expected outcome is that the strings are
+// appended/prepended once, to the merged value.
+TEST_P(EricProxyFilterScreeningIntegrationTest, modifyRepeatedSbiHeader) {
+  initializeFilter(absl::StrReplaceAll(config_modify_multiple_headers,
+                                       {{"name: x-dummy-header", "name: 3gpp-Sbi-Callback"}}));
+  Http::TestRequestHeaderMapImpl headers{
+      {":method", "GET"},
+      {":path", "/"},
+      {":authority", "host"},
+      {"3gpp-Sbi-target-apiRoot", "http://eric-chfsim-1-mnc-123-mcc-123:80"},
+      {"3gpp-Sbi-Callback", "Nchf_ConvergedCharging_Notify"},
+      {"3gpp-Sbi-Callback", "Nchf_ConvergedCharging_Abort"},
+  };
+
+  IntegrationCodecClientPtr codec_client;
+  FakeHttpConnectionPtr fake_upstream_connection;
+  FakeStreamPtr request_stream;
+
+  codec_client = makeHttpConnection(lookupPort("http"));
+  auto response = codec_client->makeHeaderOnlyRequest(headers);
+  ASSERT_TRUE(fake_upstreams_[0]->waitForHttpConnection(*dispatcher_, fake_upstream_connection));
+  ASSERT_TRUE(fake_upstream_connection->waitForNewStream(*dispatcher_, request_stream));
+  ASSERT_TRUE(request_stream->waitForEndStream(*dispatcher_));
+  ASSERT_TRUE(fake_upstream_connection->close());
+  ASSERT_TRUE(response->waitForEndStream());
+
+  // Request headers on upstream:
+  const auto callback = request_stream->headers().get(Http::LowerCaseString("3gpp-sbi-callback"));
+  ASSERT_EQ(1, callback.size());
+  EXPECT_EQ("vprependedNchf_ConvergedCharging_Notify,Nchf_ConvergedCharging_Abortvappended",
+            callback[0]->value().getStringView());
+  codec_client->close();
+}
+
 // (eedala) This is definitely not testing 5 filter-cases
 TEST_P(EricProxyFilterScreeningIntegrationTest, headerAdd_five_FC) {
   initializeFilter(config_five_fc);
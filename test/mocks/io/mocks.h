@@ -80,5 +80,11 @@ public:
   MOCK_METHOD(uint32_t, getNumOfSockets, (), (const));
 };
 
+class MockIoUringWorkerFactory : public IoUringWorkerFactory {
+public:
+  MOCK_METHOD(OptRef<IoUringWorker>, getIoUringWorker, ());
+  MOCK_METHOD(void, onServerInitialized, ());
+};
+
 } // namespace Io
 } // namespace Envoy
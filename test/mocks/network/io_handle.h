@@ -38,6 +38,9 @@ public:
   MOCK_METHOD(Api::IoCallUint64Result, recvmmsg,
               (RawSliceArrays & slices, uint32_t self_port, RecvMsgOutput& output));
   MOCK_METHOD(Api::IoCallUint64Result, recv, (void* buffer, size_t length, int flags));
+  MOCK_METHOD(Api::IoCallUint64Result, send,
+              (const Buffer::RawSlice* slices, uint64_t num_slice, int flags));
+  MOCK_METHOD(Api::IoCallUint64Result, recvZeroCopyCompletion, (ZeroCopyCompletion & completion));
   MOCK_METHOD(bool, supportsMmsg, (), (const));
   MOCK_METHOD(bool, supportsUdpGro, (), (const));
   MOCK_METHOD(Api::SysCallIntResult, bind, (Address::InstanceConstSharedPtr address));
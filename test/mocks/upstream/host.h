@@ -35,6 +35,7 @@ public:
   MOCK_METHOD(double, successRate, (DetectorHostMonitor::SuccessRateMonitorType type), (const));
   MOCK_METHOD(void, successRate,
               (DetectorHostMonitor::SuccessRateMonitorType type, double new_success_rate));
+  MOCK_METHOD(bool, ejectionPending, (), (const));
 };
 
 class MockEventLogger : public EventLogger {
@@ -1107,6 +1107,10 @@ public:
     header_map_->verifyByteSizeInternalForTest();
     return headers_removed;
   }
+  void applyMutations(absl::Span<const HeaderMutation> mutations) override {
+    header_map_->applyMutations(mutations);
+    header_map_->verifyByteSizeInternalForTest();
+  }
   size_t size() const override { return header_map_->size(); }
   bool empty() const override { return header_map_->empty(); }
   void dumpState(std::ostream& os, int indent_level = 0) const override {